@@ -11,18 +11,81 @@
 --------------------- File Inclusions ----------------------------
 ----------------------------------------------------------------*/
 #include "adc.h"
+#include "timer0.h"
 #include <stdint.h>
+#include <stddef.h>
 #include <avr/interrupt.h>
 
+/*----------------------------------------------------------------
+--------------------- Private Constants ---------------------------
+----------------------------------------------------------------*/
+#define ADC_ADPS_BITS  ((1<<ADPS2)|(1<<ADPS1)|(1<<ADPS0))
+
+#define ADC_TRIGGERED_CONVERSION_CLOCKS   14	// 13.5 ADC clocks, rounded up.
+#define ADC_TIMER0_PRESCALARS_COUNT       5
+
+/*----------------------------------------------------------------
+--------------------- Private Data Types -------------------------
+----------------------------------------------------------------*/
+typedef enum{
+	ADC_ENGINE_IDLE=0,
+	ADC_ENGINE_SCAN,
+	ADC_ENGINE_SAMPLING
+}adc_engine_t;
+
+/*----------------------------------------------------------------
+--------------------- Private Variable Definitions ---------------
+----------------------------------------------------------------*/
+// The scan and the fixed-rate sampling need the ISR of the driver, so they are left out of the build without it:
+#if ADC_DRIVER_ISR_ENABLED
+// The scan list, kept as whole ADMUX values, so the interrupt selects the next channel with one store:
+static uint8_t adc_scan_admux[ADC_SCAN_MAX_CHANNELS];
+static volatile uint8_t adc_scan_channels_count = 0;
+static volatile uint8_t adc_scan_index = 0;
+
+// The oversampling of each list entry, as the number of extra bits, and the conversions of the current entry:
+static uint8_t adc_scan_extra_bits[ADC_SCAN_MAX_CHANNELS];
+static uint8_t adc_scan_conversions_left;
+static uint16_t adc_scan_sum;
 
+// Set when timer0 starts each scan at the rate of adc_scan_rate_set(), instead of each scan starting the next one:
+static volatile uint8_t adc_scan_paced = 0;
 
+// The filter of each list entry, or NULL:
+static adc_filter_t* adc_scan_filters[ADC_SCAN_MAX_CHANNELS];
 
+// Two result buffers: the interrupt fills one while the other holds the last complete scan.
+// The count of complete scans also tells which buffer that is (its lowest bit).
+static uint16_t adc_scan_results[2][ADC_SCAN_MAX_CHANNELS];
+static volatile uint8_t adc_scan_count = 0;
+
+// The timer0 clock division factors, in the order of timer_prescalar_t from TIMER0_NO_PRESCALAR:
+static const uint16_t adc_timer0_prescalars[ADC_TIMER0_PRESCALARS_COUNT] = {1, 8, 64, 256, 1024};
+
+// The samples ring buffer, filled by the interrupt and emptied by adc_sample_read():
+static uint16_t adc_samples[ADC_SAMPLES_BUFFER_SIZE];
+static volatile uint8_t adc_samples_head = 0;
+static volatile uint8_t adc_samples_tail = 0;
+static volatile uint8_t adc_samples_lost = 0;
+
+// The filter of the samples, or NULL:
+static adc_filter_t* adc_sampling_filter;
+
+// What the ADC interrupt does:
+static volatile adc_engine_t adc_engine = ADC_ENGINE_IDLE;
+#endif
 
 
 /*----------------------------------------------------------------
 --------------------- Private Functions Prototypes ---------------
 ----------------------------------------------------------------*/
-
+#if ADC_DRIVER_ISR_ENABLED
+static uint16_t adc_clock_division_get(void);
+static uint8_t adc_timer0_period_find(uint32_t period_cycles, uint16_t* timer_counts);
+static void adc_timer0_trigger_start(uint8_t prescalar_index, uint16_t timer_counts);
+static void adc_scan_isr(void);
+static void adc_sampling_isr(void);
+#endif
 
 /*----------------------------------------------------------------
 --------------------- Public Function Definitions ----------------
@@ -118,7 +181,7 @@ void adc_set_clock_prescalar(adc_prescalar_t adc_prescalar)
  {
 	 return ADC;
  }
- void adc_start_conversion()
+ void adc_start_conversion(void)
  {
 	 ADCSRA |= (1 << ADSC); 
  }
@@ -129,50 +192,6 @@ void adc_set_clock_prescalar(adc_prescalar_t adc_prescalar)
 	 ADCSRA |= (1 << ADIF); //Clear the flag. Note that in AVR MCUs, you clear the interrupt flags by writing 1 to them.
  }
 
- void adc_select_channel(adc_channel_t adc_channel)
- {
-	 
-		 switch(adc_channel)
-		 {
-			  case ADC_CHANNEL_0:
-			  ADMUX = ((ADMUX & ~((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))) | (((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0)) & 0b00000000));
-			  break;
-			  
-			  case ADC_CHANNEL_1:
-			  ADMUX = ((ADMUX & ~((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))) | (((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0)) & 0b00000001));
-			  break;
-			  
-			  case ADC_CHANNEL_2:
-			  ADMUX = ((ADMUX & ~((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))) | (((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0)) & 0b00000010));
-			  break;
-			  
-			  case ADC_CHANNEL_3:
-			  ADMUX = ((ADMUX & ~((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))) | (((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0)) & 0b00000011));
-			  break;
-			  
-			  case ADC_CHANNEL_4:
-			  ADMUX = ((ADMUX & ~((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))) | (((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0)) & 0b00000100));
-			  break;
-			  
-			  case ADC_CHANNEL_5:
-			  ADMUX = ((ADMUX & ~((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))) | (((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0)) & 0b00000101));
-			  break;
-			  
-			  case ADC_CHANNEL_6:
-			  ADMUX = ((ADMUX & ~((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))) | (((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0)) & 0b00000110));
-			  break;
-			  
-			  case ADC_CHANNEL_7:
-			  ADMUX = ((ADMUX & ~((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))) | (((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0)) & 0b00000111));
-			  break;
-			  
-			  default:
-			  break;
-		 }
-		
- }
- 
- 
  //When the following function is called, the ADC Conversion Complete Interrupt is activated.
  
  void adc_enable_interrupts(void)
@@ -198,48 +217,49 @@ void adc_disable_interrupts(void)
   }
   
  
+ //The trigger source bits (ADTS) are in SFIOR on the ATmega32.
  void adc_select_auto_triggering_source(adc_auto_triggering_source_t adc_auto_triggering_source)
  {
 	
 		 switch (adc_auto_triggering_source)
 		 {
 			 case ADC_FREE_RUNNING_MODE:
-			 adc_disable_auto_triggerig();
-			 ADMUX = ((ADMUX & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | ((((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)) & 0b00000000));
+			 adc_enable_auto_triggerig();
+			 SFIOR = ((SFIOR & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | (0b00000000 << ADTS0);
 			 break;
 			 
 			 case ADC_ANALOG_COMPARATOR:
 			 adc_enable_auto_triggerig();
-			 ADMUX = ((ADMUX & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | ((((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)) & 0b00000001));
+			 SFIOR = ((SFIOR & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | (0b00000001 << ADTS0);
 			 break;
 			 
 			 case ADC_EXTERNAL_INTERRUPT_REQUEST_0:
-			 ADMUX = ((ADMUX & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | ((((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)) & 0b00000010));
+			 SFIOR = ((SFIOR & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | (0b00000010 << ADTS0);
 			 adc_enable_auto_triggerig();
 			 break;
 			 
 			 case ADC_TIMER_COUNTER_0_COMPARE_MATCH:
-			 ADMUX = ((ADMUX & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | ((((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)) & 0b00000011));
+			 SFIOR = ((SFIOR & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | (0b00000011 << ADTS0);
 			 adc_enable_auto_triggerig();
 			 break;
 			 
 			 case ADC_TIMER_COUNTER_0_OVERFLOW:
-			 ADMUX = ((ADMUX & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | ((((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)) & 0b00000100));
+			 SFIOR = ((SFIOR & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | (0b00000100 << ADTS0);
 			 adc_enable_auto_triggerig();
 			 break;
 			 
 			 case ADC_TIMER_COUNTER_1_COMPARE_MATCH_B:
-			 ADMUX = ((ADMUX & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | ((((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)) & 0b00000101));
+			 SFIOR = ((SFIOR & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | (0b00000101 << ADTS0);
 			 adc_enable_auto_triggerig();
 			 break;
 			 
 			 case ADC_TIMER_COUNTER_1_OVERFLOW:
-			 ADMUX = ((ADMUX & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | ((((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)) & 0b00000110));
+			 SFIOR = ((SFIOR & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | (0b00000110 << ADTS0);
 			 adc_enable_auto_triggerig();
 			 break;
 			 
 			 case ADC_TIMER_COUNTER_1_CAPTURE_EVENT:
-			 ADMUX = ((ADMUX & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | ((((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)) & 0b00000111));
+			 SFIOR = ((SFIOR & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0)))) | (0b00000111 << ADTS0);
 			 adc_enable_auto_triggerig();
 			 break;
 			 
@@ -249,10 +269,443 @@ void adc_disable_interrupts(void)
 	 
  }
  
+#if ADC_DRIVER_ISR_ENABLED
+//The following function starts converting a list of channels over and over from the ADC interrupt.
+//It returns 1 if the scan started, and 0 if the number of channels isn't from 1 to ADC_SCAN_MAX_CHANNELS.
+uint8_t adc_scan_start(const adc_channel_t channels[], uint8_t channels_count)
+{
+	return adc_scan_oversampled_start(channels, NULL, channels_count);
+}
+
+//The following function starts a scan where each channel is converted 4^extra_bits[i] times in a row, and the
+//sum shifted right by extra_bits[i] gives a result with extra_bits[i] more bits. extra_bits can be NULL for none.
+//It returns 1 if the scan started, and 0 if the number of channels or extra bits is out of range.
+uint8_t adc_scan_oversampled_start(const adc_channel_t channels[], const uint8_t extra_bits[], uint8_t channels_count)
+{
+	if ((0 == channels_count) || (ADC_SCAN_MAX_CHANNELS < channels_count))
+	{
+		return 0;
+	}
+	for (uint8_t i = 0; (NULL != extra_bits) && (i < channels_count); i++)
+	{
+		if (ADC_OVERSAMPLING_MAX_BITS < extra_bits[i])
+		{
+			return 0;
+		}
+	}
+	adc_scan_stop();
+	adc_sampling_stop();
+	
+	//The reference voltage bits are kept as they are. ADLAR is cleared, since the sums need right adjusted results:
+	for (uint8_t i = 0; i < channels_count; i++)
+	{
+		adc_scan_admux[i] = (ADMUX & ~(ADC_MUX_BITS | (1 << ADLAR))) | (channels[i] & ADC_MUX_BITS);
+		adc_scan_extra_bits[i] = (NULL != extra_bits) ? extra_bits[i] : 0;
+		adc_scan_filters[i] = NULL;
+	}
+	//The results of the last list are cleared, so they never show up in the order of the new one:
+	for (uint8_t i = 0; i < ADC_SCAN_MAX_CHANNELS; i++)
+	{
+		adc_scan_results[0][i] = 0;
+		adc_scan_results[1][i] = 0;
+	}
+	adc_scan_count = 0;
+	adc_scan_channels_count = channels_count;
+	adc_scan_index = 0;
+	adc_scan_conversions_left = 1 << (2 * adc_scan_extra_bits[0]);
+	adc_scan_sum = 0;
+	
+	//Each conversion is started by the interrupt of the one before it:
+	adc_disable_auto_triggerig();
+	adc_scan_paced = 0;
+	ADMUX = adc_scan_admux[0];
+	adc_engine = ADC_ENGINE_SCAN;
+	adc_enable_interrupts();
+	adc_start_conversion();
+	return 1;
+}
+
+//The following function sets how many times per second the running scan converts its list: timer0 in CTC mode starts
+//each scan, and the conversions of the scan follow each other as before. So the results come at that rate, with no
+//CPU time other than the interrupts, whatever the ADC prescalar and the extra bits are. A scan_rate of 0 makes the
+//scan free running again. The scan starts over from the first entry of the list. It returns 1 if the rate is set,
+//and 0 if no scan is running, or if the rate is too high for the conversions of the list or too low for timer0.
+//Timer0 can't be used for anything else meanwhile.
+uint8_t adc_scan_rate_set(uint32_t scan_rate, uint32_t sys_osc_clock_freq)
+{
+	uint32_t scan_conversions = 0;
+	uint32_t period_cycles;
+	uint16_t timer_counts = 0;
+	uint8_t prescalar_index = 0;
+	
+	if (ADC_ENGINE_SCAN != adc_engine)
+	{
+		return 0;
+	}
+	if (0 != scan_rate)
+	{
+		//Each conversion of the scan needs a whole conversion time, the interrupts between them come on top:
+		for (uint8_t i = 0; i < adc_scan_channels_count; i++)
+		{
+			scan_conversions += 1 << (2 * adc_scan_extra_bits[i]);
+		}
+		period_cycles = sys_osc_clock_freq / scan_rate;
+		if (period_cycles < (scan_conversions * ADC_TRIGGERED_CONVERSION_CLOCKS * adc_clock_division_get()))
+		{
+			return 0;
+		}
+		prescalar_index = adc_timer0_period_find(period_cycles, &timer_counts);
+		if (ADC_TIMER0_PRESCALARS_COUNT == prescalar_index)
+		{
+			return 0;
+		}
+	}
+	
+	//The scan in progress is dropped, the buffer of the last complete scan is kept:
+	adc_disable_interrupts();
+	timer0_prescalar_set(TIMER0_NO_CLK);
+	adc_disable_auto_triggerig();
+	while (ADCSRA & (1 << ADSC));
+	ADCSRA |= (1 << ADIF);
+	adc_scan_index = 0;
+	adc_scan_conversions_left = 1 << (2 * adc_scan_extra_bits[0]);
+	adc_scan_sum = 0;
+	ADMUX = adc_scan_admux[0];
+	
+	if (0 != scan_rate)
+	{
+		adc_scan_paced = 1;
+		adc_timer0_trigger_start(prescalar_index, timer_counts);
+	}
+	else
+	{
+		adc_scan_paced = 0;
+		adc_enable_interrupts();
+		adc_start_conversion();
+	}
+	return 1;
+}
+
+//The following function sets the filter that the interrupt runs on each new result of a list entry, after the
+//oversampling. The filter needs to be set up by adc_filter_init(), and it can be NULL for none. The list is
+//cleared by adc_scan_start(), so this is called after it. It returns 1 if the filter is set, and 0 if the list
+//has no such entry.
+uint8_t adc_scan_filter_set(uint8_t list_index, adc_filter_t* filter)
+{
+	uint8_t sreg_value;
+	
+	if (list_index >= adc_scan_channels_count)
+	{
+		return 0;
+	}
+	//The interrupt reads the pointer, so both of its bytes are written with the interrupts disabled:
+	sreg_value = SREG;
+	cli();
+	adc_scan_filters[list_index] = filter;
+	SREG = sreg_value;
+	return 1;
+}
+
+//The following function stops the scan. It waits for the conversion in progress, so ADMUX can be written right
+//after it, and clears its flag, so it doesn't raise an interrupt when the interrupts are enabled again.
+//It does nothing if the scan isn't running, so it never stops the fixed-rate sampling.
+void adc_scan_stop(void)
+{
+	if (ADC_ENGINE_SCAN == adc_engine)
+	{
+		adc_disable_interrupts();
+		if (adc_scan_paced)
+		{
+			timer0_prescalar_set(TIMER0_NO_CLK);
+			adc_disable_auto_triggerig();
+			adc_scan_paced = 0;
+		}
+		while (ADCSRA & (1 << ADSC));
+		ADCSRA |= (1 << ADIF);
+		adc_engine = ADC_ENGINE_IDLE;
+		adc_scan_channels_count = 0;
+	}
+}
+
+//The following function copies the results of the last complete scan, in the order of the scan list, and returns
+//the number of complete scans (wrapping from 255 to 0), so the caller can tell whether the results are new.
+//Before the first scan completes, the results are 0.
+uint8_t adc_scan_snapshot_get(uint16_t results[])
+{
+	uint8_t scan_count;
+	uint16_t* scan_results;
+	
+	//If a scan completes during the copy, the interrupt may be refilling the copied buffer, so it is copied again:
+	do
+	{
+		scan_count = adc_scan_count;
+		scan_results = adc_scan_results[scan_count & 0x01];
+		for (uint8_t i = 0; i < adc_scan_channels_count; i++)
+		{
+			results[i] = scan_results[i];
+		}
+	} while (scan_count != adc_scan_count);
+	
+	return scan_count;
+}
+
+//The following function converts one channel at a fixed sample rate, triggered by timer0 in CTC mode, and keeps
+//the samples for adc_sample_read(). The ADC prescalar needs to be set before. It returns 1 if sampling started,
+//and 0 if the rate is too high for the ADC clock or too low for timer0.
+uint8_t adc_sampling_start(adc_channel_t adc_channel, uint32_t sample_rate, uint32_t sys_osc_clock_freq)
+{
+	uint32_t period_cycles;
+	uint16_t timer_counts;
+	uint8_t prescalar_index;
+	
+	if (0 == sample_rate)
+	{
+		return 0;
+	}
+	period_cycles = sys_osc_clock_freq / sample_rate;
+	
+	//Each sample needs a whole conversion:
+	if (period_cycles < ((uint32_t)ADC_TRIGGERED_CONVERSION_CLOCKS * adc_clock_division_get()))
+	{
+		return 0;
+	}
+	prescalar_index = adc_timer0_period_find(period_cycles, &timer_counts);
+	if (ADC_TIMER0_PRESCALARS_COUNT == prescalar_index)
+	{
+		return 0;
+	}
+	
+	adc_scan_stop();
+	adc_sampling_stop();
+	adc_samples_head = 0;
+	adc_samples_tail = 0;
+	adc_samples_lost = 0;
+	adc_sampling_filter = NULL;
+	adc_select_channel(adc_channel);
+	adc_engine = ADC_ENGINE_SAMPLING;
+	adc_timer0_trigger_start(prescalar_index, timer_counts);
+	return 1;
+}
+
+//The following function stops the fixed-rate sampling and timer0. The samples not read yet are kept. Like
+//adc_scan_stop(), it waits for a conversion already triggered and clears its flag, so the next user of the ADC
+//doesn't take its result. It does nothing if the sampling isn't running, so it never stops the scan.
+void adc_sampling_stop(void)
+{
+	if (ADC_ENGINE_SAMPLING == adc_engine)
+	{
+		adc_disable_interrupts();
+		timer0_prescalar_set(TIMER0_NO_CLK);
+		adc_disable_auto_triggerig();
+		while (ADCSRA & (1 << ADSC));
+		ADCSRA |= (1 << ADIF);
+		adc_engine = ADC_ENGINE_IDLE;
+	}
+}
+
+//The following function sets the filter that the interrupt runs on each new sample, before it is kept in the buffer,
+//so adc_sample_read() gives filtered samples. The filter needs to be set up by adc_filter_init(), and it can be NULL
+//for none. It is cleared by adc_sampling_start(), so this is called after it.
+void adc_sampling_filter_set(adc_filter_t* filter)
+{
+	uint8_t sreg_value;
+	
+	//The interrupt reads the pointer, so both of its bytes are written with the interrupts disabled:
+	sreg_value = SREG;
+	cli();
+	adc_sampling_filter = filter;
+	SREG = sreg_value;
+}
+
+//The following function takes the oldest sample from the buffer. It returns 1 if there was one, and 0 otherwise.
+uint8_t adc_sample_read(uint16_t* sample)
+{
+	uint8_t tail = adc_samples_tail;
+	
+	if (tail == adc_samples_head)
+	{
+		return 0;
+	}
+	*sample = adc_samples[tail];
+	tail++;
+	if (ADC_SAMPLES_BUFFER_SIZE == tail)
+	{
+		tail = 0;
+	}
+	adc_samples_tail = tail;
+	return 1;
+}
+
+//The following function returns the number of samples dropped because the buffer was full, up to 255.
+uint8_t adc_samples_lost_get(void)
+{
+	return adc_samples_lost;
+}
+
+ISR(ADC_vect)
+{
+	if (ADC_ENGINE_SAMPLING == adc_engine)
+	{
+		adc_sampling_isr();
+	}
+	else if (ADC_ENGINE_SCAN == adc_engine)
+	{
+		adc_scan_isr();
+	}
+	else
+	{
+		//Nothing is running, so the result is left for whoever started the conversion.
+	}
+}
+#endif
 
 /*----------------------------------------------------------------
 --------------------- Private Functions Definitions --------------
 ----------------------------------------------------------------*/
+#if ADC_DRIVER_ISR_ENABLED
+//The following function returns the number of CPU cycles per ADC clock. ADPS of 0 divides by 2, like ADPS of 1.
+static uint16_t adc_clock_division_get(void)
+{
+	uint16_t adc_clock_division = 1 << (ADCSRA & ADC_ADPS_BITS);
+	
+	if (adc_clock_division < 2)
+	{
+		adc_clock_division = 2;
+	}
+	return adc_clock_division;
+}
+
+//The following function finds the timer0 CTC period closest to the given number of CPU cycles: the smallest
+//prescalar whose counts fit in OCR0 gives the closest one. It returns the index of the prescalar, or
+//ADC_TIMER0_PRESCALARS_COUNT if the period is too long for timer0.
+static uint8_t adc_timer0_period_find(uint32_t period_cycles, uint16_t* timer_counts)
+{
+	uint32_t counts;
+	uint8_t i;
+	
+	for (i = 0; i < ADC_TIMER0_PRESCALARS_COUNT; i++)
+	{
+		counts = (period_cycles + (adc_timer0_prescalars[i] / 2)) / adc_timer0_prescalars[i];
+		if (counts <= 256)
+		{
+			*timer_counts = (uint16_t)counts;
+			break;
+		}
+	}
+	return i;
+}
+
+//The following function starts timer0 in CTC mode with the period found by adc_timer0_period_find(), with its
+//compare match triggering the conversions, and enables the ADC interrupt.
+static void adc_timer0_trigger_start(uint8_t prescalar_index, uint16_t timer_counts)
+{
+	timer0_mode_set(TIMER0_CTC_MODE);
+	timer0_TCNT0_load(0);
+	timer0_OCR0_load((uint8_t)(timer_counts - 1));
+	TIFR = (1 << OCF0);
+	adc_select_auto_triggering_source(ADC_TIMER_COUNTER_0_COMPARE_MATCH);
+	adc_enable_interrupts();
+	timer0_prescalar_set((timer_prescalar_t)(TIMER0_NO_PRESCALAR + prescalar_index));
+}
+
+//The following function adds a scan conversion to the sum of its channel and starts the next one. When the channel
+//has all its conversions, its result is stored and the next channel is selected.
+static void adc_scan_isr(void)
+{
+	uint8_t channel_index = adc_scan_index;
+	uint8_t conversions_left = adc_scan_conversions_left - 1;
+	uint16_t sum;
+	adc_filter_t* filter;
+	
+	if (0 == conversions_left)
+	{
+		adc_scan_index++;
+		if (adc_scan_index >= adc_scan_channels_count)
+		{
+			adc_scan_index = 0;
+		}
+		ADMUX = adc_scan_admux[adc_scan_index];
+	}
+	
+	//The next conversion is started first, so the ADC only waits for the interrupt latency between
+	//conversions. The result stays in the ADC register until the new conversion completes:
+	if (!adc_scan_paced)
+	{
+		ADCSRA |= (1 << ADSC);
+	}
+	else if ((0 != conversions_left) || (0 != adc_scan_index))
+	{
+		//A compare match can't start a conversion in the middle of a paced scan, with the wrong channel, since
+		//the auto trigger is off until the scan is over:
+		ADCSRA = (ADCSRA & ~(1 << ADATE)) | (1 << ADSC);
+	}
+	else
+	{
+		//The scan is over, the next compare match of timer0 starts the next one. The flag is cleared after the
+		//trigger is enabled, so a compare match in between starts the scan rather than being missed:
+		ADCSRA |= (1 << ADATE);
+		TIFR = (1 << OCF0);
+	}
+	
+	sum = adc_scan_sum + ADC;
+	if (0 != conversions_left)
+	{
+		adc_scan_sum = sum;
+		adc_scan_conversions_left = conversions_left;
+		return;
+	}
+	
+	sum >>= adc_scan_extra_bits[channel_index];
+	filter = adc_scan_filters[channel_index];
+	if (NULL != filter)
+	{
+		sum = adc_filter_update(filter, sum);
+	}
+	adc_scan_results[(adc_scan_count + 1) & 0x01][channel_index] = sum;
+	adc_scan_sum = 0;
+	adc_scan_conversions_left = 1 << (2 * adc_scan_extra_bits[adc_scan_index]);
+	if (0 == adc_scan_index)
+	{
+		//The scan is complete, the buffer just filled holds the new snapshot:
+		adc_scan_count++;
+	}
+}
+
+//The following function stores a timer triggered sample.
+static void adc_sampling_isr(void)
+{
+	uint8_t next_head = adc_samples_head + 1;
+	uint16_t sample = ADC;
+	adc_filter_t* filter = adc_sampling_filter;
+	
+	//The conversions are triggered by the rising edge of the compare match flag, so it is cleared for the next one
+	//(written with a one, and alone, so the other timer flags are kept):
+	TIFR = (1 << OCF0);
+	
+	//Every sample goes through the filter, even one dropped below, so the filter follows the input in time:
+	if (NULL != filter)
+	{
+		sample = adc_filter_update(filter, sample);
+	}
+	
+	if (ADC_SAMPLES_BUFFER_SIZE == next_head)
+	{
+		next_head = 0;
+	}
+	if (next_head == adc_samples_tail)
+	{
+		if (adc_samples_lost < 255)
+		{
+			adc_samples_lost++;
+		}
+	}
+	else
+	{
+		adc_samples[adc_samples_head] = sample;
+		adc_samples_head = next_head;
+	}
+}
+#endif
 
 
 /*----------------------------------------------------------------
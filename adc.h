@@ -16,6 +16,27 @@
 ----------------------------------------------------------------*/
 
 #include <stdint.h>
+#include <avr/io.h>
+#include "adc_filter.h"
+
+/*----------------------------------------------------------------
+--------------------- Public Constants ---------------------------
+----------------------------------------------------------------*/
+// When 1, the driver defines ISR(ADC_vect), which the scanning and the fixed-rate sampling need. It is 0 by
+// default, so an application can have its own ISR, as in the interrupt examples at the end of this file. To use
+// the scanning or the sampling, define it as 1 for the whole build (-DADC_DRIVER_ISR_ENABLED=1). When it is 0,
+// their functions are left out, so calling them fails at build time instead of enabling an interrupt that has
+// no ISR, which resets the MCU.
+#ifndef ADC_DRIVER_ISR_ENABLED
+#define ADC_DRIVER_ISR_ENABLED   0
+#endif
+
+#define ADC_MUX_BITS             ((1<<MUX4)|(1<<MUX3)|(1<<MUX2)|(1<<MUX1)|(1<<MUX0))
+
+#define ADC_SCAN_MAX_CHANNELS    8		// The most channels in one scan list.
+#define ADC_SAMPLES_BUFFER_SIZE  32		// The samples kept by the fixed-rate sampling (2 to 255).
+#define ADC_OVERSAMPLING_MAX_BITS 3		// Up to 13 bit results, from 64 conversions.
+
 /*----------------------------------------------------------------
 --------------------- Public Data Types --------------------------
 ----------------------------------------------------------------*/
@@ -36,6 +57,8 @@ typedef enum{
 	ADC_PRESCALAR_128                   // clk/128
 }adc_prescalar_t;
 
+// Each value is the MUX4:0 code of ADMUX. The differential channels are named after their positive
+// input, negative input and gain, and give signed results (see the note at the end of this file).
 typedef enum{
 	ADC_CHANNEL_0=0,					
 	ADC_CHANNEL_1,
@@ -44,7 +67,31 @@ typedef enum{
 	ADC_CHANNEL_4,
 	ADC_CHANNEL_5,
 	ADC_CHANNEL_6,
-	ADC_CHANNEL_7
+	ADC_CHANNEL_7,
+	ADC_DIFFERENTIAL_0_0_X10,			// Offset calibration of ADC_DIFFERENTIAL_1_0_X10.
+	ADC_DIFFERENTIAL_1_0_X10,
+	ADC_DIFFERENTIAL_0_0_X200,			// Offset calibration of ADC_DIFFERENTIAL_1_0_X200.
+	ADC_DIFFERENTIAL_1_0_X200,
+	ADC_DIFFERENTIAL_2_2_X10,			// Offset calibration of ADC_DIFFERENTIAL_3_2_X10.
+	ADC_DIFFERENTIAL_3_2_X10,
+	ADC_DIFFERENTIAL_2_2_X200,			// Offset calibration of ADC_DIFFERENTIAL_3_2_X200.
+	ADC_DIFFERENTIAL_3_2_X200,
+	ADC_DIFFERENTIAL_0_1_X1,
+	ADC_DIFFERENTIAL_1_1_X1,
+	ADC_DIFFERENTIAL_2_1_X1,
+	ADC_DIFFERENTIAL_3_1_X1,
+	ADC_DIFFERENTIAL_4_1_X1,
+	ADC_DIFFERENTIAL_5_1_X1,
+	ADC_DIFFERENTIAL_6_1_X1,
+	ADC_DIFFERENTIAL_7_1_X1,
+	ADC_DIFFERENTIAL_0_2_X1,
+	ADC_DIFFERENTIAL_1_2_X1,
+	ADC_DIFFERENTIAL_2_2_X1,
+	ADC_DIFFERENTIAL_3_2_X1,
+	ADC_DIFFERENTIAL_4_2_X1,
+	ADC_DIFFERENTIAL_5_2_X1,
+	ADC_BANDGAP_1_22V,					// The internal 1.22V reference.
+	ADC_GROUND							// 0V.
 }adc_channel_t;
 
 typedef enum{
@@ -66,13 +113,34 @@ typedef enum{
     void adc_set_clock_prescalar(adc_prescalar_t adc_prescalar);
     uint16_t adc_read_channel(adc_channel_t adc_channel);
     uint16_t adc_read_adc_register();
+    void adc_start_conversion(void);
     void adc_wait_conversion_complete(void);
-    void adc_select_channel(adc_channel_t adc_channel);
     void adc_enable_interrupts(void);
     void adc_disable_interrupts(void);
     void adc_enable_auto_triggerig(void);
     void adc_disable_auto_triggerig(void);
     void adc_select_auto_triggering_source(adc_auto_triggering_source_t adc_auto_triggering_source);
+#if ADC_DRIVER_ISR_ENABLED
+    uint8_t adc_scan_start(const adc_channel_t channels[], uint8_t channels_count);
+    uint8_t adc_scan_oversampled_start(const adc_channel_t channels[], const uint8_t extra_bits[], uint8_t channels_count);
+    uint8_t adc_scan_rate_set(uint32_t scan_rate, uint32_t sys_osc_clock_freq);
+    uint8_t adc_scan_filter_set(uint8_t list_index, adc_filter_t* filter);
+    void adc_scan_stop(void);
+    uint8_t adc_scan_snapshot_get(uint16_t results[]);
+    uint8_t adc_sampling_start(adc_channel_t adc_channel, uint32_t sample_rate, uint32_t sys_osc_clock_freq);
+    void adc_sampling_stop(void);
+    void adc_sampling_filter_set(adc_filter_t* filter);
+    uint8_t adc_sample_read(uint16_t* sample);
+    uint8_t adc_samples_lost_get(void);
+#endif
+
+//The enum value is the MUX code, so the channel is selected with one masked store. The reference
+//voltage and ADLAR bits are kept as they are. It is inline, so a constant channel folds into the
+//mask at compile time.
+static inline void adc_select_channel(adc_channel_t adc_channel)
+{
+	ADMUX = (ADMUX & ~ADC_MUX_BITS) | (adc_channel & ADC_MUX_BITS);
+}
 
 /*----------------------------------------------------------------
 --------------------- Information on How to Use this Driver -------
@@ -138,6 +206,95 @@ void adc_init(void)
  }
  //Note that in this example where you use the feature of auto triggering of the adc conversion, 
  //you don't have to start the conversion manually.
+ //Note that your own ISR(ADC_vect) needs ADC_DRIVER_ISR_ENABLED to be 0, which is the default.
+___________________________________________________________________
+
+3. Scanning:
+The driver converts a list of channels one after the other from its ADC interrupt, and keeps the
+results of the last complete scan, so reading them never waits for the ADC. The scanning uses the
+ISR(ADC_vect) of the driver, so ADC_DRIVER_ISR_ENABLED is defined as 1 for the whole build.
+--> The first step is Initialization. It can be implemented as follows:
+static const adc_channel_t my_channels[] = {ADC_CHANNEL_0, ADC_CHANNEL_3, ADC_CHANNEL_5};
+void adc_init(void)
+{
+	adc_enable();
+	adc_reference_voltage(ADC_AVCC_AREF);
+	adc_set_clock_prescalar(ADC_PRESCALAR_64);
+	adc_scan_start(my_channels, 3);
+}
+
+--> The second step is reading the results, in the order of the list:
+uint16_t my_channel_values[3];
+uint8_t my_scan;
+uint8_t my_last_scan;
+my_scan = adc_scan_snapshot_get(my_channel_values);
+if (my_scan != my_last_scan)
+{
+	my_last_scan = my_scan;
+	//A new scan completed since the last time.
+}
+//Note that adc_read_channel() stops the scan interrupt, so call adc_scan_stop() before polling,
+//and adc_scan_start() again after it.
+
+- OVERSAMPLING:
+Each channel of the list can get up to ADC_OVERSAMPLING_MAX_BITS extra bits of resolution. For n
+extra bits, the channel is converted 4^n times in a row, and the sum is shifted right by n, so its
+result goes from 0 to (1024 << n) - 1. The interrupt does all the work, and each scan takes the sum
+of the conversions of its channels. The scan clears ADLAR, since it sums the results:
+static const adc_channel_t my_channels[] = {ADC_CHANNEL_0, ADC_CHANNEL_3};
+static const uint8_t my_extra_bits[] = {2, 0};	//12 bits from channel 0, 10 bits from channel 3.
+adc_scan_oversampled_start(my_channels, my_extra_bits, 2);
+//With a 125 kHz ADC clock (about 9600 conversions per second), a scan is 16 + 1 conversions, so
+//both channels are updated about 560 times per second.
+//Note that the extra bits are only real if the input has about 1 LSB of noise, or more.
+
+- OUTPUT RATE:
+By default each scan starts the next one, so the results come as fast as the ADC prescalar and the
+extra bits of the list allow. adc_scan_rate_set() sets the number of scans per second instead:
+timer0 in CTC mode starts each scan, the conversions of the scan follow each other as before, and
+the interrupt does all the work, like this:
+adc_scan_oversampled_start(my_channels, my_extra_bits, 2);
+adc_scan_rate_set(100, F_CPU);	//Both channels are updated 100 times per second.
+It returns 0 if the scan can't fit in the period, or if the period is too long for timer0 (about
+30 scans per second at 8 MHz is the lowest rate). A scan that takes longer than the period, because
+of the interrupts between its conversions, waits for the next compare match, so it is skipped rather
+than mixed with the next one. adc_scan_rate_set(0, F_CPU) makes the scan free running again. Timer0
+can't be used for anything else while the scan is paced, and adc_scan_stop() stops it.
+
+- DIFFERENTIAL CHANNELS:
+The differential channels give 10 bit two's complement results, from -512 to 511, which are sign
+extended like this:
+int16_t my_difference = ((int16_t)(adc_read_channel(ADC_DIFFERENTIAL_1_0_X10) << 6)) >> 6;
+The oversampling and the filters work on unsigned results, so they are for the single ended
+channels, ADC_BANDGAP_1_22V and ADC_GROUND only.
+
+- FILTERING:
+Each list entry can also have one of the filters of adc_filter.h, which the interrupt runs on each
+new result, so the snapshot holds the filtered values. See adc_filter.h for an example.
+___________________________________________________________________
+
+4. Fixed-rate sampling:
+Timer0 triggers the conversions of one channel at a fixed sample rate, so the samples have no
+software jitter, and the ADC interrupt keeps them in a buffer until they are read. Timer0 can't be
+used for anything else meanwhile. Like the scanning, it needs ADC_DRIVER_ISR_ENABLED to be 1.
+--> The first step is Initialization. It can be implemented as follows:
+void adc_init(void)
+{
+	adc_enable();
+	adc_reference_voltage(ADC_AVCC_AREF);
+	adc_set_clock_prescalar(ADC_PRESCALAR_64);
+	adc_sampling_start(ADC_CHANNEL_1, 2000, F_CPU); //2000 samples per second.
+}
+
+--> The second step is reading the samples in the main loop, oldest first:
+uint16_t my_sample;
+while (adc_sample_read(&my_sample))
+{
+	//Process my_sample.
+}
+//If the main loop is too slow, the new samples are dropped and counted by adc_samples_lost_get().
+//A filter of adc_filter.h can run on each sample in the interrupt, so the buffer holds filtered samples:
+adc_sampling_filter_set(&my_filter); //After adc_sampling_start().
 */
 
 
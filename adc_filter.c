@@ -0,0 +1,174 @@
+/*
+ * adc_filter.c
+ *
+ * Created: 19-Oct-26
+ *  Author: Alsayed
+ */ 
+
+
+
+/*----------------------------------------------------------------
+--------------------- File Inclusions ----------------------------
+----------------------------------------------------------------*/
+#include "adc_filter.h"
+#include <stdint.h>
+
+/*----------------------------------------------------------------
+--------------------- Private Constants ---------------------------
+----------------------------------------------------------------*/
+#define ADC_FILTER_MEDIAN_3_LENGTH   3
+#define ADC_FILTER_MEDIAN_5_LENGTH   5
+
+/*----------------------------------------------------------------
+--------------------- Private Functions Prototypes ---------------
+----------------------------------------------------------------*/
+static uint16_t adc_filter_median_update(adc_filter_t* filter, uint16_t sample, uint8_t length);
+
+/*----------------------------------------------------------------
+--------------------- Public Function Definitions ----------------
+----------------------------------------------------------------*/
+//The following function sets a filter up. The shift is the EMA weight (0 to ADC_FILTER_EMA_MAX_SHIFT), or the
+//boxcar length as a power of two (0 to ADC_FILTER_BOXCAR_MAX_SHIFT), and is not used by the other filters.
+//It returns 1 if the filter is set, and 0 if the type or the shift is out of range.
+uint8_t adc_filter_init(adc_filter_t* filter, adc_filter_type_t type, uint8_t shift)
+{
+	switch (type)
+	{
+		case ADC_FILTER_EMA:
+		if (ADC_FILTER_EMA_MAX_SHIFT < shift)
+		{
+			return 0;
+		}
+		break;
+		
+		case ADC_FILTER_BOXCAR:
+		if (ADC_FILTER_BOXCAR_MAX_SHIFT < shift)
+		{
+			return 0;
+		}
+		break;
+		
+		case ADC_FILTER_NONE:
+		case ADC_FILTER_MEDIAN_3:
+		case ADC_FILTER_MEDIAN_5:
+		shift = 0;
+		break;
+		
+		default:
+		return 0;
+	}
+	
+	filter->type = type;
+	filter->shift = shift;
+	filter->primed = 0;
+	filter->index = 0;
+	filter->sum = 0;
+	return 1;
+}
+
+//The following function adds a new sample to a filter and returns the filtered value, in the units of the samples.
+//The first sample fills the history of the filter, so the output starts at the first sample instead of 0.
+uint16_t adc_filter_update(adc_filter_t* filter, uint16_t sample)
+{
+	uint8_t i;
+	
+	switch (filter->type)
+	{
+		case ADC_FILTER_EMA:
+		if (0 == filter->primed)
+		{
+			filter->sum = ((uint32_t)sample << filter->shift);
+			filter->primed = 1;
+		}
+		//sum is y << shift, so y += (x - y) >> shift is done without losing the fraction:
+		filter->sum -= (filter->sum >> filter->shift);
+		filter->sum += sample;
+		return (uint16_t)(filter->sum >> filter->shift);
+		
+		case ADC_FILTER_BOXCAR:
+		if (0 == filter->primed)
+		{
+			for (i = 0; i < (1 << filter->shift); i++)
+			{
+				filter->window[i] = sample;
+			}
+			filter->sum = ((uint32_t)sample << filter->shift);
+			filter->primed = 1;
+		}
+		//The oldest sample leaves the sum as the new one enters it:
+		filter->sum += sample;
+		filter->sum -= filter->window[filter->index];
+		filter->window[filter->index] = sample;
+		filter->index = (filter->index + 1) & ((1 << filter->shift) - 1);
+		return (uint16_t)(filter->sum >> filter->shift);
+		
+		case ADC_FILTER_MEDIAN_3:
+		return adc_filter_median_update(filter, sample, ADC_FILTER_MEDIAN_3_LENGTH);
+		
+		case ADC_FILTER_MEDIAN_5:
+		return adc_filter_median_update(filter, sample, ADC_FILTER_MEDIAN_5_LENGTH);
+		
+		case ADC_FILTER_NONE:
+		default:
+		return sample;
+	}
+}
+
+/*----------------------------------------------------------------
+--------------------- Private Functions Definitions --------------
+----------------------------------------------------------------*/
+//The following function adds a sample to the window of a median filter and returns the median of the window.
+static uint16_t adc_filter_median_update(adc_filter_t* filter, uint16_t sample, uint8_t length)
+{
+	uint16_t sorted[ADC_FILTER_MEDIAN_5_LENGTH];
+	uint16_t value;
+	uint8_t i;
+	uint8_t j;
+	
+	if (0 == filter->primed)
+	{
+		for (i = 0; i < length; i++)
+		{
+			filter->window[i] = sample;
+		}
+		filter->primed = 1;
+	}
+	filter->window[filter->index] = sample;
+	filter->index++;
+	if (length == filter->index)
+	{
+		filter->index = 0;
+	}
+	
+	if (ADC_FILTER_MEDIAN_3_LENGTH == length)
+	{
+		//The median of 3 is the largest of the two smaller ones:
+		uint16_t a = filter->window[0];
+		uint16_t b = filter->window[1];
+		uint16_t c = filter->window[2];
+		if (a > b)
+		{
+			value = a;
+			a = b;
+			b = value;
+		}
+		return (c <= a) ? a : ((c >= b) ? b : c);
+	}
+	
+	//Insertion sort of the 5 samples, at most 10 comparisons:
+	for (i = 0; i < length; i++)
+	{
+		value = filter->window[i];
+		for (j = i; (j > 0) && (sorted[j - 1] > value); j--)
+		{
+			sorted[j] = sorted[j - 1];
+		}
+		sorted[j] = value;
+	}
+	return sorted[length / 2];
+}
+
+
+/*----------------------------------------------------------------
+--------------------- End of File --------------------------------
+----------------------------------------------------------------*/
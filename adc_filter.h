@@ -0,0 +1,85 @@
+/*
+ * adc_filter.h
+ *
+ * Created: 19-Oct-26
+ *  Author: Alsayed
+ */ 
+
+/*----------------------------------------------------------------
+--------------------- Header Guard -------------------------------
+----------------------------------------------------------------*/
+#ifndef ADC_FILTER_H_
+#define ADC_FILTER_H_
+
+/*----------------------------------------------------------------
+--------------------- File Inclusions ----------------------------
+----------------------------------------------------------------*/
+#include <stdint.h>
+
+/*----------------------------------------------------------------
+--------------------- Public Constants ---------------------------
+----------------------------------------------------------------*/
+#define ADC_FILTER_EMA_MAX_SHIFT      8		// The slowest average takes 1/256 of each new sample.
+#define ADC_FILTER_BOXCAR_MAX_SHIFT   3		// The longest moving average is 8 samples.
+#define ADC_FILTER_WINDOW_SIZE        8		// (1 << ADC_FILTER_BOXCAR_MAX_SHIFT), and at least 5 for the median.
+
+/*----------------------------------------------------------------
+--------------------- Public Data Types --------------------------
+----------------------------------------------------------------*/
+typedef enum{
+	ADC_FILTER_NONE=0,			// The samples are passed as they are.
+	ADC_FILTER_EMA,				// Exponential moving average: y += (x - y) / 2^shift.
+	ADC_FILTER_BOXCAR,			// Average of the last 2^shift samples.
+	ADC_FILTER_MEDIAN_3,		// Median of the last 3 samples, removes single sample spikes.
+	ADC_FILTER_MEDIAN_5			// Median of the last 5 samples, removes spikes of up to 2 samples.
+}adc_filter_type_t;
+
+// The state of one filter. It is set by adc_filter_init(), and only changed by adc_filter_update().
+typedef struct{
+	adc_filter_type_t type;
+	uint8_t  shift;
+	uint8_t  primed;			// 0 until the first sample, which fills the filter history.
+	uint8_t  index;				// The oldest sample in the window.
+	uint32_t sum;				// The EMA value << shift, or the sum of the boxcar window.
+	uint16_t window[ADC_FILTER_WINDOW_SIZE];
+}adc_filter_t;
+
+/*----------------------------------------------------------------
+--------------------- Public Function Prototypes ----------------
+----------------------------------------------------------------*/
+    uint8_t adc_filter_init(adc_filter_t* filter, adc_filter_type_t type, uint8_t shift);
+    uint16_t adc_filter_update(adc_filter_t* filter, uint16_t sample);
+
+/*----------------------------------------------------------------
+--------------------- Information on How to Use this Driver -------
+----------------------------------------------------------------*/
+/*
+The filters work on integers only, with shifts instead of divisions, so each new sample costs a few
+additions, and a few comparisons for the medians. Each filter keeps its own state, so every channel
+can have its own filter.
+
+1. Filtering the scan results in the ADC interrupt:
+The scan engine of adc.h passes each new result of a list entry through its filter before storing it,
+so adc_scan_snapshot_get() gives the filtered values with no work in the main loop:
+static adc_filter_t my_pressure_filter;
+static adc_filter_t my_switch_filter;
+adc_filter_init(&my_pressure_filter, ADC_FILTER_EMA, 4);	//Time constant of about 16 scans.
+adc_filter_init(&my_switch_filter, ADC_FILTER_MEDIAN_3, 0);
+adc_scan_start(my_channels, 2);
+adc_scan_filter_set(0, &my_pressure_filter);
+adc_scan_filter_set(1, &my_switch_filter);
+
+2. Filtering the samples of the fixed-rate sampling in the ADC interrupt:
+The sampling of adc.h passes each new sample through its filter before keeping it in the buffer, so
+adc_sample_read() gives the filtered samples with no work in the main loop:
+static adc_filter_t my_filter;
+adc_filter_init(&my_filter, ADC_FILTER_BOXCAR, 2);	//Average of the last 4 samples.
+adc_sampling_start(ADC_CHANNEL_1, 2000, F_CPU);
+adc_sampling_filter_set(&my_filter);
+*/
+
+
+#endif /* ADC_FILTER_H_ */
+/*----------------------------------------------------------------
+--------------------- End of File --------------------------------
+----------------------------------------------------------------*/
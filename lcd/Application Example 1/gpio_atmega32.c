@@ -35,21 +35,46 @@
 /*********************************************************************************************************************
                                               << Private Constants >>
 *********************************************************************************************************************/
+/* A host build predefines the register macros to redirect the driver to its own stand-ins: */
+#ifndef PORTA_REG
 #define   PORTA_REG   *((volatile uint8_t*)(0x3B))
+#endif
+#ifndef DDRA_REG
 #define   DDRA_REG    *((volatile uint8_t*)(0x3A))
+#endif
+#ifndef PINA_REG
 #define   PINA_REG    *((volatile uint8_t*)(0x39))
+#endif
 	     
+#ifndef PORTB_REG
 #define   PORTB_REG   *((volatile uint8_t*)(0x38))
+#endif
+#ifndef DDRB_REG
 #define   DDRB_REG    *((volatile uint8_t*)(0x37))
+#endif
+#ifndef PINB_REG
 #define   PINB_REG    *((volatile uint8_t*)(0x36))
+#endif
 	     
+#ifndef PORTC_REG
 #define   PORTC_REG   *((volatile uint8_t*)(0x35))
+#endif
+#ifndef DDRC_REG
 #define   DDRC_REG    *((volatile uint8_t*)(0x34))
+#endif
+#ifndef PINC_REG
 #define   PINC_REG    *((volatile uint8_t*)(0x33))
+#endif
 	     
+#ifndef PORTD_REG
 #define   PORTD_REG   *((volatile uint8_t*)(0x32))
+#endif
+#ifndef DDRD_REG
 #define   DDRD_REG    *((volatile uint8_t*)(0x31))
+#endif
+#ifndef PIND_REG
 #define   PIND_REG    *((volatile uint8_t*)(0x30))
+#endif
 
 #define   PORT_MAX_PIN_COUNT   8
 /*********************************************************************************************************************
@@ -28,8 +28,12 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <stdint.h>
+#include "uart_config.h"
 #include "uart_atmega32.h"
 #include "bit_math.h"
+#if (UART_COMPILE_TIME_HOOKS == UART_ISR_HOOK_BINDING)
+#include UART_HOOKS_HEADER
+#endif
 
 /*********************************************************************************************************************
                                               << Private Constants >>
@@ -45,6 +49,11 @@
 #define   UCSZ_8BIT_CHAR_SIZE_SELECTED   0x06    /* UCSZ1:0 = 11 */
 #define   UCSZ_9BIT_CHAR_SIZE_SELECTED   0x06    /* UCSZ1:0 = 11 */
 
+/********************************************* Receive Error-relating Macros *****************************************/
+#define   RECEIVE_ERROR_FLAGS_MASK       ((1<<FE)|(1<<DOR)|(1<<PE))
+#define   DISCARDABLE_ERROR_FLAGS_MASK   ((1<<FE)|(1<<PE))    /* DOR reports lost bytes, not a corrupt byte. */
+#define   STATISTICS_COUNTER_MAX         (0xFFFFU)
+
 /*********************************************************************************************************************
                                               << Private Data Types >>
 *********************************************************************************************************************/
@@ -53,8 +62,14 @@
 /*********************************************************************************************************************
                                           << Private Variable Definitions >>
 *********************************************************************************************************************/
+#if (UART_RUNTIME_CALLBACKS == UART_ISR_HOOK_BINDING)
 static void (*g_tx_complete_callback)(void);
 static void (*g_rx_complete_callback)(void);
+#endif
+
+static volatile uint8_t g_last_receive_errors = UART_NO_RECEIVE_ERROR;
+static volatile uart_receive_error_policy_t g_receive_error_policy = UART_KEEP_ERRONEOUS_BYTES;
+static volatile uart_receive_statistics_t g_receive_statistics;
 
 /*********************************************************************************************************************
                                           << Public Variable Definitions >>
@@ -66,6 +81,10 @@ static void (*g_rx_complete_callback)(void);
 *********************************************************************************************************************/
 static uart_std_error_type_t uart_character_size_select(uart_character_size_t uart_character_size);
 static uart_std_error_type_t uart_stop_bit_size_select(uart_stop_bit_size_t uart_stop_bit_size);
+/* Both are forced inline, so the interrupt service routines call no function unless a callback is bound: */
+static inline uint8_t uart_data_register_read(void) __attribute__((always_inline));
+static inline void uart_statistics_counter_increment(volatile uint16_t* statistics_counter)
+	__attribute__((always_inline));
 
 /*********************************************************************************************************************
                                           << Public Function Definitions >>
@@ -365,10 +384,12 @@ void uart_transmit_complete_interrupt_disable(void)
 *  - void
 *
 *********************************************************************************************************************/
+#if (UART_RUNTIME_CALLBACKS == UART_ISR_HOOK_BINDING)
 extern void uart_transmit_complete_interrupt_callback_set(void (*tx_complete_callback)(void))
 {
 	g_tx_complete_callback = tx_complete_callback; /* Call the transmitter callback */
 }
+#endif
 
 /*********************************************************************************************************************
 ** Function Name:
@@ -511,10 +532,12 @@ void uart_receive_complete_interrupt_disable(void)
 *  - void
 *
 *********************************************************************************************************************/
+#if (UART_RUNTIME_CALLBACKS == UART_ISR_HOOK_BINDING)
 void uart_receive_complete_interrupt_callback_set(void (*rx_complete_callback)(void))
 {
 	g_rx_complete_callback = rx_complete_callback;
 }
+#endif
 
 /*********************************************************************************************************************
 ** Function Name:
@@ -547,7 +570,8 @@ uart_is_ready_t uart_receiver_is_ready(void)
 *  uart_data_read
 *
 ** Description:
-*  This function returns the data received in the UART data register.
+*  This function returns the data received in the UART data register. The receive error flags of the byte are latched
+*  before the data register is read, and counted in the receiver statistics.
 *
 ** Input Parameters:
 *  - void
@@ -559,20 +583,174 @@ uart_is_ready_t uart_receiver_is_ready(void)
 *********************************************************************************************************************/
 uint8_t uart_data_read(void)
 {
-	return UDR;
+	return uart_data_register_read();
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  uart_last_receive_errors_get
+*
+** Description:
+*  This function returns the receive error flags of the last byte read by uart_data_read().
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns "UART_NO_RECEIVE_ERROR", or any combination of "UART_FRAME_ERROR", "UART_DATA_OVERRUN_ERROR" and
+*    "UART_PARITY_ERROR".
+*********************************************************************************************************************/
+uint8_t uart_last_receive_errors_get(void)
+{
+	return g_last_receive_errors;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  uart_receive_error_policy_select
+*
+** Description:
+*  This function selects what the receive complete interrupt does with bytes received with a frame or parity error.
+*
+** Input Parameters:
+*  - uart_receive_error_policy: uart_receive_error_policy_t
+*    This parameter passes the error policy selection to the function. For example: UART_DISCARD_ERRONEOUS_BYTES.
+*
+** Return Value:
+*  - uart_std_error_type_t
+*    The return value returns UART_E_OK if the selected configuration is correct, and returns "UART_E_NOT_OK" if
+*    the selected configuration is wrong.
+*********************************************************************************************************************/
+uart_std_error_type_t uart_receive_error_policy_select(uart_receive_error_policy_t uart_receive_error_policy)
+{
+	uart_std_error_type_t return_error = UART_E_NOT_OK;
+	switch (uart_receive_error_policy)
+	{
+		case UART_KEEP_ERRONEOUS_BYTES:
+		case UART_DISCARD_ERRONEOUS_BYTES:
+		g_receive_error_policy = uart_receive_error_policy;
+		return_error = UART_E_OK;
+		break;
+		
+		/* error: wrong configuration. */
+		default:
+		return_error = UART_E_NOT_OK;
+		break;
+	}
+	
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  uart_receive_statistics_get
+*
+** Description:
+*  This function takes a consistent snapshot of the UART receiver statistics.
+*
+** Input Parameters:
+*  - receive_statistics: uart_receive_statistics_t*
+*    Pointer to the structure that will be loaded with the current statistics.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void uart_receive_statistics_get(uart_receive_statistics_t* receive_statistics)
+{
+	uint8_t status_register = SREG;
+	
+	cli(); /* The counters are updated from the receive complete interrupt. */
+	receive_statistics->received_bytes  = g_receive_statistics.received_bytes;
+	receive_statistics->frame_errors    = g_receive_statistics.frame_errors;
+	receive_statistics->data_overruns   = g_receive_statistics.data_overruns;
+	receive_statistics->parity_errors   = g_receive_statistics.parity_errors;
+	receive_statistics->discarded_bytes = g_receive_statistics.discarded_bytes;
+	SREG = status_register; /* Restore the global interrupt state. */
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  uart_receive_statistics_clear
+*
+** Description:
+*  This function resets all the UART receiver statistics counters to zero.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void uart_receive_statistics_clear(void)
+{
+	uint8_t status_register = SREG;
 	
+	cli();
+	g_receive_statistics.received_bytes  = INITIALIZE_TO_ZERO;
+	g_receive_statistics.frame_errors    = INITIALIZE_TO_ZERO;
+	g_receive_statistics.data_overruns   = INITIALIZE_TO_ZERO;
+	g_receive_statistics.parity_errors   = INITIALIZE_TO_ZERO;
+	g_receive_statistics.discarded_bytes = INITIALIZE_TO_ZERO;
+	SREG = status_register;
 }
 
 
+
 /*********************************************************************************************************************
                                           << Private Function Definitions >>
 *********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  uart_data_register_read
+*
+** Description:
+*  This function is uart_data_read() inlined, for the interrupt service routines.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns the data in the UART receiver register.
+*
+*********************************************************************************************************************/
+static inline uint8_t uart_data_register_read(void)
+{
+	/* The error flags belong to the byte at the top of the receive buffer, so they must be read before UDR: */
+	uint8_t receive_errors = (UCSRA & RECEIVE_ERROR_FLAGS_MASK);
+	
+	g_last_receive_errors = receive_errors;
+	uart_statistics_counter_increment(&g_receive_statistics.received_bytes);
+	if (UART_NO_RECEIVE_ERROR != receive_errors)
+	{
+		if (BIT_GET(receive_errors, FE))
+		{
+			uart_statistics_counter_increment(&g_receive_statistics.frame_errors);
+		}
+		if (BIT_GET(receive_errors, DOR))
+		{
+			uart_statistics_counter_increment(&g_receive_statistics.data_overruns);
+		}
+		if (BIT_GET(receive_errors, PE))
+		{
+			uart_statistics_counter_increment(&g_receive_statistics.parity_errors);
+		}
+	}
+	
+	return UDR;
+}
+
 /*********************************************************************************************************************
 Interrupt service routine definition for the UART transmit ready interrupt
 *********************************************************************************************************************/
 ISR(USART_UDRE_vect)
 {
+	#if (UART_COMPILE_TIME_HOOKS == UART_ISR_HOOK_BINDING)
+	uart_transmit_ready_hook();
+	#else
 	g_tx_complete_callback();
+	#endif
 }
 
 /*********************************************************************************************************************
@@ -580,7 +758,20 @@ Interrupt service routine definition for the UART receive complete interrupt.
 *********************************************************************************************************************/
 ISR(USART_RXC_vect)
 {
-	g_rx_complete_callback();
+	if ((UART_DISCARD_ERRONEOUS_BYTES == g_receive_error_policy) && (UCSRA & DISCARDABLE_ERROR_FLAGS_MASK))
+	{
+		/* Reading the data register counts the errors and clears the receive complete flag: */
+		(void)uart_data_register_read();
+		uart_statistics_counter_increment(&g_receive_statistics.discarded_bytes);
+	}
+	else
+	{
+		#if (UART_COMPILE_TIME_HOOKS == UART_ISR_HOOK_BINDING)
+		uart_receive_complete_hook(uart_data_register_read());
+		#else
+		g_rx_complete_callback();
+		#endif
+	}
 }
 /*********************************************************************************************************************
 ** Function Name:
@@ -686,6 +877,28 @@ static uart_std_error_type_t uart_stop_bit_size_select(uart_stop_bit_size_t uart
 		return return_error;
 }
 
+/*********************************************************************************************************************
+** Function Name:
+*  uart_statistics_counter_increment
+*
+** Description:
+*  This function increments one of the receiver statistics counters, saturating at its maximum value.
+*
+** Input Parameters:
+*  - statistics_counter: volatile uint16_t*
+*    Pointer to the counter to be incremented.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+static inline void uart_statistics_counter_increment(volatile uint16_t* statistics_counter)
+{
+	if (STATISTICS_COUNTER_MAX != *statistics_counter)
+	{
+		*statistics_counter = *statistics_counter + 1;
+	}
+}
+
 /*********************************************************************************************************************
                                                 << End of File >>
 *********************************************************************************************************************/
\ No newline at end of file
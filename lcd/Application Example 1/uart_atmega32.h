@@ -33,11 +33,21 @@
                                                << File Inclusions >>
 *********************************************************************************************************************/
 #include <stdint.h>
+#include "uart_config.h"
 
 /*********************************************************************************************************************
                                                << Public Constants >>
 *********************************************************************************************************************/
+/* Interrupt hook binding options, see "uart_config.h": */
+#define   UART_RUNTIME_CALLBACKS    (0)
+#define   UART_COMPILE_TIME_HOOKS   (1)
 
+/* Receive error flags as reported by uart_last_receive_errors_get(). The values match the FE, DOR and PE bit positions
+   of the UCSRA register, so more than one flag may be set for the same byte. */
+#define   UART_NO_RECEIVE_ERROR       (0x00U)
+#define   UART_FRAME_ERROR            (0x10U)
+#define   UART_DATA_OVERRUN_ERROR     (0x08U)
+#define   UART_PARITY_ERROR           (0x04U)
 
 /*********************************************************************************************************************
                                                << Public Data Types >>
@@ -88,6 +98,41 @@ typedef enum
 	UART_CLOCK_POLARITY_0 = 0,
 	UART_CLOCK_POLARITY_1
 	}uart_clock_polarity_t;
+
+typedef enum
+{
+	UART_KEEP_ERRONEOUS_BYTES = 0,
+	UART_DISCARD_ERRONEOUS_BYTES
+	}uart_receive_error_policy_t;
+
+/*********************************************************************************************************************
+** Datatype Name:
+*  uart_receive_statistics_t
+*
+** Description:
+*  This is a structure datatype that holds a snapshot of the UART receiver statistics. The counters stop at their
+*  maximum value instead of wrapping around.
+*
+** Datatype Elements:
+*  [1] received_bytes: uint16_t
+*      The number of bytes read from the UART data register, including the erroneous ones.
+*  [2] frame_errors: uint16_t
+*      The number of bytes received with a frame error (FE), i.e. with an invalid stop bit.
+*  [3] data_overruns: uint16_t
+*      The number of data overrun (DOR) events, i.e. at least one byte was lost because the receive buffer was full.
+*  [4] parity_errors: uint16_t
+*      The number of bytes received with a parity error (PE).
+*  [5] discarded_bytes: uint16_t
+*      The number of erroneous bytes dropped by the receive interrupt in case "UART_DISCARD_ERRONEOUS_BYTES" is selected.
+*********************************************************************************************************************/
+typedef struct
+{
+	uint16_t received_bytes;
+	uint16_t frame_errors;
+	uint16_t data_overruns;
+	uint16_t parity_errors;
+	uint16_t discarded_bytes;
+} uart_receive_statistics_t;
 /*********************************************************************************************************************
                                            << Public Function Declarations >>
 *********************************************************************************************************************/
@@ -272,7 +317,9 @@ extern void uart_transmit_complete_interrupt_disable(void);
 *  - void
 *
 *********************************************************************************************************************/
+#if (UART_RUNTIME_CALLBACKS == UART_ISR_HOOK_BINDING)
 extern void uart_transmit_complete_interrupt_callback_set(void (*tx_complete_callback)(void));
+#endif
 
 
 /*********************************************************************************************************************
@@ -399,7 +446,9 @@ extern void uart_receive_complete_interrupt_disable(void);
 *  - void
 *
 *********************************************************************************************************************/
+#if (UART_RUNTIME_CALLBACKS == UART_ISR_HOOK_BINDING)
 extern void uart_receive_complete_interrupt_callback_set(void (*rx_complete_callback)(void));
+#endif
 
 
 /*********************************************************************************************************************
@@ -426,7 +475,8 @@ extern uart_is_ready_t uart_receiver_is_ready(void);
 *  uart_data_read
 *
 ** Description:
-*  This function returns the data received in the UART data register.
+*  This function returns the data received in the UART data register. The receive error flags of the byte are latched
+*  before the data register is read, and counted in the receiver statistics.
 *
 ** Input Parameters:
 *  - void
@@ -438,6 +488,93 @@ extern uart_is_ready_t uart_receiver_is_ready(void);
 extern uint8_t uart_data_read(void);
 
 
+/*********************************************************************************************************************
+** Function Name:
+*  uart_last_receive_errors_get
+*
+** Description:
+*  This function returns the receive error flags of the last byte read by uart_data_read(). It can be used from the
+*  receive complete callback to tag the byte that has just been read.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns "UART_NO_RECEIVE_ERROR", or any combination of "UART_FRAME_ERROR", "UART_DATA_OVERRUN_ERROR" and
+*    "UART_PARITY_ERROR".
+*
+** Use Example:
+*  data_byte = uart_data_read();
+*  if(UART_NO_RECEIVE_ERROR == uart_last_receive_errors_get())
+*  {
+*     queue_enqueue(&my_queue, data_byte);
+*  }
+*********************************************************************************************************************/
+extern uint8_t uart_last_receive_errors_get(void);
+
+
+/*********************************************************************************************************************
+** Function Name:
+*  uart_receive_error_policy_select
+*
+** Description:
+*  This function selects what the receive complete interrupt does with bytes received with a frame or parity error.
+*  With "UART_KEEP_ERRONEOUS_BYTES", the default, the receive complete callback is called for every byte. With
+*  "UART_DISCARD_ERRONEOUS_BYTES", erroneous bytes are read, counted and dropped by the interrupt service routine
+*  without calling the receive complete callback. Note that a data overrun flags the lost bytes, not the byte that
+*  carries it, so that byte is always passed to the callback.
+*
+** Input Parameters:
+*  - uart_receive_error_policy: uart_receive_error_policy_t
+*    This parameter passes the error policy selection to the function. For example: UART_DISCARD_ERRONEOUS_BYTES.
+*
+** Return Value:
+*  - uart_std_error_type_t
+*    The return value returns UART_E_OK if the selected configuration is correct, and returns "UART_E_NOT_OK" if
+*    the selected configuration is wrong.
+*********************************************************************************************************************/
+extern uart_std_error_type_t uart_receive_error_policy_select(uart_receive_error_policy_t uart_receive_error_policy);
+
+
+/*********************************************************************************************************************
+** Function Name:
+*  uart_receive_statistics_get
+*
+** Description:
+*  This function takes a consistent snapshot of the UART receiver statistics. The snapshot is copied with interrupts
+*  disabled, so it can be called from the main loop while the receive complete interrupt is running.
+*
+** Input Parameters:
+*  - receive_statistics: uart_receive_statistics_t*
+*    Pointer to the structure that will be loaded with the current statistics.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void uart_receive_statistics_get(uart_receive_statistics_t* receive_statistics);
+
+
+/*********************************************************************************************************************
+** Function Name:
+*  uart_receive_statistics_clear
+*
+** Description:
+*  This function resets all the UART receiver statistics counters to zero.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void uart_receive_statistics_clear(void);
+
+
+/* With "UART_COMPILE_TIME_HOOKS", uart_transmit_ready_hook() and uart_receive_complete_hook() are defined by the
+   application in the header named by UART_HOOKS_HEADER, see "uart_hooks.h". */
+
+
 #endif /* UART_ATMEGA32_H_ */ 
 /*********************************************************************************************************************
                                                     << End of File >>
@@ -0,0 +1,58 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  uart_config.h
+*
+** Description:
+*  This file contains the set of configurations for the device driver of UART peripheral of the atmega32
+*  microcontroller.
+*********************************************************************************************************************/
+
+
+#ifndef UART_CONFIG_H_
+#define UART_CONFIG_H_
+
+
+/* Choosing how the UART interrupt service routines call the application code
+** Options:
+*  UART_RUNTIME_CALLBACKS
+*  The interrupt service routines call the functions passed to uart_transmit_complete_interrupt_callback_set() and
+*  uart_receive_complete_interrupt_callback_set() through function pointers.
+*
+*  UART_COMPILE_TIME_HOOKS
+*  The interrupt service routines call uart_transmit_ready_hook() and uart_receive_complete_hook(), which the
+*  application defines as static inline functions in the header named by UART_HOOKS_HEADER. The driver includes that
+*  header, so the hooks are inlined into the interrupt service routines without link time optimization, and only the
+*  registers the hooks actually use are saved, instead of all the call-clobbered registers saved around a call. The
+*  received byte is read inline and passed to uart_receive_complete_hook(). "make -C tests uart-cycles" measures both
+*  options.
+*  uart_transmit_complete_interrupt_callback_set() and uart_receive_complete_interrupt_callback_set() don't exist in
+*  this mode.
+*/
+#define UART_ISR_HOOK_BINDING  UART_RUNTIME_CALLBACKS
+
+/* The header that defines the hooks for "UART_COMPILE_TIME_HOOKS". "uart_hooks.h" is a starting point.
+*/
+#define UART_HOOKS_HEADER  "uart_hooks.h"
+
+
+#endif /* UART_CONFIG_H_ */
+
+
+/*********************************************************************************************************************
+                                               << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,98 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  uart_hooks.h
+*
+** Description:
+*  This file contains the UART interrupt hooks used when "UART_COMPILE_TIME_HOOKS" is selected in "uart_config.h". It
+*  is included only by "uart_atmega32.c", so the hooks are static inline functions that the compiler inlines into the
+*  interrupt service routines. Edit the hook bodies to fit the application. A hook that calls a function the compiler
+*  doesn't inline, like queue_enqueue() of another file, makes the interrupt service routine save all the
+*  call-clobbered registers again, as the runtime callbacks do.
+*********************************************************************************************************************/
+
+
+#ifndef UART_HOOKS_H_
+#define UART_HOOKS_H_
+
+
+/*********************************************************************************************************************
+                                                  << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "uart_atmega32.h"
+
+
+/*********************************************************************************************************************
+                                          << Hook Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  uart_transmit_ready_hook
+*
+** Description:
+*  This function is called directly from the interrupt service routine when the transmit complete interrupt fires,
+*  and replaces the callback passed to uart_transmit_complete_interrupt_callback_set().
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+static inline void uart_transmit_ready_hook(void)
+{
+}
+
+
+/*********************************************************************************************************************
+** Function Name:
+*  uart_receive_complete_hook
+*
+** Description:
+*  This function is called directly from the interrupt service routine when the receive complete interrupt fires,
+*  and replaces the callback passed to uart_receive_complete_interrupt_callback_set(). The interrupt service routine
+*  has already read the byte, the way uart_data_read() does, so the hook doesn't read the data register.
+*
+** Input Parameters:
+*  - data: uint8_t
+*    The received byte.
+*
+** Return Value:
+*  - void
+*
+** Use Example:
+*  A ring buffer that the main loop empties, stored inline:
+*  #define RX_BUFFER_SIZE  (32U)    // A power of two.
+*  extern volatile uint8_t g_rx_buffer[RX_BUFFER_SIZE];
+*  extern volatile uint8_t g_rx_head;
+*
+*  static inline void uart_receive_complete_hook(uint8_t data)
+*  {
+*     uint8_t head = g_rx_head;
+*
+*     g_rx_buffer[head] = data;
+*     g_rx_head = (head + 1U) & (RX_BUFFER_SIZE - 1U);
+*  }
+*********************************************************************************************************************/
+static inline void uart_receive_complete_hook(uint8_t data)
+{
+	(void)data;
+}
+
+
+#endif /* UART_HOOKS_H_ */
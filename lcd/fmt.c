@@ -0,0 +1,428 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  fmt.c
+*
+** Description:
+*  This file contains the implementation of the lightweight formatted output library.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <avr/pgmspace.h>
+#include <stdint.h>
+#include "fmt.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   NO_SIGN                    (0U)
+#define   NO_DECIMAL_POINT           (0U)
+#define   HALF_BYTE                  (4U)
+#define   HALF_BYTE_MASK             (0x0FU)
+#define   UINT32_NIBBLE_COUNT        (8U)
+#define   LONG_POWERS_OF_TEN_COUNT   (6U)   /* 10^9 down to 10^4. */
+#define   SHORT_POWERS_OF_TEN_COUNT  (4U)   /* 10^4 down to 10^1, the units digit is what remains. */
+#define   UINT16_MAX_VALUE           (0xFFFFUL)
+#define   FIELD_MAX_LENGTH           (255U)
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+/* Each decimal digit is found by counting how many times its power of ten can be subtracted, which costs at most nine
+   32-bit subtractions per digit instead of a call to the 32-bit division routine. */
+static const uint32_t g_long_powers_of_ten[LONG_POWERS_OF_TEN_COUNT] PROGMEM =
+{
+	1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL
+};
+
+/* Once the number fits 16 bits, the remaining digits are found with 16-bit subtractions, which cost half the
+   instructions. Numbers up to 65535 never touch the 32-bit table. */
+static const uint16_t g_short_powers_of_ten[SHORT_POWERS_OF_TEN_COUNT] PROGMEM =
+{
+	10000U, 1000U, 100U, 10U
+};
+
+static const char g_hex_digits[] PROGMEM = "0123456789ABCDEF";
+
+/*********************************************************************************************************************
+                                          << Public Variable Definitions >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                         << Private Functions Prototypes >>
+*********************************************************************************************************************/
+static uint8_t fmt_field_write(fmt_sink_t sink, char sign, const char* digits, uint8_t digit_count,
+                               uint8_t fraction_digits, uint8_t minimum_width, fmt_padding_t padding);
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_decimal_digits_convert
+*
+** Description:
+*  This function converts an unsigned integer to its decimal digits, most significant digit first, without leading
+*  zeros.
+*
+** Input Parameters:
+*  - unsigned_number: uint32_t
+*    The number to be converted.
+*  - digits: char*
+*    Pointer to the array that will hold the digits. It needs to have space for FMT_UINT32_MAX_DIGITS characters.
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of digits written to the array.
+*********************************************************************************************************************/
+uint8_t fmt_decimal_digits_convert(uint32_t unsigned_number, char* digits)
+{
+	uint8_t digit_count = 0;
+	uint8_t first_short_power = 0;
+	uint32_t long_power_of_ten;
+	uint16_t short_number;
+	uint16_t short_power_of_ten;
+	char digit;
+
+	if (UINT16_MAX_VALUE < unsigned_number)
+	{
+		for (uint8_t i = 0; i < LONG_POWERS_OF_TEN_COUNT; i++)
+		{
+			long_power_of_ten = pgm_read_dword(&g_long_powers_of_ten[i]);
+			digit = '0';
+			while (unsigned_number >= long_power_of_ten)
+			{
+				unsigned_number -= long_power_of_ten;
+				digit++;
+			}
+			/* Skip the leading zeros: */
+			if (('0' != digit) || (0 != digit_count))
+			{
+				digits[digit_count] = digit;
+				digit_count++;
+			}
+		}
+		/* The 10^4 digit has already been found: */
+		first_short_power = 1;
+	}
+
+	/* The number is now less than 10^4, or it fitted 16 bits from the start: */
+	short_number = (uint16_t)unsigned_number;
+	for (uint8_t i = first_short_power; i < SHORT_POWERS_OF_TEN_COUNT; i++)
+	{
+		short_power_of_ten = pgm_read_word(&g_short_powers_of_ten[i]);
+		digit = '0';
+		while (short_number >= short_power_of_ten)
+		{
+			short_number -= short_power_of_ten;
+			digit++;
+		}
+		if (('0' != digit) || (0 != digit_count))
+		{
+			digits[digit_count] = digit;
+			digit_count++;
+		}
+	}
+	/* What remains is the units digit, which is always written: */
+	digits[digit_count] = (char)('0' + short_number);
+	digit_count++;
+
+	return digit_count;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_unsigned_write
+*
+** Description:
+*  This function writes an unsigned integer in decimal to the given sink.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - unsigned_number: uint32_t
+*    The number to be written.
+*  - minimum_width: uint8_t
+*    The minimum number of characters to be written. Shorter numbers are padded on the left.
+*  - padding: fmt_padding_t
+*    The padding character, "FMT_PAD_WITH_SPACES" or "FMT_PAD_WITH_ZEROS".
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink.
+*********************************************************************************************************************/
+uint8_t fmt_unsigned_write(fmt_sink_t sink, uint32_t unsigned_number, uint8_t minimum_width, fmt_padding_t padding)
+{
+	char digits[FMT_UINT32_MAX_DIGITS];
+	uint8_t digit_count = fmt_decimal_digits_convert(unsigned_number, digits);
+
+	return fmt_field_write(sink, NO_SIGN, digits, digit_count, NO_DECIMAL_POINT, minimum_width, padding);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_signed_write
+*
+** Description:
+*  This function writes a signed integer in decimal to the given sink.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - signed_number: int32_t
+*    The number to be written.
+*  - minimum_width: uint8_t
+*    The minimum number of characters to be written, including the sign.
+*  - padding: fmt_padding_t
+*    The padding character, "FMT_PAD_WITH_SPACES" or "FMT_PAD_WITH_ZEROS".
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink.
+*********************************************************************************************************************/
+uint8_t fmt_signed_write(fmt_sink_t sink, int32_t signed_number, uint8_t minimum_width, fmt_padding_t padding)
+{
+	return fmt_fixed_point_write(sink, signed_number, NO_DECIMAL_POINT, minimum_width, padding);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_hex_write
+*
+** Description:
+*  This function writes an unsigned integer in upper case hexadecimal to the given sink.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - unsigned_number: uint32_t
+*    The number to be written.
+*  - minimum_width: uint8_t
+*    The minimum number of characters to be written.
+*  - padding: fmt_padding_t
+*    The padding character, "FMT_PAD_WITH_SPACES" or "FMT_PAD_WITH_ZEROS".
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink.
+*********************************************************************************************************************/
+uint8_t fmt_hex_write(fmt_sink_t sink, uint32_t unsigned_number, uint8_t minimum_width, fmt_padding_t padding)
+{
+	char digits[UINT32_NIBBLE_COUNT];
+	uint8_t digit_count = 0;
+	uint8_t nibble;
+
+	for (int8_t i = (UINT32_NIBBLE_COUNT - 1); i >= 0; i--)
+	{
+		nibble = (uint8_t)(unsigned_number >> (i * HALF_BYTE)) & HALF_BYTE_MASK;
+		/* Skip the leading zeros, but always keep the last digit: */
+		if ((0 != nibble) || (0 != digit_count) || (0 == i))
+		{
+			digits[digit_count] = pgm_read_byte(&g_hex_digits[nibble]);
+			digit_count++;
+		}
+	}
+
+	return fmt_field_write(sink, NO_SIGN, digits, digit_count, NO_DECIMAL_POINT, minimum_width, padding);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_fixed_point_write
+*
+** Description:
+*  This function writes a signed fixed-point number to the given sink.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - fixed_point_number: int32_t
+*    The number to be written, scaled by 10^fraction_digits.
+*  - fraction_digits: uint8_t
+*    The number of digits after the decimal point, from 0 to FMT_FIXED_POINT_MAX_DIGITS.
+*  - minimum_width: uint8_t
+*    The minimum number of characters to be written, including the sign and the decimal point.
+*  - padding: fmt_padding_t
+*    The padding character, "FMT_PAD_WITH_SPACES" or "FMT_PAD_WITH_ZEROS".
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink, or 0 if fraction_digits is out of range.
+*********************************************************************************************************************/
+uint8_t fmt_fixed_point_write(fmt_sink_t sink, int32_t fixed_point_number, uint8_t fraction_digits,
+                              uint8_t minimum_width, fmt_padding_t padding)
+{
+	char digits[FMT_UINT32_MAX_DIGITS];
+	uint8_t digit_count;
+	uint8_t leading_zeros;
+	uint32_t magnitude = (uint32_t)fixed_point_number;
+	char sign = NO_SIGN;
+
+	if (FMT_FIXED_POINT_MAX_DIGITS < fraction_digits)
+	{
+		return 0;
+	}
+
+	if (0 > fixed_point_number)
+	{
+		sign = '-';
+		magnitude = 0UL - magnitude; /* Also correct for INT32_MIN. */
+	}
+	digit_count = fmt_decimal_digits_convert(magnitude, digits);
+
+	/* At least one digit is needed before the decimal point, e.g. 5 with 2 fractional digits is "0.05": */
+	if (digit_count <= fraction_digits)
+	{
+		leading_zeros = (fraction_digits + 1) - digit_count;
+		for (int8_t i = (digit_count - 1); i >= 0; i--)
+		{
+			digits[i + leading_zeros] = digits[i];
+		}
+		for (uint8_t i = 0; i < leading_zeros; i++)
+		{
+			digits[i] = '0';
+		}
+		digit_count = fraction_digits + 1;
+	}
+
+	return fmt_field_write(sink, sign, digits, digit_count, fraction_digits, minimum_width, padding);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_string_write
+*
+** Description:
+*  This function writes a NULL terminated string to the given sink.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - string: const char*
+*    The string to be written.
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink.
+*********************************************************************************************************************/
+uint8_t fmt_string_write(fmt_sink_t sink, const char* string)
+{
+	uint8_t character_count = 0;
+
+	while ((0 != string[character_count]) && (FIELD_MAX_LENGTH != character_count))
+	{
+		sink((uint8_t)string[character_count]);
+		character_count++;
+	}
+
+	return character_count;
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_field_write
+*
+** Description:
+*  This function writes a converted number to the sink: the left padding, the sign, and the digits with the decimal
+*  point inserted before the last fraction_digits digits.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - sign: char
+*    The sign character, or NO_SIGN.
+*  - digits: const char*
+*    The digits of the number, most significant digit first.
+*  - digit_count: uint8_t
+*    The number of digits. It needs to be larger than fraction_digits.
+*  - fraction_digits: uint8_t
+*    The number of digits after the decimal point, or NO_DECIMAL_POINT.
+*  - minimum_width: uint8_t
+*    The minimum number of characters to be written.
+*  - padding: fmt_padding_t
+*    The padding character.
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink.
+*********************************************************************************************************************/
+static uint8_t fmt_field_write(fmt_sink_t sink, char sign, const char* digits, uint8_t digit_count,
+                               uint8_t fraction_digits, uint8_t minimum_width, fmt_padding_t padding)
+{
+	uint8_t field_length = digit_count;
+	uint8_t padding_length = 0;
+
+	if (NO_SIGN != sign)
+	{
+		field_length++;
+	}
+	if (NO_DECIMAL_POINT != fraction_digits)
+	{
+		field_length++;
+	}
+	if (minimum_width > field_length)
+	{
+		padding_length = minimum_width - field_length;
+	}
+
+	/* Spaces go before the sign, zeros go after it: */
+	if (FMT_PAD_WITH_SPACES == padding)
+	{
+		for (uint8_t i = 0; i < padding_length; i++)
+		{
+			sink(FMT_PAD_WITH_SPACES);
+		}
+	}
+	if (NO_SIGN != sign)
+	{
+		sink((uint8_t)sign);
+	}
+	if (FMT_PAD_WITH_SPACES != padding)
+	{
+		for (uint8_t i = 0; i < padding_length; i++)
+		{
+			sink((uint8_t)padding);
+		}
+	}
+
+	for (uint8_t i = 0; i < digit_count; i++)
+	{
+		if ((NO_DECIMAL_POINT != fraction_digits) && ((digit_count - fraction_digits) == i))
+		{
+			sink('.');
+		}
+		sink((uint8_t)digits[i]);
+	}
+
+	return field_length + padding_length;
+}
+
+/*********************************************************************************************************************
+                                                << End of File >>
+*********************************************************************************************************************/
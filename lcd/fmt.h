@@ -0,0 +1,221 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  fmt.h
+*
+** Description:
+*  This file contains the public programming interfaces for a lightweight formatted output library. It converts
+*  integers to text without printf and without runtime division, and writes the characters to any byte sink, like
+*  lcd_character_write() or a function that adds the byte to a UART transmit queue.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef FMT_H_
+#define FMT_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+
+/*********************************************************************************************************************
+                                               << Public Constants >>
+*********************************************************************************************************************/
+#define   FMT_UINT32_MAX_DIGITS        (10U)   /* 4294967295 */
+#define   FMT_FIXED_POINT_MAX_DIGITS   (9U)    /* Maximum number of fractional digits. */
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Datatype Name:
+*  fmt_sink_t
+*
+** Description:
+*  This is a pointer to the function that receives the formatted characters one by one. Its signature matches
+*  lcd_character_write() and uart_data_write(), so both can be passed directly.
+*********************************************************************************************************************/
+typedef void (*fmt_sink_t)(uint8_t data_byte);
+
+typedef enum
+{
+	FMT_PAD_WITH_SPACES = ' ',
+	FMT_PAD_WITH_ZEROS  = '0'
+} fmt_padding_t;
+
+/*********************************************************************************************************************
+                                          << Public Variable Declarations >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_decimal_digits_convert
+*
+** Description:
+*  This function converts an unsigned integer to its decimal digits, most significant digit first, without leading
+*  zeros. Zero is converted to the single digit '0'. No NULL character is appended. The conversion subtracts powers of
+*  ten stored in flash, so no division routine is called.
+*
+** Input Parameters:
+*  - unsigned_number: uint32_t
+*    The number to be converted.
+*  - digits: char*
+*    Pointer to the array that will hold the digits. It needs to have space for FMT_UINT32_MAX_DIGITS characters.
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of digits written to the array.
+*********************************************************************************************************************/
+extern uint8_t fmt_decimal_digits_convert(uint32_t unsigned_number, char* digits);
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_unsigned_write
+*
+** Description:
+*  This function writes an unsigned integer in decimal to the given sink.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters. For example: lcd_character_write.
+*  - unsigned_number: uint32_t
+*    The number to be written.
+*  - minimum_width: uint8_t
+*    The minimum number of characters to be written. Shorter numbers are padded on the left.
+*  - padding: fmt_padding_t
+*    The padding character, "FMT_PAD_WITH_SPACES" or "FMT_PAD_WITH_ZEROS".
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink.
+*
+** Example:
+*  fmt_unsigned_write(lcd_character_write, 42, 5, FMT_PAD_WITH_ZEROS);
+*  Note: "00042" is written on the LCD.
+*********************************************************************************************************************/
+extern uint8_t fmt_unsigned_write(fmt_sink_t sink, uint32_t unsigned_number, uint8_t minimum_width,
+                                  fmt_padding_t padding);
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_signed_write
+*
+** Description:
+*  This function writes a signed integer in decimal to the given sink. Negative numbers are preceded by '-'. With zero
+*  padding, the zeros are placed after the sign, like printf does.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - signed_number: int32_t
+*    The number to be written.
+*  - minimum_width: uint8_t
+*    The minimum number of characters to be written, including the sign.
+*  - padding: fmt_padding_t
+*    The padding character, "FMT_PAD_WITH_SPACES" or "FMT_PAD_WITH_ZEROS".
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink.
+*********************************************************************************************************************/
+extern uint8_t fmt_signed_write(fmt_sink_t sink, int32_t signed_number, uint8_t minimum_width, fmt_padding_t padding);
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_hex_write
+*
+** Description:
+*  This function writes an unsigned integer in upper case hexadecimal, without a "0x" prefix, to the given sink.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - unsigned_number: uint32_t
+*    The number to be written.
+*  - minimum_width: uint8_t
+*    The minimum number of characters to be written. For example, 2 for a byte or 4 for a register address.
+*  - padding: fmt_padding_t
+*    The padding character, "FMT_PAD_WITH_SPACES" or "FMT_PAD_WITH_ZEROS".
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink.
+*********************************************************************************************************************/
+extern uint8_t fmt_hex_write(fmt_sink_t sink, uint32_t unsigned_number, uint8_t minimum_width, fmt_padding_t padding);
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_fixed_point_write
+*
+** Description:
+*  This function writes a signed fixed-point number to the given sink. The number is passed as an integer count of
+*  10^-fraction_digits units, so no scaling or division is done at runtime.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - fixed_point_number: int32_t
+*    The number to be written, scaled by 10^fraction_digits. For example: 2345 with 2 fractional digits is 23.45.
+*  - fraction_digits: uint8_t
+*    The number of digits after the decimal point, from 0 to FMT_FIXED_POINT_MAX_DIGITS.
+*  - minimum_width: uint8_t
+*    The minimum number of characters to be written, including the sign and the decimal point.
+*  - padding: fmt_padding_t
+*    The padding character, "FMT_PAD_WITH_SPACES" or "FMT_PAD_WITH_ZEROS".
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink, or 0 if fraction_digits is out of range.
+*
+** Example:
+*  fmt_fixed_point_write(lcd_character_write, -705, 2, 6, FMT_PAD_WITH_SPACES);
+*  Note: " -7.05" is written on the LCD.
+*********************************************************************************************************************/
+extern uint8_t fmt_fixed_point_write(fmt_sink_t sink, int32_t fixed_point_number, uint8_t fraction_digits,
+                                     uint8_t minimum_width, fmt_padding_t padding);
+
+/*********************************************************************************************************************
+** Function Name:
+*  fmt_string_write
+*
+** Description:
+*  This function writes a NULL terminated string to the given sink.
+*
+** Input Parameters:
+*  - sink: fmt_sink_t
+*    The function that receives the characters.
+*  - string: const char*
+*    The string to be written.
+*
+** Return Value:
+*  - uint8_t
+*    Returns the number of characters written to the sink. Strings longer than 255 characters are cut.
+*********************************************************************************************************************/
+extern uint8_t fmt_string_write(fmt_sink_t sink, const char* string);
+
+
+#endif /* FMT_H_ */
+/*********************************************************************************************************************
+                                               << End of File >>
+*********************************************************************************************************************/
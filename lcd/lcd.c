@@ -29,10 +29,15 @@
 *********************************************************************************************************************/
 #include "lcd_config.h"  /* Note: It also contains the definition of F_CPU required for the delay functions. */
 #include <util/delay.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
 #include <stdint.h>
+#include <stddef.h>
 #include "lcd.h"
 #include "bit_math.h"
 #include "gpio_atmega32.h"
+#include "twi_atmega32.h"
+#include "fmt.h"
 
 /*********************************************************************************************************************
                                               << Private Constants >>
@@ -41,14 +46,276 @@
 #define   LCD_8BIT_OPERATION   (1)
 #define   HALF_BYTE   (4U)
 
+#define   LCD_FIXED_DELAYS        (0)
+#define   LCD_BUSY_FLAG_POLLING   (1)
+
+#define   LCD_GPIO_DRIVER_BACKEND        (0)
+#define   LCD_DIRECT_REGISTERS_BACKEND   (1)
+#define   LCD_PCF8574_BACKEND            (2)
+
+#define   LCD_BLOCKING_TRANSFERS       (0)
+#define   LCD_ASYNCHRONOUS_TRANSFERS   (1)
+
+#define   LCD_4BIT_DATA_PINS   ((1<<LCD_D7)|(1<<LCD_D6)|(1<<LCD_D5)|(1<<LCD_D4))
+#define   LCD_8BIT_DATA_PINS   (0xFFU)
+#define   LCD_CONTROL_PINS     ((1<<LCD_RS)|(1<<LCD_RW)|(1<<LCD_EN))
+
+/* Input pins with their port bits set have their pull-ups on. While polling, a data pin the LCD doesn't drive (RW
+   tied to ground) reads high, busy, so the poll times out instead of reading a floating pin as ready: */
+#define   LCD_DATA_PINS_PULL_UP   (0xFFU)
+
+/* Displays sharing the bus are selected by their enable pins, one bit for each display: */
+#if ((1U > LCD_DISPLAY_COUNT) || (3U < LCD_DISPLAY_COUNT))
+#error "LCD_DISPLAY_COUNT" needs to be from 1 to 3 in "lcd_config.h"
+#endif
+#define   LCD_DISPLAY_MASK(display)   (1U << (display))
+#define   LCD_ALL_DISPLAYS_MASK       ((1U << LCD_DISPLAY_COUNT) - 1U)
+
+/* The ports are enum constants, which the preprocessor can't compare, so this is folded by the compiler instead. When
+   it is true, a 4 bit mode nibble and the control pins are written to the port at once: */
+#define   LCD_SINGLE_PORT_WIRING   ((LCD_DATA_PORT == LCD_RS_CNTRL_PORT) && (LCD_DATA_PORT == LCD_RW_CNTRL_PORT) && \
+                                    (LCD_DATA_PORT == LCD_EN_CNTRL_PORT))
+
+/* Pin access. The direct registers backend selects the registers with comparisons of constants, so each access
+   compiles to the same instructions as a hand written register access, like sbi and cbi for the enable pin: */
+#if   (LCD_DIRECT_REGISTERS_BACKEND == LCD_PIN_BACKEND)
+#define   LCD_PORT_REGISTER(port)   (*(((port) == GPIO_PORTA) ? &PORTA : ((port) == GPIO_PORTB) ? &PORTB : \
+                                       ((port) == GPIO_PORTC) ? &PORTC : &PORTD))
+#define   LCD_DDR_REGISTER(port)    (*(((port) == GPIO_PORTA) ? &DDRA  : ((port) == GPIO_PORTB) ? &DDRB  : \
+                                       ((port) == GPIO_PORTC) ? &DDRC  : &DDRD))
+#define   LCD_PIN_REGISTER(port)    (*(((port) == GPIO_PORTA) ? &PINA  : ((port) == GPIO_PORTB) ? &PINB  : \
+                                       ((port) == GPIO_PORTC) ? &PINC  : &PIND))
+
+#define   LCD_PINS_CONFIG(port, pins, direction, value)   do { \
+	LCD_DDR_REGISTER(port)  = (LCD_DDR_REGISTER(port)  & ~(pins)) | ((pins) & (direction)); \
+	LCD_PORT_REGISTER(port) = (LCD_PORT_REGISTER(port) & ~(pins)) | ((pins) & (value)); } while (0)
+#define   LCD_PIN_CONFIG(port, pin, direction, level)     \
+	LCD_PINS_CONFIG(port, (1<<(pin)), direction, ((GPIO_PIN_LOW == (level)) ? 0x00U : 0xFFU))
+#define   LCD_PORT_WRITE(port, value)          (LCD_PORT_REGISTER(port) = (value))
+#define   LCD_PINS_WRITE(port, pins, value)    (LCD_PORT_REGISTER(port) = (LCD_PORT_REGISTER(port) & ~(pins)) | ((value) & (pins)))
+#define   LCD_PIN_WRITE(port, pin, level)      do { \
+	if (GPIO_PIN_LOW == (level)) { LCD_PORT_REGISTER(port) &= ~(1<<(pin)); } \
+	else                         { LCD_PORT_REGISTER(port) |=  (1<<(pin)); } } while (0)
+#define   LCD_PIN_READ(port, pin, pin_level)   (*(pin_level) = (gpio_pin_level_t)((LCD_PIN_REGISTER(port) >> (pin)) & 0x01U))
+
+#elif (LCD_GPIO_DRIVER_BACKEND == LCD_PIN_BACKEND)
+#define   LCD_PINS_CONFIG(port, pins, direction, value)   gpio_pins_config(port, pins, direction, value)
+#define   LCD_PIN_CONFIG(port, pin, direction, level)     gpio_pin_config(port, pin, direction, level)
+#define   LCD_PORT_WRITE(port, value)                     gpio_port_write(port, value)
+#define   LCD_PINS_WRITE(port, pins, value)               gpio_pins_write(port, pins, value)
+#define   LCD_PIN_WRITE(port, pin, level)                 gpio_pin_write(port, pin, level)
+#define   LCD_PIN_READ(port, pin, pin_level)              gpio_pin_read(port, pin, pin_level)
+
+#elif (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+/* All the LCD pins are outputs of the I2C expander, which is written a whole byte at a time. Each nibble takes two
+   bytes, with the enable pin high then low, and the time the bytes take on the bus replaces the delays. RS can't
+   change in the byte that raises the enable pin (tAS), so a change of register takes one more byte before it: */
+#define   LCD_EXPANDER_RS                (0x01U)   /* P0 */
+#define   LCD_EXPANDER_RW                (0x02U)   /* P1, kept low. */
+#define   LCD_EXPANDER_EN                (0x04U)   /* P2 */
+#define   LCD_EXPANDER_BACKLIGHT         (0x08U)   /* P3, kept on. */
+#define   LCD_EXPANDER_DATA_BITS         (0xF0U)   /* P4-P7 drive D4-D7. */
+#define   LCD_EXPANDER_BYTES_PER_NIBBLE  (2U)
+
+#if (LCD_4BIT_OPERATION != LCD_MODE)
+#error The I2C expander drives D4-D7 only. Choose "LCD_4BIT_OPERATION" in "lcd_config.h"
+#endif
+#if (LCD_FIXED_DELAYS != LCD_WAIT_MODE)
+#error The busy flag can not be read through the I2C expander. Choose "LCD_FIXED_DELAYS" in "lcd_config.h"
+#endif
+#if (LCD_BLOCKING_TRANSFERS != LCD_TRANSFER_MODE)
+#error The I2C expander is already written in the background by the TWI interrupt. Choose "LCD_BLOCKING_TRANSFERS" in "lcd_config.h"
+#endif
+#if (1U < LCD_DISPLAY_COUNT)
+#error The I2C expander drives a single LCD. Set "LCD_DISPLAY_COUNT" to 1 in "lcd_config.h"
+#endif
+#if (LCD_I2C_SCL_FREQ > 400000UL)
+#error "LCD_I2C_SCL_FREQ" needs to be at most 400 kHz, so two expander bytes take longer than a short instruction.
+#endif
+#if ((2U * LCD_EXPANDER_BYTES_PER_NIBBLE + 1U) > LCD_I2C_BUFFER_SIZE) || (255U < LCD_I2C_BUFFER_SIZE)
+#error "LCD_I2C_BUFFER_SIZE" needs to be from 5 to 255 in "lcd_config.h"
+#endif
+
+#else
+#error You need to specify the pin backend of the LCD. Choose between the GPIO driver, direct registers and the I2C expander in "lcd_config.h"
+
+#endif
+
+#define   LCD_COMMAND_REGISTER   GPIO_PIN_LOW
+#define   LCD_DATA_REGISTER      GPIO_PIN_HIGH
+
+/* Clear display (0x01) and return home (0x02, 0x03) are the only commands that need more than 40 us: */
+#define   LCD_LONG_COMMAND_MAX            (0x03U)
+#define   LCD_LONG_EXECUTION_TIME_US      (1600U)
+#define   LCD_SHORT_EXECUTION_TIME_US     (100U)
+
+/* The wake-up sequence of the HD44780 datasheet: three 8 bit function set instructions reach the 8 bit mode from any
+   state. The first one needs a longer wait, in case it completes an instruction left half sent in 4 bit mode: */
+#define   LCD_WAKEUP_INSTRUCTION          (0x30U)
+#define   LCD_4BIT_INTERFACE_INSTRUCTION  (0x20U)
+#define   LCD_WAKEUP_FIRST_WAIT_US        (4100U)
+#define   LCD_WAKEUP_WAIT_US              (100U)
+
+/* Commands that are decoded to track the cursor: */
+#define   LCD_RETURN_HOME_COMMAND_MASK    (0xFEU)   /* 0x02 and 0x03 */
+#define   LCD_CLEAR_DISPLAY_COMMAND       (0x01U)
+#define   LCD_RETURN_HOME_COMMAND         (0x02U)
+#define   LCD_ENTRY_MODE_COMMAND_MASK     (0xFCU)   /* 0x04 to 0x07 */
+#define   LCD_ENTRY_MODE_COMMAND          (0x04U)
+#define   LCD_ENTRY_MODE_INCREMENT        (0x02U)
+#define   LCD_DISPLAY_CONTROL_COMMAND_MASK (0xF8U)  /* 0x08 to 0x0F */
+#define   LCD_DISPLAY_CONTROL_COMMAND     (0x08U)
+#define   LCD_FUNCTION_SET_COMMAND_MASK   (0xE0U)   /* 0x20 to 0x3F */
+#define   LCD_FUNCTION_SET_COMMAND        (0x20U)
+#define   LCD_SET_DDRAM_ADDRESS_COMMAND   (0x80U)
+
+/* Lines 0 and 1 start at DDRAM addresses 0x00 and 0x40. On 4 line LCDs, lines 2 and 3 continue lines 0 and 1 right
+   after their last visible column. The address is calculated without a table or a multiplication: */
+#define   LCD_SECOND_LINE_ADDRESS   (0x40U)
+#define   LCD_LINE_ADDRESS(y)       ((((y) & 0x01U) ? LCD_SECOND_LINE_ADDRESS : 0x00U) + (((y) & 0x02U) ? LCD_COLUMNS : 0x00U))
+
+#if   (LCD_FIXED_DELAYS == LCD_WAIT_MODE)
+#define   LCD_ENABLE_PULSE_WIDTH_US       (40U)
+#define   LCD_NIBBLES_GAP_US              (100U)
+
+#elif (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE)
+/* The HD44780 needs 450 ns enable pulses and a 1 us enable cycle, the rest is done by reading the busy flag: */
+#define   LCD_ENABLE_PULSE_WIDTH_US       (1U)
+#define   LCD_NIBBLES_GAP_US              (1U)
+
+#else
+#error You need to specify how the driver waits for the LCD. Choose between fixed delays and busy flag polling in "lcd_config.h"
+
+#endif
+
+/* The time a transfer surely takes, counting its delays only. It passes for the displays that aren't written: */
+#if   (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+/* The expander bytes of a transfer take longer on the bus than a short instruction takes to execute: */
+#define   LCD_TRANSFER_MIN_TIME_US        LCD_SHORT_EXECUTION_TIME_US
+#elif (LCD_8BIT_OPERATION == LCD_MODE)
+#define   LCD_TRANSFER_MIN_TIME_US        LCD_ENABLE_PULSE_WIDTH_US
+#else
+#define   LCD_TRANSFER_MIN_TIME_US        ((2U * LCD_ENABLE_PULSE_WIDTH_US) + LCD_NIBBLES_GAP_US)
+#endif
+/* _delay_us() needs a constant, so the remaining execution times are waited in steps: */
+#define   LCD_WAIT_STEP_US                (10U)
+/* The next transfer to the same display latches its first nibble one enable pulse after it starts, so only that pulse
+   is taken off the execution time of the instruction before: */
+#define   LCD_WAIT_BEFORE_LATCH_US(execution_time_us) \
+	(((execution_time_us) > LCD_ENABLE_PULSE_WIDTH_US) ? ((execution_time_us) - LCD_ENABLE_PULSE_WIDTH_US) : 0U)
+
+#if (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+#if (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE)
+#error The asynchronous transfers wait with timer ticks. Choose "LCD_FIXED_DELAYS" in "lcd_config.h"
+#endif
+
+/* Each queue item holds the item type in the high byte and the command, the character or the ticks in the low byte: */
+#define   LCD_ASYNC_COMMAND_ITEM   (0x00U)
+#define   LCD_ASYNC_DATA_ITEM      (0x01U)
+#define   LCD_ASYNC_DELAY_ITEM     (0x02U)
+#define   LCD_ASYNC_WAKEUP_ITEM    (0x03U)   /* A single write, only the high nibble in 4 bit mode. */
+#define   LCD_ASYNC_ITEM_TYPE_SHIFT   (8U)
+#define   LCD_ASYNC_MAX_DELAY_TICKS   (0xFFU)
+
+/* Timer2 runs in CTC mode with a prescaler of 8 and interrupts once every tick: */
+#define   LCD_ASYNC_TIMER_PRESCALER      (8UL)
+#define   LCD_ASYNC_TIMER_COMPARE_VALUE  (((F_CPU / LCD_ASYNC_TIMER_PRESCALER) * LCD_ASYNC_TICK_US / 1000000UL) - 1UL)
+
+#if (LCD_ASYNC_TIMER_COMPARE_VALUE > 0xFFUL)
+#error "LCD_ASYNC_TICK_US" is too long for Timer2 at this F_CPU. Choose a shorter tick in "lcd_config.h"
+#endif
+#if (LCD_ASYNC_TICK_US < 40U)
+#error "LCD_ASYNC_TICK_US" needs to be at least 40 us, the execution time of most LCD commands.
+#endif
+
+/* The next transfer starts one tick after the enable pulse ends, so only the extra ticks are counted here: */
+#define   LCD_ASYNC_LONG_COMMAND_TICKS   ((LCD_LONG_EXECUTION_TIME_US + LCD_ASYNC_TICK_US - 1U) / LCD_ASYNC_TICK_US - 1U)
+#define   LCD_ASYNC_TICKS(time_us)       (((time_us) + LCD_ASYNC_TICK_US - 1U) / LCD_ASYNC_TICK_US)
+/* The enable pin stays low this long between the two nibbles of a byte, which meets the 1 us enable cycle (tcycE) of
+   the HD44780 on its own. The high pulses last a whole tick: */
+#define   LCD_ASYNC_ENABLE_LOW_US        (1U)
+#define   LCD_ASYNC_POWER_ON_TICKS       LCD_ASYNC_TICKS(LCD_POWER_ON_DELAY_US)
+
+#if (1U < LCD_DISPLAY_COUNT)
+#error The asynchronous transfers support a single LCD. Set "LCD_DISPLAY_COUNT" to 1 in "lcd_config.h"
+#endif
+
+#elif (LCD_BLOCKING_TRANSFERS != LCD_TRANSFER_MODE)
+#error You need to specify the transfer mode of the LCD. Choose between blocking and asynchronous transfers in "lcd_config.h"
+
+#endif
+
 /*********************************************************************************************************************
                                               << Private Data Types >>
 *********************************************************************************************************************/
+/* The cursor location as tracked by the driver for each display. The x location can be LCD_COLUMNS right after the
+   last column of a line is written, which no lcd_gotoxy() call matches: */
+typedef struct
+{
+	uint8_t x;
+	uint8_t y;
+	uint8_t known;
+	uint8_t entry_decrement;
+} lcd_cursor_t;
+
+#if (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+typedef enum
+{
+	LCD_ASYNC_IDLE = 0,
+	LCD_ASYNC_LOW_NIBBLE,
+	LCD_ASYNC_LATCH,
+	LCD_ASYNC_WAIT
+} lcd_async_state_t;
+#endif
 
 
 /*********************************************************************************************************************
                                           << Private Variable Definitions >>
 *********************************************************************************************************************/
+static lcd_cursor_t g_lcd_cursors[LCD_DISPLAY_COUNT];
+
+/* The display the functions work on, and the enable pins pulsed by the transfers. During the initialization, all the
+   enable pins are pulsed together, so all the displays are initialized at once: */
+static uint8_t g_lcd_selected_display = 0;
+static uint8_t g_lcd_enable_mask = LCD_DISPLAY_MASK(0);
+
+#if (LCD_BLOCKING_TRANSFERS == LCD_TRANSFER_MODE)
+/* The part of the execution time of each display's last instruction that isn't known to have passed. The transfers to
+   the other displays and the waits take their time off, so displays written in turns are only waited for the rest: */
+static uint16_t g_lcd_pending_wait_us[LCD_DISPLAY_COUNT];
+#endif
+
+/* What lcd_init() waited for, given by lcd_init_trace_get(): */
+static lcd_init_trace_t g_lcd_init_trace;
+
+#if (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE)
+/* The busy flag can't be read until the function set command is sent, and it is never read again after a timeout: */
+static uint8_t g_lcd_busy_flag_usable = 0;
+#endif
+
+#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+/* Expander bytes, in two buffers: the TWI interrupt sends one while the functions fill the other. The bytes written
+   while a transaction is in progress are all sent by the next one, so a string goes out in a few long transactions: */
+static uint8_t g_lcd_expander_buffers[2][LCD_I2C_BUFFER_SIZE];
+static volatile uint8_t g_lcd_expander_fill_buffer = 0;
+static volatile uint8_t g_lcd_expander_fill_length = 0;
+static volatile uint8_t g_lcd_expander_sending = 0;
+static twi_transaction_t g_lcd_expander_transaction;
+/* RS as in the last byte added to the buffer. The expander starts with all its outputs high: */
+static uint8_t g_lcd_expander_register_select = LCD_EXPANDER_RS;
+#endif
+
+#if (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+/* Transfers queue, filled by the public functions and emptied by the Timer2 compare match ISR: */
+static uint16_t g_lcd_async_queue[LCD_ASYNC_QUEUE_SIZE];
+static volatile uint8_t g_lcd_async_queue_head = 0;
+static volatile uint8_t g_lcd_async_queue_tail = 0;
+
+/* The transfer in progress, only accessed by the ISR except for the state: */
+static volatile lcd_async_state_t g_lcd_async_state = LCD_ASYNC_IDLE;
+static uint16_t g_lcd_async_item;
+static uint8_t  g_lcd_async_wait_ticks;
+#endif
 
 
 /*********************************************************************************************************************
@@ -59,13 +326,43 @@
 /*********************************************************************************************************************
                                          << Private Functions Prototypes >>
 *********************************************************************************************************************/
-static void lcd_4bit_init(void);
+static lcd_std_error_type_t lcd_4bit_init(void);
+
+static void lcd_power_on_wait(void);
+static void lcd_wakeup_instruction_send(uint8_t instruction, uint16_t wait_us);
+static void lcd_cursor_track(uint8_t lcd_command);
+static void lcd_wrapped_character_write(uint8_t data_character);
+#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+static lcd_std_error_type_t lcd_expander_init(void);
+static void lcd_expander_write(uint8_t data_byte, gpio_pin_level_t register_select, uint8_t nibbles_count);
+static void lcd_expander_buffer_send(void);
+static void lcd_expander_drain(void);
+static void lcd_expander_transaction_complete(twi_transaction_t* transaction);
+
+#else
 static void lcd_8bit_init(void);
+static void lcd_bus_setup(uint8_t data_bits, gpio_pin_level_t register_select);
+static void lcd_enable_set(gpio_pin_level_t enable_level);
+#endif
 
-static void lcd_8bit_command_send(lcd_command_t lcd_command);
-static void lcd_4bit_command_send(lcd_command_t lcd_command);
-static void lcd_8bit_character_write(uint8_t data_character);
-static void lcd_4bit_character_write(uint8_t data_character);
+#if (LCD_BLOCKING_TRANSFERS == LCD_TRANSFER_MODE)
+static void lcd_4bit_transfer(uint8_t data_byte, gpio_pin_level_t register_select);
+#if (LCD_PCF8574_BACKEND != LCD_PIN_BACKEND)
+static void lcd_8bit_transfer(uint8_t data_byte, gpio_pin_level_t register_select);
+static void lcd_enable_pulse(void);
+#endif
+static void lcd_ready_wait(void);
+static void lcd_pending_waits_start(uint8_t data_byte, gpio_pin_level_t register_select);
+static void lcd_pending_waits_elapse(uint16_t elapsed_us, uint8_t ready_mask);
+#if (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE)
+static lcd_std_error_type_t lcd_displays_ready_poll(uint16_t timeout_us, uint16_t* wait_us);
+static lcd_std_error_type_t lcd_busy_flag_poll(uint16_t timeout_us, uint16_t* wait_us);
+#endif
+
+#elif (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+static void lcd_async_timer_init(void);
+static void lcd_async_enqueue(uint8_t item_type, uint8_t item_value);
+#endif
 /*********************************************************************************************************************
                                           << Public Function Definitions >>
 *********************************************************************************************************************/
@@ -80,21 +377,122 @@ static void lcd_4bit_character_write(uint8_t data_character);
 *  - void
 *
 ** Return Value:
-*  - void
+*  - lcd_std_error_type_t
+*    Returns LCD_NOT_OK if the TWI driver of the I2C expander can't be started, and LCD_OK otherwise.
 *********************************************************************************************************************/
-void lcd_init(void)
+lcd_std_error_type_t lcd_init(void)
 {
+	lcd_std_error_type_t return_error = LCD_OK;
+	
+	#if (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+	lcd_async_timer_init();
+	#endif
+	
+	g_lcd_enable_mask = LCD_ALL_DISPLAYS_MASK;
+	
 	#if   (LCD_8BIT_OPERATION == LCD_MODE)
 		lcd_8bit_init();
 		
 	#elif (LCD_4BIT_OPERATION == LCD_MODE)
-		lcd_4bit_init();
+		return_error = lcd_4bit_init();
 		
 	#else
 	#error You need to specify the operation mode of the LCD. Choose between 8 bit and 4 bit modes in "lcd_config.h"
 
     #endif
 
+	/* All the displays are cleared with their cursors moving right: */
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		g_lcd_cursors[display].x = 0;
+		g_lcd_cursors[display].y = 0;
+		g_lcd_cursors[display].known = 1;
+		g_lcd_cursors[display].entry_decrement = 0;
+	}
+	g_lcd_enable_mask = LCD_DISPLAY_MASK(g_lcd_selected_display);
+	
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_display_select
+*
+** Description:
+*  This function selects the display that the other LCD functions work on, when more than one display shares the
+*  LCD bus.
+*
+** Input Parameters:
+*  - display: uint8_t
+*    The display number, from 0 to LCD_DISPLAY_COUNT - 1. Display 0 uses LCD_EN, display 1 uses LCD_EN2 and display 2
+*    uses LCD_EN3.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for a correct display number, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_display_select(uint8_t display)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+	
+	if (LCD_DISPLAY_COUNT > display)
+	{
+		g_lcd_selected_display = display;
+		g_lcd_enable_mask = LCD_DISPLAY_MASK(display);
+		return_error = LCD_OK;
+	}
+	
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_selected_display_get
+*
+** Description:
+*  This function gives the display that the LCD functions work on.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    The selected display number.
+*********************************************************************************************************************/
+uint8_t lcd_selected_display_get(void)
+{
+	return g_lcd_selected_display;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_init_trace_get
+*
+** Description:
+*  This function gives what the last lcd_init() call waited for.
+*
+** Input Parameters:
+*  - init_trace: lcd_init_trace_t*
+*    Pointer to the structure that receives the trace.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the trace is given, and 'LCD_NOT_OK' for a NULL pointer.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_init_trace_get(lcd_init_trace_t* init_trace)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+	
+	if (NULL != init_trace)
+	{
+		*init_trace = g_lcd_init_trace;
+		#if (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE)
+		init_trace->busy_flag_usable = g_lcd_busy_flag_usable;
+		#endif
+		return_error = LCD_OK;
+	}
+	
+	return return_error;
 }
 
 /*********************************************************************************************************************
@@ -116,10 +514,25 @@ void lcd_init(void)
 *********************************************************************************************************************/
 lcd_std_error_type_t lcd_gotoxy(uint8_t x, uint8_t y)
 {
-  lcd_std_error_type_t return_error = LCD_OK; /* To do*/
-	uint8_t first_char_address[]={0x80, 0xC0, 0x90, 0xD0}; /* Fits 16x2 and 16x4 LCDs */
-	lcd_command_send(first_char_address[y]+(x));
-	_delay_us(100);	
+  lcd_std_error_type_t return_error = LCD_OK;
+	lcd_cursor_t* cursor = &g_lcd_cursors[g_lcd_selected_display];
+	
+	if ((LCD_COLUMNS <= x) || (LCD_ROWS <= y))
+	{
+		return_error = LCD_NOT_OK;
+	}
+	/* The LCD address counter is already there, no command is needed: */
+	else if (cursor->known && (cursor->x == x) && (cursor->y == y))
+	{
+		return_error = LCD_OK;
+	}
+	else
+	{
+		lcd_command_send(LCD_SET_DDRAM_ADDRESS_COMMAND | (LCD_LINE_ADDRESS(y) + x));
+		cursor->x = x;
+		cursor->y = y;
+		cursor->known = 1;
+	}
   
   return return_error;
 }
@@ -142,16 +555,25 @@ lcd_std_error_type_t lcd_gotoxy(uint8_t x, uint8_t y)
 *********************************************************************************************************************/
 lcd_std_error_type_t lcd_command_send(lcd_command_t lcd_command)
 {
-    #if   (LCD_8BIT_OPERATION == LCD_MODE)
-    lcd_8bit_command_send(lcd_command);
+    lcd_std_error_type_t return_error = LCD_OK;
+    
+    #if   (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+    lcd_async_enqueue(LCD_ASYNC_COMMAND_ITEM, lcd_command);
+    
+    #elif (LCD_8BIT_OPERATION == LCD_MODE)
+    lcd_8bit_transfer(lcd_command, LCD_COMMAND_REGISTER);
     
     #elif (LCD_4BIT_OPERATION == LCD_MODE)
-    lcd_4bit_command_send(lcd_command);
+    lcd_4bit_transfer(lcd_command, LCD_COMMAND_REGISTER);
     
     #else
     #error You need to specify the operation mode of the LCD. Choose between 8 bit and 4 bit modes in "lcd_config.h"
 	
 	#endif
+	
+	lcd_cursor_track(lcd_command);
+	
+	return return_error;
 }
 
 /*********************************************************************************************************************
@@ -170,18 +592,122 @@ lcd_std_error_type_t lcd_command_send(lcd_command_t lcd_command)
 *********************************************************************************************************************/
 void lcd_character_write(uint8_t data_character)
 {
+	lcd_cursor_t* cursor = &g_lcd_cursors[g_lcd_selected_display];
+	
+	#if   (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+	lcd_async_enqueue(LCD_ASYNC_DATA_ITEM, data_character);
+	
 	/* For 8 bit LCD operation: */
-	#if   (LCD_8BIT_OPERATION == LCD_MODE)
-	lcd_8bit_character_write(data_character);
+	#elif (LCD_8BIT_OPERATION == LCD_MODE)
+	lcd_8bit_transfer(data_character, LCD_DATA_REGISTER);
 	
 	#elif (LCD_4BIT_OPERATION == LCD_MODE)
-	lcd_4bit_character_write(data_character);
+	lcd_4bit_transfer(data_character, LCD_DATA_REGISTER);
 	
 	#else
 	#error You need to specify the operation mode of the LCD. Choose between 8 bit and 4 bit modes in "lcd_config.h"
 	
 	#endif
+	
+	/* The LCD moves its address counter after each character: */
+	if (cursor->known)
+	{
+		if ((0 == cursor->entry_decrement) && (LCD_COLUMNS > cursor->x))
+		{
+			cursor->x++;
+		}
+		else
+		{
+			cursor->known = 0;
+		}
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_string_write
+*
+** Description:
+*  This function writes a NULL terminated string on the LCD starting at the current cursor location. When the cursor
+*  location is known, the string wraps to the start of the next line after the last column.
+*
+** Input Parameters:
+*  - string: const char*
+*    The string to be written.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_string_write(const char* string)
+{
+	while (0 != *string)
+	{
+		lcd_wrapped_character_write((uint8_t)*string);
+		string++;
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_buffer_write
+*
+** Description:
+*  This function writes a number of characters on the LCD starting at a certain location. The characters wrap to the
+*  start of the next line after the last column, and from the last line to the first line.
+*
+** Input Parameters:
+*  - x: uint8_t
+*    The character column number of the first character.
+*  - y: uint8_t
+*    The character line number of the first character.
+*  - buffer: const uint8_t*
+*    The characters to be written.
+*  - length: uint8_t
+*    The number of characters to be written.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for correct character coordinates, and 'LCD_NOT_OK' if the x or y coordinates is wrong.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_buffer_write(uint8_t x, uint8_t y, const uint8_t* buffer, uint8_t length)
+{
+	lcd_std_error_type_t return_error = lcd_gotoxy(x, y);
+	
+	if (LCD_OK == return_error)
+	{
+		for (uint8_t i = 0; i < length; i++)
+		{
+			lcd_wrapped_character_write(buffer[i]);
+		}
+	}
+	
+	return return_error;
+}
 
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_transfers_pending_check
+*
+** Description:
+*  This function checks whether the asynchronous engine still has transfers to send to the LCD.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 while transfers are queued or in progress, and 0 when the LCD is idle. It always returns 0 with the
+*    blocking transfers.
+*********************************************************************************************************************/
+uint8_t lcd_transfers_pending_check(void)
+{
+	uint8_t transfers_pending = 0;
+	
+	#if (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+	transfers_pending = ((g_lcd_async_queue_head != g_lcd_async_queue_tail) || (LCD_ASYNC_IDLE != g_lcd_async_state));
+	#endif
+	
+	return transfers_pending;
 }
 
 /*********************************************************************************************************************
@@ -196,7 +722,9 @@ void lcd_character_write(uint8_t data_character)
 *  - int_number: uint32_t
 *    The number that is required to be converted to a string.
 *  - number_of_digits: uint8_t
-*    This is the number of digits of the previous number that you want to convert.
+*    This is the number of digits of the previous number that you want to convert. Shorter numbers are padded with
+*    leading zeros, and longer numbers keep their last digits only. Pass "LCD_INT_DIGITS_AUTO" to convert all the
+*    digits of the number without any leading zeros.
 *  - coversion_string: char*
 *    This is a pointer to the string the will store the conversion result. Note that the size of the string need to
 *    consider the NULL character that will be added by the function at the end of the converted string.
@@ -206,12 +734,32 @@ void lcd_character_write(uint8_t data_character)
 *********************************************************************************************************************/
 void lcd_int_to_string(uint32_t int_number, uint8_t number_of_digits, char* conversion_string)
 {
-	uint8_t digit;
-	for(int8_t i=(number_of_digits-1); i>=0; i--)
+	char digits[FMT_UINT32_MAX_DIGITS];
+	uint8_t digit_count = fmt_decimal_digits_convert(int_number, digits);
+	uint8_t digits_index = 0;
+	
+	if (LCD_INT_DIGITS_AUTO == number_of_digits)
+	{
+		number_of_digits = digit_count;
+	}
+	
+	if (digit_count > number_of_digits)
 	{
-		digit = int_number%10;
-		int_number = int_number/10;
-		conversion_string[i] = digit + 48; /* 48 is the decimal value of ASCII '0' */
+		/* Keep the last digits only: */
+		digits_index = digit_count - number_of_digits;
+	}
+	
+	for (uint8_t i = 0; i < number_of_digits; i++)
+	{
+		if ((number_of_digits - i) > digit_count)
+		{
+			conversion_string[i] = '0';
+		}
+		else
+		{
+			conversion_string[i] = digits[digits_index];
+			digits_index++;
+		}
 	}
 	
 	conversion_string[number_of_digits]=0; /* Append '\0' to  the string */
@@ -231,31 +779,51 @@ void lcd_int_to_string(uint32_t int_number, uint8_t number_of_digits, char* conv
 *  - void
 *
 ** Return Value:
-*  - void 
+*  - lcd_std_error_type_t
+*    Returns LCD_NOT_OK if the TWI driver of the I2C expander can't be started, and LCD_OK otherwise.
 *********************************************************************************************************************/
-static void lcd_4bit_init(void)
+static lcd_std_error_type_t lcd_4bit_init(void)
 {
-	_delay_ms(15);
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	if (LCD_OK != lcd_expander_init())
+	{
+		return LCD_NOT_OK;
+	}
+	
+	#else
 	/* Configure data pins: */
-	gpio_pins_config(LCD_DATA_PORT, ((1<<LCD_D7)|(1<<LCD_D6)|(1<<LCD_D5)|(1<<LCD_D4)), GPIO_OUTPUT, 0x00);
+	LCD_PINS_CONFIG(LCD_DATA_PORT, LCD_4BIT_DATA_PINS, GPIO_OUTPUT, 0x00);
 	/* Configure control pins: */
-	gpio_pin_config(LCD_RS_CNTRL_PORT, LCD_RS, GPIO_OUTPUT, GPIO_PIN_LOW);
-    gpio_pin_config(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_OUTPUT, GPIO_PIN_LOW);
-	gpio_pin_config(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_OUTPUT, GPIO_PIN_LOW);
-	lcd_command_send(0x33); 
-	_delay_us(100);
-	lcd_command_send(0x32); //for 4-bit mode
-	_delay_us(100);
+	LCD_PIN_CONFIG(LCD_RS_CNTRL_PORT, LCD_RS, GPIO_OUTPUT, GPIO_PIN_LOW);
+    LCD_PIN_CONFIG(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_OUTPUT, GPIO_PIN_LOW);
+	LCD_PIN_CONFIG(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_OUTPUT, GPIO_PIN_LOW);
+	#if (1U < LCD_DISPLAY_COUNT)
+	LCD_PIN_CONFIG(LCD_EN2_CNTRL_PORT, LCD_EN2, GPIO_OUTPUT, GPIO_PIN_LOW);
+	#endif
+	#if (2U < LCD_DISPLAY_COUNT)
+	LCD_PIN_CONFIG(LCD_EN3_CNTRL_PORT, LCD_EN3, GPIO_OUTPUT, GPIO_PIN_LOW);
+	#endif
+	
+	#endif
+	lcd_power_on_wait();
+	/* Only the high nibble of each wake-up instruction is sent, the last one switches the LCD to 4 bit mode: */
+	lcd_wakeup_instruction_send(LCD_WAKEUP_INSTRUCTION, LCD_WAKEUP_FIRST_WAIT_US);
+	lcd_wakeup_instruction_send(LCD_WAKEUP_INSTRUCTION, LCD_WAKEUP_WAIT_US);
+	lcd_wakeup_instruction_send(LCD_WAKEUP_INSTRUCTION, LCD_WAKEUP_WAIT_US);
+	lcd_wakeup_instruction_send(LCD_4BIT_INTERFACE_INSTRUCTION, LCD_WAKEUP_WAIT_US);
+	/* Note: Each transfer starts by waiting for the previous command, so no delays are needed between commands. */
 	lcd_command_send(0x28); //for 4-bit mode
-	_delay_us(100);
+	#if (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE)
+	g_lcd_busy_flag_usable = 1;
+	#endif
 	lcd_command_send(0x0E); //display on, cursor on.
-	_delay_us(100);
 	lcd_command_send(0x06); //No shift and auto increment right
-	_delay_us(100);
 	lcd_command_send(0x01); //clear lcd
-	_delay_us(1500); /* This is necessary for the LCD to work correctly.*/
+	
+	return LCD_OK;
 }
 
+#if (LCD_PCF8574_BACKEND != LCD_PIN_BACKEND)
 /*********************************************************************************************************************
 ** Function Name:
 *  lcd_8bit_init
@@ -272,150 +840,1002 @@ static void lcd_4bit_init(void)
 *********************************************************************************************************************/
 static void lcd_8bit_init(void)
 {
-	_delay_ms(15);
 	/* Configuring data pins as output: */
-	gpio_port_config(LCD_DATA_PORT, GPIO_OUTPUT, 0x00);
+	LCD_PINS_CONFIG(LCD_DATA_PORT, LCD_8BIT_DATA_PINS, GPIO_OUTPUT, 0x00);
 	/* Configuring control pins as output: */
-	gpio_pin_config(LCD_RS_CNTRL_PORT, LCD_RS, GPIO_OUTPUT, GPIO_PIN_LOW);
-	gpio_pin_config(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_OUTPUT, GPIO_PIN_LOW);
-	gpio_pin_config(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_OUTPUT, GPIO_PIN_LOW);
+	LCD_PIN_CONFIG(LCD_RS_CNTRL_PORT, LCD_RS, GPIO_OUTPUT, GPIO_PIN_LOW);
+	LCD_PIN_CONFIG(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_OUTPUT, GPIO_PIN_LOW);
+	LCD_PIN_CONFIG(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_OUTPUT, GPIO_PIN_LOW);
+	#if (1U < LCD_DISPLAY_COUNT)
+	LCD_PIN_CONFIG(LCD_EN2_CNTRL_PORT, LCD_EN2, GPIO_OUTPUT, GPIO_PIN_LOW);
+	#endif
+	#if (2U < LCD_DISPLAY_COUNT)
+	LCD_PIN_CONFIG(LCD_EN3_CNTRL_PORT, LCD_EN3, GPIO_OUTPUT, GPIO_PIN_LOW);
+	#endif
+	lcd_power_on_wait();
+	lcd_wakeup_instruction_send(LCD_WAKEUP_INSTRUCTION, LCD_WAKEUP_FIRST_WAIT_US);
+	lcd_wakeup_instruction_send(LCD_WAKEUP_INSTRUCTION, LCD_WAKEUP_WAIT_US);
+	lcd_wakeup_instruction_send(LCD_WAKEUP_INSTRUCTION, LCD_WAKEUP_WAIT_US);
 
+	/* Note: Each transfer starts by waiting for the previous command, so no delays are needed between commands. */
 	lcd_command_send(0x38); 
-	_delay_us(100);
+	#if (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE)
+	g_lcd_busy_flag_usable = 1;
+	#endif
 	lcd_command_send(0x0E); //display on, cursor on.
-	_delay_us(100);
 	lcd_command_send(0x06); //No shift and auto increment right
-	_delay_us(100);
 	lcd_command_send(0x01); //clear lcd
-	_delay_us(1500); /* This is necessary for the LCD to work correctly.*/
-	
-
 }
+#endif
 
 /*********************************************************************************************************************
 ** Function Name:
-*  lcd_8bit_command_send
+*  lcd_power_on_wait
 *
 ** Description:
-*  This function is used when the LCD is configured to work in 8 bit mode to send a command to the LCD.
+*  This function waits for the LCD power-on reset before the first instruction, and starts a new initialization trace.
+*  The full power-on delay is always waited, even with the busy flag polling, since the interface mode of the LCD is
+*  unknown until the function set command. With the asynchronous transfers, the wait is queued like the commands, so
+*  the function returns immediately.
 *
 ** Input Parameters:
-*  - lcd_command: lcd_command_t
-*    Passed the desired command to the LCD.
+*  - void
 *
 ** Return Value:
 *  - void
 *
 *********************************************************************************************************************/
-static void lcd_8bit_command_send(lcd_command_t lcd_command)
+static void lcd_power_on_wait(void)
 {
-	/* For 8 bit LCD operation: */
-	gpio_port_write(LCD_DATA_PORT, lcd_command);
+	g_lcd_init_trace.power_on_wait_us = 0;
+	g_lcd_init_trace.wakeup_wait_us = 0;
+	g_lcd_init_trace.busy_flag_usable = 0;
+	
+	#if (0U < LCD_POWER_ON_DELAY_US)
+	
+	#if   (LCD_BLOCKING_TRANSFERS == LCD_TRANSFER_MODE)
+	/* The busy flag isn't polled here. Before the function set command, a 4 bit read can leave the LCD out of step
+	   with the nibbles, and a display still in its reset may not drive the data pins at all: */
+	_delay_us(LCD_POWER_ON_DELAY_US);
+	g_lcd_init_trace.power_on_wait_us = LCD_POWER_ON_DELAY_US;
+	
+	#elif (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+	uint16_t remaining_ticks = LCD_ASYNC_POWER_ON_TICKS;
+	
+	while (LCD_ASYNC_MAX_DELAY_TICKS < remaining_ticks)
+	{
+		lcd_async_enqueue(LCD_ASYNC_DELAY_ITEM, LCD_ASYNC_MAX_DELAY_TICKS);
+		remaining_ticks -= LCD_ASYNC_MAX_DELAY_TICKS;
+	}
+	lcd_async_enqueue(LCD_ASYNC_DELAY_ITEM, (uint8_t)remaining_ticks);
+	g_lcd_init_trace.power_on_wait_us = LCD_ASYNC_POWER_ON_TICKS * LCD_ASYNC_TICK_US;
 	
-	gpio_pin_write(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_PIN_LOW);
-	gpio_pin_write(LCD_RS_CNTRL_PORT, LCD_RS, GPIO_PIN_LOW);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_HIGH);
-	_delay_us(40);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_LOW);
-	_delay_us(100);
+	#endif
+	
+	#endif
 }
 
-
 /*********************************************************************************************************************
 ** Function Name:
-*  lcd_4bit_command_send
+*  lcd_wakeup_instruction_send
 *
 ** Description:
-*  This function is used when the LCD is configured to work in 4 bit mode to send a command to the LCD.
+*  This function sends one instruction of the wake-up sequence and waits for it. The interface mode of the LCD isn't
+*  known yet, so the instruction is written once, only its high nibble in 4 bit mode, and the busy flag can't be used.
+*  With the asynchronous transfers, the write and the wait are queued.
 *
 ** Input Parameters:
-*  - lcd_command: lcd_command_t
-*    Passes the desired command to the function.
+*  - instruction: uint8_t
+*    'LCD_WAKEUP_INSTRUCTION' or 'LCD_4BIT_INTERFACE_INSTRUCTION'.
+*  - wait_us: uint16_t
+*    The time to wait after the instruction in microseconds, a multiple of LCD_WAKEUP_WAIT_US.
 *
 ** Return Value:
 *  - void
 *
 *********************************************************************************************************************/
-static void lcd_4bit_command_send(lcd_command_t lcd_command)
+static void lcd_wakeup_instruction_send(uint8_t instruction, uint16_t wait_us)
 {
-	/* Sending the first 4 bits (MSB bits) */
-	gpio_pins_write(LCD_DATA_PORT, ((1<<LCD_D7)|(1<<LCD_D6)|(1<<LCD_D5)|(1<<LCD_D4)), ((lcd_command>>HALF_BYTE)<<LCD_D4));
-	gpio_pin_write(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_PIN_LOW);
-	gpio_pin_write(LCD_RS_CNTRL_PORT, LCD_RS, GPIO_PIN_LOW);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_HIGH);	/* Start of a pulse on the Enable pin: */
-	_delay_us(40);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_LOW);  	/* End of the pulse on the Enable pin */
+	#if   (LCD_BLOCKING_TRANSFERS == LCD_TRANSFER_MODE)
+	#if   (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	/* The wait starts once the nibble is latched: */
+	lcd_expander_write(instruction, LCD_COMMAND_REGISTER, 1U);
+	lcd_expander_drain();
+	#elif (LCD_8BIT_OPERATION == LCD_MODE)
+	lcd_bus_setup(instruction, LCD_COMMAND_REGISTER);
+	lcd_enable_pulse();
+	#elif (LCD_4BIT_OPERATION == LCD_MODE)
+	lcd_bus_setup((instruction>>HALF_BYTE), LCD_COMMAND_REGISTER);
+	lcd_enable_pulse();
+	#endif
 	
-	_delay_us(100);
+	/* _delay_us() needs a constant: */
+	for (uint16_t waited_us = 0; waited_us < wait_us; waited_us += LCD_WAKEUP_WAIT_US)
+	{
+		_delay_us(LCD_WAKEUP_WAIT_US);
+	}
+	
+	#elif (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+	lcd_async_enqueue(LCD_ASYNC_WAKEUP_ITEM, instruction);
+	lcd_async_enqueue(LCD_ASYNC_DELAY_ITEM, (uint8_t)LCD_ASYNC_TICKS(wait_us));
+	
+	#endif
 	
-	/* Sending the last 4 bits (LSB bits): */
-	gpio_pins_write(LCD_DATA_PORT, ((1<<LCD_D7)|(1<<LCD_D6)|(1<<LCD_D5)|(1<<LCD_D4)), (lcd_command << LCD_D4)); 
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_HIGH);	/* Start of a pulse on the Enable pin: */
-	_delay_us(40);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_LOW);  	/* End of the pulse on the Enable pin */
+	g_lcd_init_trace.wakeup_wait_us += wait_us;
 }
 
+#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
 /*********************************************************************************************************************
 ** Function Name:
-*  lcd_8bit_character_write
+*  lcd_expander_init
 *
 ** Description:
-*  This function is used when the LCD is configured to work in 8 bit mode to write a character to the LCD.
+*  This function starts the TWI driver for the I2C expander, unless the application already started it for its other
+*  slaves, and drives the enable pin low with the backlight on. The expander starts with all its outputs high, so the
+*  enable pin falls first with RS and RW still high, which the LCD takes as a harmless read, and RS and RW follow it
+*  in the next byte.
 *
 ** Input Parameters:
-*  - data_character: uint8_t
-*    ASCII decimal value of the desired character.
+*  - void
 *
 ** Return Value:
-*  - void
+*  - lcd_std_error_type_t
+*    Returns LCD_NOT_OK if LCD_I2C_SCL_FREQ can't be generated from F_CPU, and LCD_OK otherwise.
 *
 *********************************************************************************************************************/
-static void lcd_8bit_character_write(uint8_t data_character)
+static lcd_std_error_type_t lcd_expander_init(void)
 {
-	gpio_port_write(LCD_DATA_PORT, data_character);
-	gpio_pin_write(LCD_RS_CNTRL_PORT, LCD_RS, GPIO_PIN_HIGH);
-	gpio_pin_write(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_PIN_LOW);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_HIGH);
-	_delay_us(40);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_LOW);
-	_delay_us(100);
+	g_lcd_expander_transaction.slave_address = LCD_I2C_ADDRESS;
+	g_lcd_expander_transaction.read_length = 0;
+	g_lcd_expander_transaction.complete_callback = lcd_expander_transaction_complete;
+	/* Starting the TWI driver again would drop the transactions of the other slaves, queued or on the bus: */
+	if (!(TWCR & (1<<TWEN)))
+	{
+		if (TWI_E_OK != twi_master_init(LCD_I2C_SCL_FREQ, F_CPU))
+		{
+			return LCD_NOT_OK;
+		}
+	}
+	
+	lcd_expander_drain();
+	g_lcd_expander_buffers[g_lcd_expander_fill_buffer][0] = (uint8_t)~LCD_EXPANDER_EN;
+	g_lcd_expander_buffers[g_lcd_expander_fill_buffer][1] = LCD_EXPANDER_BACKLIGHT;
+	g_lcd_expander_fill_length = 2;
+	g_lcd_expander_register_select = 0;
+	lcd_expander_drain();
+	
+	return LCD_OK;
 }
 
 /*********************************************************************************************************************
 ** Function Name:
-*  lcd_4bit_character_write
+*  lcd_expander_write
 *
 ** Description:
-*  This function is used when the LCD is configured to work in 4 bit mode to write a character to the LCD.
+*  This function adds the expander bytes of a command or a character to the buffer, two bytes for each nibble and one
+*  more to set RS when it changes, and sends them at once if the bus is free. Otherwise, they are sent together with the bytes that follow them when the
+*  transaction in progress finishes. The bytes of one call are never split between two transactions.
 *
 ** Input Parameters:
-*  - data_character: uint8_t
-*    ASCII decimal value of the desired character.
+*  - data_byte: uint8_t
+*    The command or the ASCII decimal value of the character.
+*  - register_select: gpio_pin_level_t
+*    'LCD_COMMAND_REGISTER' to send a command, or 'LCD_DATA_REGISTER' to write a character.
+*  - nibbles_count: uint8_t
+*    2 for the whole byte, or 1 for its high nibble only.
 *
 ** Return Value:
 *  - void
 *
 *********************************************************************************************************************/
-static void lcd_4bit_character_write(uint8_t data_character)
+static void lcd_expander_write(uint8_t data_byte, gpio_pin_level_t register_select, uint8_t nibbles_count)
 {
-	/* Sending the first 4 bits (MSB bits) */
-	gpio_pins_write(LCD_DATA_PORT, ((1<<LCD_D7)|(1<<LCD_D6)|(1<<LCD_D5)|(1<<LCD_D4)), ((data_character>>HALF_BYTE)<<LCD_D4));
-	gpio_pin_write(LCD_RS_CNTRL_PORT, LCD_RS, GPIO_PIN_HIGH);
-	gpio_pin_write(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_PIN_LOW);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_HIGH);
-	_delay_us(40);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_LOW);
+	uint8_t bytes_count = nibbles_count * LCD_EXPANDER_BYTES_PER_NIBBLE;
+	uint8_t control_bits = LCD_EXPANDER_BACKLIGHT;
+	uint8_t* buffer;
+	uint8_t sreg_value;
+	
+	if (LCD_DATA_REGISTER == register_select)
+	{
+		control_bits |= LCD_EXPANDER_RS;
+	}
+	if ((control_bits & LCD_EXPANDER_RS) != g_lcd_expander_register_select)
+	{
+		bytes_count++;
+	}
 	
-	_delay_us(100);
+	/* When the buffer is full, the TWI interrupt takes it as soon as the transaction in progress finishes: */
+	while ((LCD_I2C_BUFFER_SIZE - g_lcd_expander_fill_length) < bytes_count)
+	{
+		lcd_expander_buffer_send();
+	}
 	
-	/* Sending the last 4 bits (LSB bits) */
-	gpio_pins_write(LCD_DATA_PORT, ((1<<LCD_D7)|(1<<LCD_D6)|(1<<LCD_D5)|(1<<LCD_D4)), (data_character << LCD_D4));
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_HIGH);	/* Start of a pulse on the Enable pin: */
-	_delay_us(40);
-	gpio_pin_write(LCD_EN_CNTRL_PORT, LCD_EN, GPIO_PIN_LOW);  	/* End of a pulse on the Enable pin: */
+	/* The completion callback swaps the buffers, so the bytes are added with the interrupts disabled: */
+	sreg_value = SREG;
+	cli();
+	buffer = &g_lcd_expander_buffers[g_lcd_expander_fill_buffer][g_lcd_expander_fill_length];
+	if ((control_bits & LCD_EXPANDER_RS) != g_lcd_expander_register_select)
+	{
+		*buffer++ = (data_byte & LCD_EXPANDER_DATA_BITS) | control_bits;
+		g_lcd_expander_register_select = control_bits & LCD_EXPANDER_RS;
+	}
+	for (uint8_t nibble = 0; nibble < nibbles_count; nibble++)
+	{
+		buffer[0] = (data_byte & LCD_EXPANDER_DATA_BITS) | control_bits | LCD_EXPANDER_EN;
+		buffer[1] = (data_byte & LCD_EXPANDER_DATA_BITS) | control_bits;
+		buffer += LCD_EXPANDER_BYTES_PER_NIBBLE;
+		data_byte <<= HALF_BYTE;
+	}
+	g_lcd_expander_fill_length += bytes_count;
+	SREG = sreg_value;
+	
+	lcd_expander_buffer_send();
 }
 
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_expander_buffer_send
+*
+** Description:
+*  This function submits the buffer being filled as one I2C transaction, if it isn't empty and no transaction of the
+*  expander is in progress, and starts filling the other buffer. It is called from the main code and from the
+*  completion callback.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_expander_buffer_send(void)
+{
+	uint8_t sreg_value = SREG;
+	
+	cli();
+	if ((0 == g_lcd_expander_sending) && (0 != g_lcd_expander_fill_length))
+	{
+		g_lcd_expander_transaction.write_buffer = g_lcd_expander_buffers[g_lcd_expander_fill_buffer];
+		g_lcd_expander_transaction.write_length = g_lcd_expander_fill_length;
+		/* If the TWI queue is full, the buffer is submitted by a later call: */
+		if (TWI_E_OK == twi_transaction_submit(&g_lcd_expander_transaction))
+		{
+			g_lcd_expander_sending = 1;
+			g_lcd_expander_fill_buffer ^= 1U;
+			g_lcd_expander_fill_length = 0;
+		}
+	}
+	SREG = sreg_value;
+}
 
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_expander_drain
+*
+** Description:
+*  This function waits until all the expander bytes are sent, before the waits that start when an instruction is
+*  latched.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_expander_drain(void)
+{
+	while (g_lcd_expander_sending || (0 != g_lcd_expander_fill_length))
+	{
+		lcd_expander_buffer_send();
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_expander_transaction_complete
+*
+** Description:
+*  This function is called by the TWI interrupt when an expander transaction finishes, and sends the bytes added
+*  meanwhile. A failed transaction isn't repeated, so the LCD functions never hang if the expander doesn't answer.
+*
+** Input Parameters:
+*  - transaction: twi_transaction_t*
+*    The expander transaction.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_expander_transaction_complete(twi_transaction_t* transaction)
+{
+	(void)transaction;
+	g_lcd_expander_sending = 0;
+	lcd_expander_buffer_send();
+}
+
+#else
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_bus_setup
+*
+** Description:
+*  This function sets the register select pin and the data pins, and drives the RW pin low for a write. In 4 bit mode,
+*  only the low 4 bits of data_bits are put on D4-D7, and if all the LCD pins are on one port, they are all written
+*  at once with the enable pin low.
+*
+** Input Parameters:
+*  - data_bits: uint8_t
+*    The byte in 8 bit mode, or the nibble in 4 bit mode.
+*  - register_select: gpio_pin_level_t
+*    'LCD_COMMAND_REGISTER' to send a command, or 'LCD_DATA_REGISTER' to write a character.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_bus_setup(uint8_t data_bits, gpio_pin_level_t register_select)
+{
+	#if   (LCD_8BIT_OPERATION == LCD_MODE)
+	LCD_PORT_WRITE(LCD_DATA_PORT, data_bits);
+	
+	#elif (LCD_4BIT_OPERATION == LCD_MODE)
+	if (LCD_SINGLE_PORT_WIRING)
+	{
+		/* One port write for the nibble, RS, RW low and EN low: */
+		LCD_PINS_WRITE(LCD_DATA_PORT, (LCD_4BIT_DATA_PINS | LCD_CONTROL_PINS),
+		                (((data_bits << LCD_D4) & LCD_4BIT_DATA_PINS) | (register_select << LCD_RS)));
+		return;
+	}
+	LCD_PINS_WRITE(LCD_DATA_PORT, LCD_4BIT_DATA_PINS, (data_bits << LCD_D4));
+	
+	#endif
+	LCD_PIN_WRITE(LCD_RS_CNTRL_PORT, LCD_RS, register_select);
+	LCD_PIN_WRITE(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_PIN_LOW);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_enable_set
+*
+** Description:
+*  This function drives the enable pins of the selected displays. The LCD latches the data pins on the falling edge.
+*
+** Input Parameters:
+*  - enable_level: gpio_pin_level_t
+*    'GPIO_PIN_HIGH' or 'GPIO_PIN_LOW'.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_enable_set(gpio_pin_level_t enable_level)
+{
+	#if (1U == LCD_DISPLAY_COUNT)
+	LCD_PIN_WRITE(LCD_EN_CNTRL_PORT, LCD_EN, enable_level);
+	
+	#else
+	if (g_lcd_enable_mask & LCD_DISPLAY_MASK(0))
+	{
+		LCD_PIN_WRITE(LCD_EN_CNTRL_PORT, LCD_EN, enable_level);
+	}
+	if (g_lcd_enable_mask & LCD_DISPLAY_MASK(1))
+	{
+		LCD_PIN_WRITE(LCD_EN2_CNTRL_PORT, LCD_EN2, enable_level);
+	}
+	#if (2U < LCD_DISPLAY_COUNT)
+	if (g_lcd_enable_mask & LCD_DISPLAY_MASK(2))
+	{
+		LCD_PIN_WRITE(LCD_EN3_CNTRL_PORT, LCD_EN3, enable_level);
+	}
+	#endif
+	
+	#endif
+}
+#endif /* LCD_PCF8574_BACKEND */
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_cursor_track
+*
+** Description:
+*  This function updates the tracked cursor location after a command. Clear display and return home move the cursor
+*  to the first character, the entry mode decides whether the cursor moves right, and the display control and
+*  function set commands don't move it. Any other command makes the location unknown.
+*
+** Input Parameters:
+*  - lcd_command: uint8_t
+*    The command sent to the LCD.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_cursor_track(uint8_t lcd_command)
+{
+	lcd_cursor_t* cursor = &g_lcd_cursors[g_lcd_selected_display];
+	
+	if ((LCD_CLEAR_DISPLAY_COMMAND == lcd_command) || (LCD_RETURN_HOME_COMMAND == (lcd_command & LCD_RETURN_HOME_COMMAND_MASK)))
+	{
+		cursor->x = 0;
+		cursor->y = 0;
+		cursor->known = 1;
+	}
+	else if (LCD_ENTRY_MODE_COMMAND == (lcd_command & LCD_ENTRY_MODE_COMMAND_MASK))
+	{
+		cursor->entry_decrement = (0 == (lcd_command & LCD_ENTRY_MODE_INCREMENT));
+	}
+	else if ((LCD_DISPLAY_CONTROL_COMMAND == (lcd_command & LCD_DISPLAY_CONTROL_COMMAND_MASK)) ||
+	         (LCD_FUNCTION_SET_COMMAND == (lcd_command & LCD_FUNCTION_SET_COMMAND_MASK)))
+	{
+		/* The address counter isn't changed. */
+	}
+	else
+	{
+		cursor->known = 0;
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_wrapped_character_write
+*
+** Description:
+*  This function writes a character on the LCD. If the last column of a line was just written, it moves the cursor to
+*  the start of the next line first, because the LCD lines don't follow each other in the LCD memory.
+*
+** Input Parameters:
+*  - data_character: uint8_t
+*    This is the ASCII decimal value of the character.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_wrapped_character_write(uint8_t data_character)
+{
+	lcd_cursor_t* cursor = &g_lcd_cursors[g_lcd_selected_display];
+	uint8_t next_line;
+	
+	if (cursor->known && (LCD_COLUMNS == cursor->x))
+	{
+		next_line = cursor->y + 1;
+		if (LCD_ROWS == next_line)
+		{
+			next_line = 0;
+		}
+		(void)lcd_gotoxy(0, next_line);
+	}
+	lcd_character_write(data_character);
+}
+
+#if (LCD_BLOCKING_TRANSFERS == LCD_TRANSFER_MODE)
+#if (LCD_PCF8574_BACKEND != LCD_PIN_BACKEND)
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_8bit_transfer
+*
+** Description:
+*  This function is used when the LCD is configured to work in 8 bit mode to send a command or a character to the LCD.
+*  It waits for the previous instruction to finish before the transfer, so it returns as soon as the byte is latched.
+*
+** Input Parameters:
+*  - data_byte: uint8_t
+*    The command or the ASCII decimal value of the character.
+*  - register_select: gpio_pin_level_t
+*    'LCD_COMMAND_REGISTER' to send a command, or 'LCD_DATA_REGISTER' to write a character.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_8bit_transfer(uint8_t data_byte, gpio_pin_level_t register_select)
+{
+	lcd_ready_wait();
+	
+	lcd_bus_setup(data_byte, register_select);
+	lcd_enable_pulse();
+	
+	lcd_pending_waits_start(data_byte, register_select);
+}
+#endif
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_4bit_transfer
+*
+** Description:
+*  This function is used when the LCD is configured to work in 4 bit mode to send a command or a character to the LCD.
+*  It waits for the previous instruction to finish before the transfer, so it returns as soon as the byte is latched.
+*
+** Input Parameters:
+*  - data_byte: uint8_t
+*    The command or the ASCII decimal value of the character.
+*  - register_select: gpio_pin_level_t
+*    'LCD_COMMAND_REGISTER' to send a command, or 'LCD_DATA_REGISTER' to write a character.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_4bit_transfer(uint8_t data_byte, gpio_pin_level_t register_select)
+{
+	lcd_ready_wait();
+	
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	/* Both nibbles with their enable pulses, 4 expander bytes, go in one I2C transaction: */
+	lcd_expander_write(data_byte, register_select, 2U);
+	
+	#else
+	/* Sending the first 4 bits (MSB bits) */
+	lcd_bus_setup((data_byte>>HALF_BYTE), register_select);
+	lcd_enable_pulse();
+	
+	_delay_us(LCD_NIBBLES_GAP_US);
+	
+	/* Sending the last 4 bits (LSB bits) */
+	lcd_bus_setup(data_byte, register_select);
+	lcd_enable_pulse();
+	
+	#endif
+	
+	lcd_pending_waits_start(data_byte, register_select);
+}
+
+#if (LCD_PCF8574_BACKEND != LCD_PIN_BACKEND)
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_enable_pulse
+*
+** Description:
+*  This function generates a pulse on the enable pin. The LCD latches the data pins on the falling edge.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_enable_pulse(void)
+{
+	lcd_enable_set(GPIO_PIN_HIGH);	/* Start of a pulse on the Enable pin: */
+	_delay_us(LCD_ENABLE_PULSE_WIDTH_US);
+	lcd_enable_set(GPIO_PIN_LOW);  	/* End of the pulse on the Enable pin */
+}
+#endif
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_ready_wait
+*
+** Description:
+*  This function waits until the selected displays finish their previous instruction. It polls the busy flag when it
+*  is enabled and usable, otherwise it waits what remains of the worst case execution time of the previous
+*  instruction, after the time taken by the transfers to the other displays since then.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_ready_wait(void)
+{
+	uint16_t wait_us = 0;
+	uint16_t waited_us = 0;
+	
+	#if (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE)
+	if (g_lcd_busy_flag_usable)
+	{
+		if (LCD_OK == lcd_displays_ready_poll(LCD_BUSY_FLAG_TIMEOUT_US, &waited_us))
+		{
+			lcd_pending_waits_elapse(waited_us, g_lcd_enable_mask);
+			return;
+		}
+		/* The LCD didn't answer, the RW pin is probably not connected. Use the fixed delays from now on. With RW tied
+		   to ground, each poll wrote the pulled-up data pins as a set DDRAM address instruction, so the last one is
+		   waited for and the cursor locations aren't known anymore: */
+		g_lcd_busy_flag_usable = 0;
+		lcd_pending_waits_elapse(waited_us, 0);
+		waited_us = 0;
+		for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+		{
+			if (g_lcd_enable_mask & LCD_DISPLAY_MASK(display))
+			{
+				g_lcd_pending_wait_us[display] = LCD_SHORT_EXECUTION_TIME_US;
+				g_lcd_cursors[display].known = 0;
+			}
+		}
+	}
+	#endif
+	
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		if ((g_lcd_enable_mask & LCD_DISPLAY_MASK(display)) && (g_lcd_pending_wait_us[display] > wait_us))
+		{
+			wait_us = g_lcd_pending_wait_us[display];
+		}
+	}
+	
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	/* The wait starts once the bytes of the last instruction are on the bus: */
+	if (0 != wait_us)
+	{
+		lcd_expander_drain();
+	}
+	#endif
+	
+	while (waited_us < wait_us)
+	{
+		_delay_us(LCD_WAIT_STEP_US);
+		waited_us += LCD_WAIT_STEP_US;
+	}
+	lcd_pending_waits_elapse(waited_us, g_lcd_enable_mask);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_pending_waits_start
+*
+** Description:
+*  This function records the execution time of the instruction just sent to the selected displays, and takes the
+*  time of the transfer off the instructions of the other displays.
+*
+** Input Parameters:
+*  - data_byte: uint8_t
+*    The command or the character just sent.
+*  - register_select: gpio_pin_level_t
+*    'LCD_COMMAND_REGISTER' or 'LCD_DATA_REGISTER'.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_pending_waits_start(uint8_t data_byte, gpio_pin_level_t register_select)
+{
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	/* The expander bytes of the next transfer take longer on the bus than a short instruction takes to execute: */
+	uint16_t pending_wait_us = 0;
+	#else
+	uint16_t pending_wait_us = LCD_WAIT_BEFORE_LATCH_US(LCD_SHORT_EXECUTION_TIME_US);
+	#endif
+	
+	if ((LCD_COMMAND_REGISTER == register_select) && (LCD_LONG_COMMAND_MAX >= data_byte))
+	{
+		#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+		/* The expander bytes may still be queued, the wait starts only after they are drained: */
+		pending_wait_us = LCD_LONG_EXECUTION_TIME_US;
+		#else
+		pending_wait_us = LCD_WAIT_BEFORE_LATCH_US(LCD_LONG_EXECUTION_TIME_US);
+		#endif
+	}
+	
+	/* The transfer took its time off the instructions of the other displays: */
+	lcd_pending_waits_elapse(LCD_TRANSFER_MIN_TIME_US, 0);
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		if (g_lcd_enable_mask & LCD_DISPLAY_MASK(display))
+		{
+			g_lcd_pending_wait_us[display] = pending_wait_us;
+		}
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_pending_waits_elapse
+*
+** Description:
+*  This function takes a time that has surely passed off the pending execution times of all the displays.
+*
+** Input Parameters:
+*  - elapsed_us: uint16_t
+*    The time that has passed in microseconds.
+*  - ready_mask: uint8_t
+*    The displays known to be ready, like the ones whose busy flag was read cleared.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_pending_waits_elapse(uint16_t elapsed_us, uint8_t ready_mask)
+{
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		if ((ready_mask & LCD_DISPLAY_MASK(display)) || (g_lcd_pending_wait_us[display] <= elapsed_us))
+		{
+			g_lcd_pending_wait_us[display] = 0;
+		}
+		else
+		{
+			g_lcd_pending_wait_us[display] -= elapsed_us;
+		}
+	}
+}
+
+#if (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE)
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_displays_ready_poll
+*
+** Description:
+*  This function polls the busy flag of each selected display until all of them are ready. Only one display can drive
+*  the data pins at a time, so the displays are polled one by one, sharing the timeout.
+*
+** Input Parameters:
+*  - timeout_us: uint16_t
+*    The longest time to wait for all the displays in microseconds.
+*  - wait_us: uint16_t*
+*    Pointer to the variable that receives the time waited, approximately in microseconds.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if all the displays are ready, and 'LCD_NOT_OK' if the timeout passed.
+*
+*********************************************************************************************************************/
+static lcd_std_error_type_t lcd_displays_ready_poll(uint16_t timeout_us, uint16_t* wait_us)
+{
+	lcd_std_error_type_t return_error = LCD_OK;
+	uint8_t enable_mask = g_lcd_enable_mask;
+	uint16_t display_wait_us;
+	
+	*wait_us = 0;
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		if (enable_mask & LCD_DISPLAY_MASK(display))
+		{
+			g_lcd_enable_mask = LCD_DISPLAY_MASK(display);
+			if (LCD_OK != lcd_busy_flag_poll((timeout_us - *wait_us), &display_wait_us))
+			{
+				return_error = LCD_NOT_OK;
+			}
+			*wait_us += display_wait_us;
+		}
+	}
+	g_lcd_enable_mask = enable_mask;
+	
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_busy_flag_poll
+*
+** Description:
+*  This function reads the busy flag (D7) from the LCD until it is cleared or until the timeout passes. The data pins
+*  are inputs with their pull-ups on while reading, and they are returned to outputs before the function returns.
+*
+** Input Parameters:
+*  - timeout_us: uint16_t
+*    The longest time to wait in microseconds.
+*  - wait_us: uint16_t*
+*    Pointer to the variable that receives the time waited. Each poll takes at least 1 us, so it is the number of
+*    polls, which is a lower bound of the time in microseconds.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the LCD is ready, and 'LCD_NOT_OK' if the timeout passed while the busy flag is still set.
+*
+*********************************************************************************************************************/
+static lcd_std_error_type_t lcd_busy_flag_poll(uint16_t timeout_us, uint16_t* wait_us)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+	gpio_pin_level_t busy_flag = GPIO_PIN_HIGH;
+	uint16_t polls_count = 0;
+	
+	/* Release the data pins before the LCD starts driving them: */
+	#if   (LCD_8BIT_OPERATION == LCD_MODE)
+	LCD_PINS_CONFIG(LCD_DATA_PORT, LCD_8BIT_DATA_PINS, GPIO_INPUT, LCD_DATA_PINS_PULL_UP);
+	#elif (LCD_4BIT_OPERATION == LCD_MODE)
+	LCD_PINS_CONFIG(LCD_DATA_PORT, LCD_4BIT_DATA_PINS, GPIO_INPUT, LCD_DATA_PINS_PULL_UP);
+	#endif
+	LCD_PIN_WRITE(LCD_RS_CNTRL_PORT, LCD_RS, LCD_COMMAND_REGISTER);
+	LCD_PIN_WRITE(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_PIN_HIGH);
+	
+	/* Each poll takes at least 1 us, so the number of polls approximates the timeout in microseconds: */
+	while (polls_count < timeout_us)
+	{
+		polls_count++;
+		lcd_enable_set(GPIO_PIN_HIGH);
+		_delay_us(LCD_ENABLE_PULSE_WIDTH_US);
+		LCD_PIN_READ(LCD_DATA_PORT, LCD_D7, &busy_flag);
+		lcd_enable_set(GPIO_PIN_LOW);
+		
+		#if (LCD_4BIT_OPERATION == LCD_MODE)
+		/* The second read gives the low nibble of the address counter, which isn't needed: */
+		_delay_us(LCD_NIBBLES_GAP_US);
+		lcd_enable_pulse();
+		#endif
+		
+		if (GPIO_PIN_LOW == busy_flag)
+		{
+			return_error = LCD_OK;
+			break;
+		}
+		_delay_us(LCD_NIBBLES_GAP_US);
+	}
+	
+	LCD_PIN_WRITE(LCD_RW_CNTRL_PORT, LCD_RW, GPIO_PIN_LOW);
+	#if   (LCD_8BIT_OPERATION == LCD_MODE)
+	LCD_PINS_CONFIG(LCD_DATA_PORT, LCD_8BIT_DATA_PINS, GPIO_OUTPUT, 0x00);
+	#elif (LCD_4BIT_OPERATION == LCD_MODE)
+	LCD_PINS_CONFIG(LCD_DATA_PORT, LCD_4BIT_DATA_PINS, GPIO_OUTPUT, 0x00);
+	#endif
+	
+	*wait_us = polls_count;
+	return return_error;
+}
+#endif
+
+#endif /* LCD_BLOCKING_TRANSFERS */
+
+#if (LCD_ASYNCHRONOUS_TRANSFERS == LCD_TRANSFER_MODE)
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_async_timer_init
+*
+** Description:
+*  This function configures Timer2 in CTC mode to generate the asynchronous engine ticks. The compare match interrupt
+*  is only enabled while there are transfers queued.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_async_timer_init(void)
+{
+	TCCR2 = (1<<WGM21) | (1<<CS21); /* CTC mode, clock/8. */
+	OCR2  = (uint8_t)LCD_ASYNC_TIMER_COMPARE_VALUE;
+	TCNT2 = 0;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_async_enqueue
+*
+** Description:
+*  This function adds an item to the transfers queue and makes sure the engine is running. If the queue is full, it
+*  waits until the ISR frees a place, so global interrupts need to be enabled. It must not be called from an ISR.
+*
+** Input Parameters:
+*  - item_type: uint8_t
+*    'LCD_ASYNC_COMMAND_ITEM', 'LCD_ASYNC_DATA_ITEM', 'LCD_ASYNC_DELAY_ITEM' or 'LCD_ASYNC_WAKEUP_ITEM'.
+*  - item_value: uint8_t
+*    The command, the character or the number of ticks to wait.
+*
+** Return Value:
+*  - void
+*
+*********************************************************************************************************************/
+static void lcd_async_enqueue(uint8_t item_type, uint8_t item_value)
+{
+	uint8_t next_head = g_lcd_async_queue_head + 1;
+	uint8_t sreg_value;
+	
+	if (LCD_ASYNC_QUEUE_SIZE == next_head)
+	{
+		next_head = 0;
+	}
+	/* Wait for a free place: */
+	while (next_head == g_lcd_async_queue_tail)
+	{
+	}
+	
+	g_lcd_async_queue[g_lcd_async_queue_head] = ((uint16_t)item_type << LCD_ASYNC_ITEM_TYPE_SHIFT) | item_value;
+	g_lcd_async_queue_head = next_head;
+	
+	/* TIMSK is shared with the other timers, so it is modified with the interrupts disabled: */
+	sreg_value = SREG;
+	cli();
+	TIMSK |= (1<<OCIE2);
+	SREG = sreg_value;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  ISR(TIMER2_COMP_vect)
+*
+** Description:
+*  This is the asynchronous engine state machine. Each tick does one step of a transfer: put a byte or a nibble on
+*  the bus and raise the enable pin, lower it to latch, or wait for the LCD to execute the instruction. When the queue
+*  is empty, the interrupt disables itself.
+*
+*********************************************************************************************************************/
+ISR(TIMER2_COMP_vect)
+{
+	uint8_t item_type  = (uint8_t)(g_lcd_async_item >> LCD_ASYNC_ITEM_TYPE_SHIFT);
+	uint8_t item_value = (uint8_t)g_lcd_async_item;
+	gpio_pin_level_t register_select = (LCD_ASYNC_DATA_ITEM == item_type) ? LCD_DATA_REGISTER : LCD_COMMAND_REGISTER;
+	uint8_t queue_tail;
+	
+	switch (g_lcd_async_state)
+	{
+		case LCD_ASYNC_IDLE:
+		queue_tail = g_lcd_async_queue_tail;
+		if (g_lcd_async_queue_head == queue_tail)
+		{
+			TIMSK &= ~(1<<OCIE2);
+			break;
+		}
+		g_lcd_async_item = g_lcd_async_queue[queue_tail];
+		queue_tail++;
+		if (LCD_ASYNC_QUEUE_SIZE == queue_tail)
+		{
+			queue_tail = 0;
+		}
+		g_lcd_async_queue_tail = queue_tail;
+		
+		item_type  = (uint8_t)(g_lcd_async_item >> LCD_ASYNC_ITEM_TYPE_SHIFT);
+		item_value = (uint8_t)g_lcd_async_item;
+		register_select = (LCD_ASYNC_DATA_ITEM == item_type) ? LCD_DATA_REGISTER : LCD_COMMAND_REGISTER;
+		
+		if (LCD_ASYNC_DELAY_ITEM == item_type)
+		{
+			g_lcd_async_wait_ticks = item_value;
+			g_lcd_async_state = LCD_ASYNC_WAIT;
+		}
+		else
+		{
+			#if   (LCD_8BIT_OPERATION == LCD_MODE)
+			lcd_bus_setup(item_value, register_select);
+			lcd_enable_set(GPIO_PIN_HIGH);
+			g_lcd_async_state = LCD_ASYNC_LATCH;
+			
+			#elif (LCD_4BIT_OPERATION == LCD_MODE)
+			lcd_bus_setup((item_value>>HALF_BYTE), register_select);
+			lcd_enable_set(GPIO_PIN_HIGH);
+			/* A wake-up instruction is only its high nibble: */
+			g_lcd_async_state = (LCD_ASYNC_WAKEUP_ITEM == item_type) ? LCD_ASYNC_LATCH : LCD_ASYNC_LOW_NIBBLE;
+			
+			#endif
+		}
+		break;
+		
+		case LCD_ASYNC_LOW_NIBBLE:
+		/* Latch the high nibble and start the low nibble in the same tick: */
+		lcd_enable_set(GPIO_PIN_LOW);
+		lcd_bus_setup(item_value, register_select);
+		_delay_us(LCD_ASYNC_ENABLE_LOW_US);
+		lcd_enable_set(GPIO_PIN_HIGH);
+		g_lcd_async_state = LCD_ASYNC_LATCH;
+		break;
+		
+		case LCD_ASYNC_LATCH:
+		lcd_enable_set(GPIO_PIN_LOW);
+		/* The next item starts on the next tick, which covers the execution time of all but the long commands: */
+		if ((LCD_ASYNC_COMMAND_ITEM == item_type) && (LCD_LONG_COMMAND_MAX >= item_value))
+		{
+			g_lcd_async_wait_ticks = LCD_ASYNC_LONG_COMMAND_TICKS;
+			g_lcd_async_state = LCD_ASYNC_WAIT;
+		}
+		else
+		{
+			g_lcd_async_state = LCD_ASYNC_IDLE;
+		}
+		break;
+		
+		case LCD_ASYNC_WAIT:
+		if (0 != g_lcd_async_wait_ticks)
+		{
+			g_lcd_async_wait_ticks--;
+		}
+		if (0 == g_lcd_async_wait_ticks)
+		{
+			g_lcd_async_state = LCD_ASYNC_IDLE;
+		}
+		break;
+		
+		default:
+		g_lcd_async_state = LCD_ASYNC_IDLE;
+		break;
+	}
+}
+#endif /* LCD_ASYNCHRONOUS_TRANSFERS */
 
 /*********************************************************************************************************************
                                                 << End of File >>
@@ -38,6 +38,10 @@
 /*********************************************************************************************************************
                                                << Public Constants >>
 *********************************************************************************************************************/
+/* Names used by the previous 4 bit LCD driver: */
+#define   lcd_data_send      lcd_character_write
+#define   lcd_print_string   lcd_string_write
+#define   LCD_INT_DIGITS_AUTO   (0U)   /* Makes lcd_int_to_string() convert all the digits of the number. */
 
 
 /*********************************************************************************************************************
@@ -54,6 +58,15 @@ typedef enum
 	LCD_CLEAR_ALL = 0x00,
 } lcd_command_t;
 
+/* What lcd_init() waited for. The times are in microseconds. With the asynchronous transfers, they are the waits
+   queued by lcd_init(), which returns immediately. */
+typedef struct
+{
+	uint16_t power_on_wait_us;         /* Waited for the LCD power-on reset. */
+	uint16_t wakeup_wait_us;           /* Waited during the wake-up sequence, before the function set command. */
+	uint8_t  busy_flag_usable;         /* The transfers poll the busy flag instead of waiting fixed delays. */
+} lcd_init_trace_t;
+
 /*********************************************************************************************************************
                                           << Public Variable Declarations >>
 *********************************************************************************************************************/
@@ -67,22 +80,89 @@ typedef enum
 *  lcd_init
 *
 ** Description:
-*  This function starts the LCD initialization with the certain LCD configurations selected.
+*  This function starts the LCD initialization with the certain LCD configurations selected. All the displays are
+*  initialized together. To shorten the start-up, call it after the other peripherals are initialized, so the
+*  power-on delay set in "lcd_config.h" can be shorter. The busy flag is polled only after the function set command.
+*  With the asynchronous transfers, it returns immediately and the initialization runs in the background while the
+*  other peripherals are initialized.
+*  With the I2C expander, the TWI driver is started at LCD_I2C_SCL_FREQ, unless the application started it before
+*  lcd_init() for its other slaves, in which case its bit rate and queued transactions are kept.
 *
 ** Input Parameters:
 *  - void
 *
 ** Return Value:
+*  - lcd_std_error_type_t
+*    Returns LCD_NOT_OK if the TWI driver of the I2C expander can't be started at LCD_I2C_SCL_FREQ, and LCD_OK
+*    otherwise.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_init(void);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_display_select
+*
+** Description:
+*  This function selects the display that the other LCD functions work on, when more than one display shares the
+*  LCD bus. Switching between displays costs no LCD command, and a display isn't waited for if the other displays
+*  were written since its last instruction, so writing the displays in turns hides their execution times.
+*
+** Input Parameters:
+*  - display: uint8_t
+*    The display number, from 0 to LCD_DISPLAY_COUNT - 1.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for a correct display number, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_display_select(uint8_t display);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_selected_display_get
+*
+** Description:
+*  This function gives the display that the LCD functions work on.
+*
+** Input Parameters:
 *  - void
+*
+** Return Value:
+*  - uint8_t
+*    The selected display number.
 *********************************************************************************************************************/
-extern void lcd_init(void);
+extern uint8_t lcd_selected_display_get(void);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_init_trace_get
+*
+** Description:
+*  This function gives what the last lcd_init() call waited for, to measure the start-up time spent on the LCD.
+*
+** Input Parameters:
+*  - init_trace: lcd_init_trace_t*
+*    Pointer to the structure that receives the trace.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the trace is given, and 'LCD_NOT_OK' for a NULL pointer.
+*
+** Example:
+*  lcd_init_trace_t init_trace;
+*  lcd_init();
+*  lcd_init_trace_get(&init_trace);
+*  fmt_unsigned_write(lcd_character_write, init_trace.power_on_wait_us, 5, FMT_PAD_WITH_SPACES);
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_init_trace_get(lcd_init_trace_t* init_trace);
 
 /*********************************************************************************************************************
 ** Function Name:
 *  lcd_gotoxy
 *
 ** Description:
-*  This function moves the LCD cursor to a certain location based on the passed arguments.
+*  This function moves the LCD cursor to a certain location based on the passed arguments. The driver tracks the
+*  cursor location, so no command is sent if the cursor is already there.
 *
 ** Input Parameters:
 *  - x: uint8_t
@@ -130,6 +210,70 @@ extern lcd_std_error_type_t lcd_command_send(lcd_command_t lcd_command);
 *********************************************************************************************************************/
 extern void lcd_character_write(uint8_t data_character);
 
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_string_write
+*
+** Description:
+*  This function writes a NULL terminated string on the LCD starting at the current cursor location. When the cursor
+*  location is known, the string wraps to the start of the next line after the last column.
+*
+** Input Parameters:
+*  - string: const char*
+*    The string to be written.
+*
+** Return Value:
+*  - void
+*
+** Example:
+*  lcd_gotoxy(0, 0);
+*  lcd_string_write("Temperature: 25C");
+*********************************************************************************************************************/
+extern void lcd_string_write(const char* string);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_buffer_write
+*
+** Description:
+*  This function writes a number of characters on the LCD starting at a certain location. The characters wrap to the
+*  start of the next line after the last column, and from the last line to the first line. A single cursor move is
+*  sent for each line.
+*
+** Input Parameters:
+*  - x: uint8_t
+*    The character column number of the first character.
+*  - y: uint8_t
+*    The character line number of the first character.
+*  - buffer: const uint8_t*
+*    The characters to be written.
+*  - length: uint8_t
+*    The number of characters to be written.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for correct character coordinates, and 'LCD_NOT_OK' if the x or y coordinates is wrong.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_buffer_write(uint8_t x, uint8_t y, const uint8_t* buffer, uint8_t length);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_transfers_pending_check
+*
+** Description:
+*  This function checks whether the asynchronous engine still has transfers to send to the LCD. It can be used to
+*  wait until the LCD is idle, for example before entering a sleep mode.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 while transfers are queued or in progress, and 0 when the LCD is idle. It always returns 0 with the
+*    blocking transfers.
+*********************************************************************************************************************/
+extern uint8_t lcd_transfers_pending_check(void);
+
 /*********************************************************************************************************************
 ** Function Name:
 *  lcd_int_to_string
@@ -142,7 +286,9 @@ extern void lcd_character_write(uint8_t data_character);
 *  - int_number: uint32_t
 *    The number that is required to be converted to a string.
 *  - number_of_digits: uint8_t
-*    This is the number of digits of the previous number that you want to convert.
+*    This is the number of digits of the previous number that you want to convert. Shorter numbers are padded with
+*    leading zeros, and longer numbers keep their last digits only. Pass "LCD_INT_DIGITS_AUTO" to convert all the
+*    digits of the number without any leading zeros.
 *  - coversion_string: char*
 *    This is a pointer to the string the will store the conversion result. Note that the size of the string need to
 *    consider the NULL character that will be added by the function at the end of the converted string.
@@ -155,6 +301,10 @@ extern void lcd_character_write(uint8_t data_character);
 *  char* my_string[6];
 *  lcd_int_to_string(my_num, 5, my_string);
 *  Note: my_string now contains "12345"
+*
+*  char my_string[11];
+*  lcd_int_to_string(my_num, LCD_INT_DIGITS_AUTO, my_string);
+*  Note: my_string now contains "12345"
 *********************************************************************************************************************/
 extern void lcd_int_to_string(uint32_t int_number, uint8_t number_of_digits, char* conversion_string);
 
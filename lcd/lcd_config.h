@@ -42,6 +42,68 @@ required for the initialization and operation of the LCD.
 */
 #define LCD_MODE  LCD_4BIT_OPERATION
 
+/* Choosing how the driver waits for the LCD to finish each command or character
+** Options: 
+*  LCD_FIXED_DELAYS      : Waits the worst case execution time. The RW pin may be tied to ground.
+*  LCD_BUSY_FLAG_POLLING : Reads the busy flag back from the LCD, so each transfer only waits as long as the LCD
+*                          needs. The RW pin needs to be connected.
+*/
+#define LCD_WAIT_MODE  LCD_FIXED_DELAYS
+
+/* Setting the busy flag polling timeout in microseconds. If the busy flag stays set for longer than this, the
+** driver assumes the RW pin isn't connected and uses the fixed delays from then on.
+*/
+#define LCD_BUSY_FLAG_TIMEOUT_US  (2000U)
+
+/* Setting the time the LCD needs after its supply rises before the first instruction, in microseconds (15000 in the
+** HD44780 datasheet). It is counted from lcd_init(), so it can be made shorter or 0 if the microcontroller start-up
+** time and the code that runs before lcd_init() already cover it. It is waited in full with the busy flag polling
+** too.
+*/
+#define LCD_POWER_ON_DELAY_US  (15000U)
+
+/* Choosing how the commands and characters are sent to the LCD
+** Options: 
+*  LCD_BLOCKING_TRANSFERS     : Each function returns after its transfer is done.
+*  LCD_ASYNCHRONOUS_TRANSFERS : Each function adds its transfer to a queue and returns. The transfers are sent in the
+*                               background by the Timer2 compare match interrupt, so Timer2 can't be used for anything
+*                               else, global interrupts need to be enabled, and the LCD functions must not be called
+*                               from an ISR. It needs "LCD_FIXED_DELAYS".
+*                               Note: The ISR writes the LCD pins, so the other pins of the LCD ports should not be
+*                               changed outside an ISR while the transfers are pending.
+*/
+#define LCD_TRANSFER_MODE  LCD_BLOCKING_TRANSFERS
+
+/* Setting the asynchronous transfers queue size (up to 255) and the engine tick in microseconds (at least 40).
+** Note: A character takes 3 ticks in 4 bit mode, and 2 ticks in 8 bit mode.
+*/
+#define LCD_ASYNC_QUEUE_SIZE  (64U)
+#define LCD_ASYNC_TICK_US     (50U)
+
+/* Choosing how the driver accesses the LCD pins
+** Options: 
+*  LCD_GPIO_DRIVER_BACKEND      : Through the GPIO driver functions.
+*  LCD_DIRECT_REGISTERS_BACKEND : Directly through the port registers. Each access compiles to one or a few
+*                                 instructions, and the GPIO driver isn't needed.
+*  LCD_PCF8574_BACKEND          : Through a PCF8574 I2C expander backpack, wired P0=RS, P1=RW, P2=EN, P3=backlight
+*                                 and P4-P7=D4-D7, using the TWI driver. The pin settings below aren't used. Each
+*                                 character is 4 expander bytes, added to a buffer that the TWI interrupt sends, so
+*                                 the functions return before the LCD gets the character. It needs
+*                                 "LCD_4BIT_OPERATION", "LCD_FIXED_DELAYS", "LCD_BLOCKING_TRANSFERS" and a single LCD,
+*                                 and global interrupts need to be enabled before lcd_init().
+*/
+#define LCD_PIN_BACKEND  LCD_DIRECT_REGISTERS_BACKEND
+
+/* Setting the I2C expander address, SCL frequency in HZ (up to 400000) and buffer size in bytes (5 to 255).
+** Note: The PCF8574 answers at 0x20 to 0x27 and the PCF8574A at 0x38 to 0x3F, depending on its A0-A2 pins. Two
+** buffers are used: while one is sent, the bytes written meanwhile fill the other one and are sent together by the
+** next transaction. If the application starts the TWI driver before lcd_init(), for other slaves on the bus, its SCL
+** frequency is kept instead, and it needs to be 400000 at most too.
+*/
+#define LCD_I2C_ADDRESS      (0x27U)
+#define LCD_I2C_SCL_FREQ     (100000UL)
+#define LCD_I2C_BUFFER_SIZE  (32U)
+
 /* Choosing the lcd data port
 ** Options:
 * GPIO_PORTA
@@ -72,6 +134,8 @@ required for the initialization and operation of the LCD.
 * GPIO_PORTB
 * GPIO_PORTC
 * GPIO_PORTD
+* Note: In 4 bit mode, if the data and control pins are all on the same port, the driver writes each nibble together
+* with the control pins in a single port write.
 */
 #define  LCD_RS_CNTRL_PORT  GPIO_PORTB
 #define  LCD_RW_CNTRL_PORT  GPIO_PORTB
@@ -90,6 +154,62 @@ required for the initialization and operation of the LCD.
 #define  LCD_RS	  GPIO_PIN0
 #define  LCD_RW	  GPIO_PIN1
 #define  LCD_EN   GPIO_PIN2
+
+/* Setting the number of displays sharing the data, RS and RW pins (1 to 3). Each display has its own enable pin:
+** display 0 uses LCD_EN, display 1 uses LCD_EN2 and display 2 uses LCD_EN3. Select the display with
+** lcd_display_select(). Only the blocking transfers support more than one display.
+*/
+#define  LCD_DISPLAY_COUNT  (1U)
+
+#define  LCD_EN2_CNTRL_PORT  GPIO_PORTB
+#define  LCD_EN2             GPIO_PIN3
+#define  LCD_EN3_CNTRL_PORT  GPIO_PORTB
+#define  LCD_EN3             GPIO_PIN4
+
+/* Choosing the LCD size (columns x lines)
+** Options:
+*  LCD_16X1
+*  LCD_16X2
+*  LCD_16X4
+*  LCD_20X2
+*  LCD_20X4
+*  LCD_40X2
+*  Note: Some 16x1 LCDs are addressed as two halves of 8 characters. Select LCD_16X2 for them and use lines 0 and 1.
+*  Note: LCD_16X4 is the default because it accepts the same lines 0 to 3 as the driver always did. The line wrapping
+*        and the framebuffer size follow this setting, so select the real size of a smaller LCD.
+*/
+#define  LCD_SIZE  LCD_16X4
+
+
+/* Derived settings, not to be edited: */
+#define  LCD_16X1   (0)
+#define  LCD_16X2   (1)
+#define  LCD_16X4   (2)
+#define  LCD_20X2   (3)
+#define  LCD_20X4   (4)
+#define  LCD_40X2   (5)
+
+#if   (LCD_16X1 == LCD_SIZE)
+#define  LCD_ROWS      (1U)
+#define  LCD_COLUMNS   (16U)
+#elif (LCD_16X2 == LCD_SIZE)
+#define  LCD_ROWS      (2U)
+#define  LCD_COLUMNS   (16U)
+#elif (LCD_16X4 == LCD_SIZE)
+#define  LCD_ROWS      (4U)
+#define  LCD_COLUMNS   (16U)
+#elif (LCD_20X2 == LCD_SIZE)
+#define  LCD_ROWS      (2U)
+#define  LCD_COLUMNS   (20U)
+#elif (LCD_20X4 == LCD_SIZE)
+#define  LCD_ROWS      (4U)
+#define  LCD_COLUMNS   (20U)
+#elif (LCD_40X2 == LCD_SIZE)
+#define  LCD_ROWS      (2U)
+#define  LCD_COLUMNS   (40U)
+#else
+#error You need to specify the size of the LCD. Choose one of the available sizes in "lcd_config.h"
+#endif
 #endif /* LCD_CONFIG_H_ */
 
 
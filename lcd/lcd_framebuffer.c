@@ -0,0 +1,310 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  lcd_framebuffer.c
+*
+** Description:
+*  This file contains the implementation of the LCD framebuffer.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include "lcd_config.h"
+#include <stdint.h>
+#include "lcd.h"
+#include "lcd_framebuffer.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   BLANK_CHARACTER   (' ')
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+/* What the application wants on each screen, blank until it is first written or flushed: */
+static uint8_t g_frame[LCD_DISPLAY_COUNT][LCD_ROWS][LCD_COLUMNS];
+static uint8_t g_frame_valid[LCD_DISPLAY_COUNT];
+/* What each LCD shows, valid only after the first flush: */
+static uint8_t g_shadow[LCD_DISPLAY_COUNT][LCD_ROWS][LCD_COLUMNS];
+static uint8_t g_shadow_valid[LCD_DISPLAY_COUNT];
+
+static uint8_t g_cursor_x[LCD_DISPLAY_COUNT];
+static uint8_t g_cursor_y[LCD_DISPLAY_COUNT];
+
+/*********************************************************************************************************************
+                                          << Public Variable Definitions >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                         << Private Functions Prototypes >>
+*********************************************************************************************************************/
+static void lcd_framebuffer_frame_prepare(uint8_t display);
+
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_clear
+*
+** Description:
+*  This function fills the framebuffer of the selected display with spaces and moves its cursor to the first
+*  character.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_framebuffer_clear(void)
+{
+	uint8_t display = lcd_selected_display_get();
+	
+	g_frame_valid[display] = 0;
+	lcd_framebuffer_frame_prepare(display);
+	g_cursor_x[display] = 0;
+	g_cursor_y[display] = 0;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_character_write
+*
+** Description:
+*  This function writes a character to a certain location in the framebuffer of the selected display.
+*
+** Input Parameters:
+*  - x: uint8_t
+*    The character column number.
+*  - y: uint8_t
+*    The character line number.
+*  - data_character: uint8_t
+*    This is the ASCII decimal value of the character.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for correct character coordinates, and 'LCD_NOT_OK' if the x or y coordinates is wrong.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_framebuffer_character_write(uint8_t x, uint8_t y, uint8_t data_character)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+
+	if ((LCD_COLUMNS > x) && (LCD_ROWS > y))
+	{
+		lcd_framebuffer_frame_prepare(lcd_selected_display_get());
+		g_frame[lcd_selected_display_get()][y][x] = data_character;
+		return_error = LCD_OK;
+	}
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_gotoxy
+*
+** Description:
+*  This function moves the framebuffer cursor.
+*
+** Input Parameters:
+*  - x: uint8_t
+*    The character column number.
+*  - y: uint8_t
+*    The character line number.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for correct character coordinates, and 'LCD_NOT_OK' if the x or y coordinates is wrong.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_framebuffer_gotoxy(uint8_t x, uint8_t y)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+
+	if ((LCD_COLUMNS > x) && (LCD_ROWS > y))
+	{
+		g_cursor_x[lcd_selected_display_get()] = x;
+		g_cursor_y[lcd_selected_display_get()] = y;
+		return_error = LCD_OK;
+	}
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_putc
+*
+** Description:
+*  This function writes a character at the framebuffer cursor and moves the cursor to the right.
+*
+** Input Parameters:
+*  - data_character: uint8_t
+*    This is the ASCII decimal value of the character.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_framebuffer_putc(uint8_t data_character)
+{
+	uint8_t display = lcd_selected_display_get();
+	
+	/* Characters past the end of the line are dropped: */
+	if (LCD_COLUMNS > g_cursor_x[display])
+	{
+		lcd_framebuffer_frame_prepare(display);
+		g_frame[display][g_cursor_y[display]][g_cursor_x[display]] = data_character;
+		g_cursor_x[display]++;
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_string_write
+*
+** Description:
+*  This function writes a NULL terminated string at the framebuffer cursor.
+*
+** Input Parameters:
+*  - string: const char*
+*    The string to be written.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_framebuffer_string_write(const char* string)
+{
+	while ((0 != *string) && (LCD_COLUMNS > g_cursor_x[lcd_selected_display_get()]))
+	{
+		lcd_framebuffer_putc((uint8_t)*string);
+		string++;
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_invalidate
+*
+** Description:
+*  This function marks the shadow copy as unknown, so the next flush redraws the whole screen.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_framebuffer_invalidate(void)
+{
+	g_shadow_valid[lcd_selected_display_get()] = 0;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_flush
+*
+** Description:
+*  This function sends the characters that differ from what the LCDs show, on all the displays.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_framebuffer_flush(void)
+{
+	uint8_t selected_display = lcd_selected_display_get();
+
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		lcd_framebuffer_frame_prepare(display);
+	}
+	for (uint8_t y = 0; y < LCD_ROWS; y++)
+	{
+		for (uint8_t x = 0; x < LCD_COLUMNS; x++)
+		{
+			/* The same location is sent to every display in turn, so each display executes while the others are
+			   written: */
+			for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+			{
+				if ((0 == g_shadow_valid[display]) || (g_frame[display][y][x] != g_shadow[display][y][x]))
+				{
+					(void)lcd_display_select(display);
+					/* No command is sent if the LCD address counter already followed the last written character: */
+					(void)lcd_gotoxy(x, y);
+					lcd_character_write(g_frame[display][y][x]);
+					g_shadow[display][y][x] = g_frame[display][y][x];
+				}
+			}
+		}
+	}
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		g_shadow_valid[display] = 1;
+	}
+	(void)lcd_display_select(selected_display);
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_frame_prepare
+*
+** Description:
+*  This function fills the framebuffer of a display with spaces the first time it is used, so the characters that
+*  were never written show as blanks instead of CGRAM character 0.
+*
+** Input Parameters:
+*  - display: uint8_t
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+static void lcd_framebuffer_frame_prepare(uint8_t display)
+{
+	if (g_frame_valid[display])
+	{
+		return;
+	}
+	
+	for (uint8_t y = 0; y < LCD_ROWS; y++)
+	{
+		for (uint8_t x = 0; x < LCD_COLUMNS; x++)
+		{
+			g_frame[display][y][x] = BLANK_CHARACTER;
+		}
+	}
+	g_frame_valid[display] = 1;
+}
+
+
+/*********************************************************************************************************************
+                                                << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,196 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  lcd_framebuffer.h
+*
+** Description:
+*  This file contains the public programming interfaces for the LCD framebuffer. The application writes to a copy of
+*  the screen in RAM, and lcd_framebuffer_flush() sends only the characters that changed since the last flush, with
+*  one cursor move for each run of changed characters. The size of the screen is set in "lcd_config.h".
+*
+*  When more than one display shares the LCD bus, each display has its own framebuffer. The functions write to the
+*  framebuffer of the display chosen with lcd_display_select(), and lcd_framebuffer_flush() updates all of them.
+*
+*  Note: The framebuffer keeps a shadow copy of what the LCD shows. If the LCD is written directly with lcd.h
+*  functions, call lcd_framebuffer_invalidate() so the next flush redraws the whole screen.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef LCD_FRAMEBUFFER_H_
+#define LCD_FRAMEBUFFER_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "lcd.h"
+
+/*********************************************************************************************************************
+                                               << Public Constants >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                          << Public Variable Declarations >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_clear
+*
+** Description:
+*  This function fills the framebuffer of the selected display with spaces and moves its cursor to the first
+*  character. It needs to be called once for each display after lcd_init() before the framebuffer is used.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void lcd_framebuffer_clear(void);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_character_write
+*
+** Description:
+*  This function writes a character to a certain location in the framebuffer. The LCD isn't accessed.
+*
+** Input Parameters:
+*  - x: uint8_t
+*    The character column number.
+*  - y: uint8_t
+*    The character line number.
+*  - data_character: uint8_t
+*    This is the ASCII decimal value of the character.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for correct character coordinates, and 'LCD_NOT_OK' if the x or y coordinates is wrong.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_framebuffer_character_write(uint8_t x, uint8_t y, uint8_t data_character);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_gotoxy
+*
+** Description:
+*  This function moves the framebuffer cursor used by lcd_framebuffer_putc() and lcd_framebuffer_string_write().
+*
+** Input Parameters:
+*  - x: uint8_t
+*    The character column number.
+*  - y: uint8_t
+*    The character line number.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for correct character coordinates, and 'LCD_NOT_OK' if the x or y coordinates is wrong.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_framebuffer_gotoxy(uint8_t x, uint8_t y);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_putc
+*
+** Description:
+*  This function writes a character at the framebuffer cursor and moves the cursor to the right. Characters past the
+*  end of the line are dropped. Its signature matches fmt_sink_t, so the fmt library can format into the framebuffer.
+*
+** Input Parameters:
+*  - data_character: uint8_t
+*    This is the ASCII decimal value of the character.
+*
+** Return Value:
+*  - void
+*
+** Example:
+*  lcd_framebuffer_gotoxy(0, 1);
+*  fmt_unsigned_write(lcd_framebuffer_putc, adc_value, 4, FMT_PAD_WITH_SPACES);
+*  lcd_framebuffer_flush();
+*********************************************************************************************************************/
+extern void lcd_framebuffer_putc(uint8_t data_character);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_string_write
+*
+** Description:
+*  This function writes a NULL terminated string at the framebuffer cursor. Characters past the end of the line are
+*  dropped.
+*
+** Input Parameters:
+*  - string: const char*
+*    The string to be written.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void lcd_framebuffer_string_write(const char* string);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_invalidate
+*
+** Description:
+*  This function marks the shadow copy of the selected display as unknown, so the next flush redraws its whole
+*  screen.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void lcd_framebuffer_invalidate(void);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_framebuffer_flush
+*
+** Description:
+*  This function sends the characters that differ from what the LCD shows. Each run of adjacent changed characters
+*  costs one cursor move plus one transfer per character, and an unchanged screen costs no LCD access at all. With
+*  more than one display, the changed characters are sent to the displays in turns, so the execution time of each
+*  character is spent writing the other displays. The selected display is kept.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void lcd_framebuffer_flush(void);
+
+
+#endif /* LCD_FRAMEBUFFER_H_ */
+/*********************************************************************************************************************
+                                               << End of File >>
+*********************************************************************************************************************/
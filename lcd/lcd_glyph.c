@@ -0,0 +1,232 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  lcd_glyph.c
+*
+** Description:
+*  This file contains the implementation of the LCD custom glyph manager.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include "lcd_config.h"
+#include <avr/pgmspace.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "lcd.h"
+#include "lcd_glyph.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   LCD_SET_CGRAM_ADDRESS_COMMAND   (0x40U)
+#define   LCD_GLYPH_ADDRESS_SHIFT         (3U)     /* Each slot takes 8 CGRAM bytes. */
+#define   LCD_GLYPH_MAX_AGE               (0xFFU)
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+typedef struct
+{
+	const uint8_t* glyph;           /* The glyph in the slot, or NULL if the slot is free. */
+	uint8_t        age;             /* Frames since the glyph was last acquired, it stops at LCD_GLYPH_MAX_AGE. */
+	uint8_t        upload_pending;  /* The glyph is assigned to the slot but isn't uploaded to the LCD yet. */
+} lcd_glyph_slot_t;
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static lcd_glyph_slot_t g_glyph_slots[LCD_GLYPH_SLOTS_COUNT];
+
+/*********************************************************************************************************************
+                                          << Public Variable Definitions >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                         << Private Functions Prototypes >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_glyph_acquire
+*
+** Description:
+*  This function gives the character code of a glyph for the current frame, and assigns it a slot if needed.
+*
+** Input Parameters:
+*  - glyph: const uint8_t*
+*    Pointer to the LCD_GLYPH_ROWS bytes of the glyph in flash (PROGMEM).
+*  - character_code: uint8_t*
+*    Pointer to the variable that receives the character code to write on the LCD.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the glyph has a slot, and 'LCD_NOT_OK' if all slots hold glyphs of the current frame.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_glyph_acquire(const uint8_t* glyph, uint8_t* character_code)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+	uint8_t free_slot = LCD_GLYPH_SLOTS_COUNT;
+	uint8_t oldest_slot = LCD_GLYPH_SLOTS_COUNT;
+	uint8_t oldest_age = 0;
+	uint8_t victim_slot;
+
+	if (NULL == glyph)
+	{
+		return LCD_NOT_OK;
+	}
+
+	for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS_COUNT; slot++)
+	{
+		if (glyph == g_glyph_slots[slot].glyph)
+		{
+			/* The glyph is already resident: */
+			g_glyph_slots[slot].age = 0;
+			*character_code = slot;
+			return LCD_OK;
+		}
+		else if (NULL == g_glyph_slots[slot].glyph)
+		{
+			if (LCD_GLYPH_SLOTS_COUNT == free_slot)
+			{
+				free_slot = slot;
+			}
+		}
+		else
+		{
+			/* Glyphs of the current frame have an age of 0, so they are never chosen: */
+			if (g_glyph_slots[slot].age > oldest_age)
+			{
+				oldest_age = g_glyph_slots[slot].age;
+				oldest_slot = slot;
+			}
+		}
+	}
+
+	/* A free slot is taken before any resident glyph is evicted: */
+	victim_slot = (LCD_GLYPH_SLOTS_COUNT != free_slot) ? free_slot : oldest_slot;
+
+	if (LCD_GLYPH_SLOTS_COUNT != victim_slot)
+	{
+		g_glyph_slots[victim_slot].glyph = glyph;
+		g_glyph_slots[victim_slot].age = 0;
+		g_glyph_slots[victim_slot].upload_pending = 1;
+		*character_code = victim_slot;
+		return_error = LCD_OK;
+	}
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_glyph_flush
+*
+** Description:
+*  This function uploads the glyphs that got new slots in the current frame to all the displays, then starts a new
+*  frame.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_glyph_flush(void)
+{
+	uint8_t selected_display = lcd_selected_display_get();
+	uint8_t address_in_place = 0;
+	uint8_t glyph_row;
+
+	for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS_COUNT; slot++)
+	{
+		if (g_glyph_slots[slot].upload_pending)
+		{
+			/* The CGRAM address counter continues into the next slot, so only the first slot of a run needs it: */
+			if (0 == address_in_place)
+			{
+				for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+				{
+					(void)lcd_display_select(display);
+					(void)lcd_command_send(LCD_SET_CGRAM_ADDRESS_COMMAND | (slot << LCD_GLYPH_ADDRESS_SHIFT));
+				}
+				address_in_place = 1;
+			}
+			/* Each row is sent to all the displays in turns: */
+			for (uint8_t row = 0; row < LCD_GLYPH_ROWS; row++)
+			{
+				glyph_row = pgm_read_byte(&g_glyph_slots[slot].glyph[row]);
+				for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+				{
+					(void)lcd_display_select(display);
+					lcd_character_write(glyph_row);
+				}
+			}
+			g_glyph_slots[slot].upload_pending = 0;
+		}
+		else
+		{
+			address_in_place = 0;
+		}
+		
+		/* A new frame starts. The ages stop at the maximum instead of wrapping, so an idle glyph never looks new: */
+		if (LCD_GLYPH_MAX_AGE > g_glyph_slots[slot].age)
+		{
+			g_glyph_slots[slot].age++;
+		}
+	}
+
+	(void)lcd_display_select(selected_display);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_glyph_reset
+*
+** Description:
+*  This function frees all the slots.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_glyph_reset(void)
+{
+	for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS_COUNT; slot++)
+	{
+		g_glyph_slots[slot].glyph = NULL;
+		g_glyph_slots[slot].upload_pending = 0;
+	}
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                                << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,136 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  lcd_glyph.h
+*
+** Description:
+*  This file contains the public programming interfaces for the LCD custom glyph manager. The LCD has only 8 CGRAM
+*  slots for custom characters, while the application may define any number of glyphs in flash. Each frame, the
+*  application acquires the glyphs it is going to draw. The manager gives each glyph a slot, evicting the least
+*  recently used glyph when needed, and lcd_glyph_flush() uploads the new glyphs to the LCD in a single batch.
+*
+*  A frame looks like this:
+*  lcd_glyph_acquire(g_arrow_up, &arrow_code);       -> Gives the character code of the glyph.
+*  lcd_framebuffer_character_write(0, 0, arrow_code);
+*  lcd_glyph_flush();                                -> Uploads the new glyphs and starts a new frame.
+*  lcd_framebuffer_flush();
+*
+*  The slots are shared by all the displays on the LCD bus, and every display gets the same glyphs.
+*
+*  Note: Evicting a glyph changes every character on the screen that still shows it. Glyphs acquired in the current
+*  frame are never evicted, so a screen that is fully redrawn each frame always shows the right glyphs.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef LCD_GLYPH_H_
+#define LCD_GLYPH_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "lcd.h"
+
+/*********************************************************************************************************************
+                                               << Public Constants >>
+*********************************************************************************************************************/
+#define   LCD_GLYPH_ROWS         (8U)   /* Bytes per glyph, one for each row. Only the low 5 bits are displayed. */
+#define   LCD_GLYPH_SLOTS_COUNT  (8U)   /* CGRAM slots, which are the character codes 0 to 7. */
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                          << Public Variable Declarations >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_glyph_acquire
+*
+** Description:
+*  This function gives the character code of a glyph for the current frame. If the glyph isn't in a CGRAM slot, it
+*  takes a free slot or the least recently used one, and the glyph is uploaded by the next lcd_glyph_flush().
+*
+** Input Parameters:
+*  - glyph: const uint8_t*
+*    Pointer to the LCD_GLYPH_ROWS bytes of the glyph in flash (PROGMEM). The pointer identifies the glyph.
+*  - character_code: uint8_t*
+*    Pointer to the variable that receives the character code to write on the LCD.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the glyph has a slot, and 'LCD_NOT_OK' if all slots hold glyphs of the current frame.
+*
+** Example:
+*  static const uint8_t g_degree_sign[LCD_GLYPH_ROWS] PROGMEM = {0x06, 0x09, 0x09, 0x06, 0x00, 0x00, 0x00, 0x00};
+*  uint8_t degree_code;
+*  if (LCD_OK == lcd_glyph_acquire(g_degree_sign, &degree_code))
+*  {
+*  	lcd_framebuffer_putc(degree_code);
+*  }
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_glyph_acquire(const uint8_t* glyph, uint8_t* character_code);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_glyph_flush
+*
+** Description:
+*  This function uploads the glyphs that got new slots in the current frame, with one CGRAM address command for each
+*  run of adjacent slots, then starts a new frame. It needs to be called before the characters of the frame are sent
+*  to the LCD. The glyphs are uploaded to all the displays, and the selected display is kept. The cursor location is
+*  unknown afterwards, so call lcd_gotoxy() before writing characters.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void lcd_glyph_flush(void);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_glyph_reset
+*
+** Description:
+*  This function frees all the slots, so every glyph is uploaded again when it is acquired. It needs to be called
+*  after lcd_init() if the LCD is initialized again.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void lcd_glyph_reset(void);
+
+
+#endif /* LCD_GLYPH_H_ */
+/*********************************************************************************************************************
+                                               << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,277 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  lcd_marquee.c
+*
+** Description:
+*  This file contains the implementation of the LCD scrolling text.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include "lcd_config.h"
+#include <stdint.h>
+#include <stddef.h>
+#include "lcd.h"
+#include "lcd_framebuffer.h"
+#include "lcd_marquee.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   LCD_SET_DDRAM_ADDRESS_COMMAND   (0x80U)
+#define   LCD_SECOND_LINE_ADDRESS         (0x40U)
+#define   LCD_SHIFT_DISPLAY_LEFT_COMMAND  (0x18U)
+#define   LCD_SHIFT_DISPLAY_RIGHT_COMMAND (0x1CU)
+#define   LCD_RETURN_HOME_COMMAND         (0x02U)
+#define   BLANK_CHARACTER                 (' ')
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                          << Public Variable Definitions >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                         << Private Functions Prototypes >>
+*********************************************************************************************************************/
+static void lcd_marquee_draw(const lcd_marquee_t* marquee);
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_hardware_load
+*
+** Description:
+*  This function writes a text into the whole DDRAM line of a certain LCD line, padded with spaces.
+*
+** Input Parameters:
+*  - y: uint8_t
+*    The line number, 0 or 1.
+*  - text: const char*
+*    The NULL terminated text.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for a correct line number, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_marquee_hardware_load(uint8_t y, const char* text)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+
+	if ((LCD_ROWS > y) && (2U > y) && (NULL != text))
+	{
+		/* lcd_gotoxy() only reaches the visible columns, so the DDRAM address is set directly: */
+		(void)lcd_command_send(LCD_SET_DDRAM_ADDRESS_COMMAND | ((0U == y) ? 0x00U : LCD_SECOND_LINE_ADDRESS));
+		for (uint8_t x = 0; x < LCD_DDRAM_LINE_LENGTH; x++)
+		{
+			if (0 != *text)
+			{
+				lcd_character_write((uint8_t)*text);
+				text++;
+			}
+			else
+			{
+				lcd_character_write(BLANK_CHARACTER);
+			}
+		}
+		return_error = LCD_OK;
+	}
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_hardware_step
+*
+** Description:
+*  This function scrolls all the LCD lines by one character with a single display shift command.
+*
+** Input Parameters:
+*  - direction: lcd_marquee_direction_t
+*    'LCD_MARQUEE_LEFT' or 'LCD_MARQUEE_RIGHT'.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_marquee_hardware_step(lcd_marquee_direction_t direction)
+{
+	if (LCD_MARQUEE_LEFT == direction)
+	{
+		(void)lcd_command_send(LCD_SHIFT_DISPLAY_LEFT_COMMAND);
+	}
+	else
+	{
+		(void)lcd_command_send(LCD_SHIFT_DISPLAY_RIGHT_COMMAND);
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_hardware_reset
+*
+** Description:
+*  This function removes the display shift with a return home command.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_marquee_hardware_reset(void)
+{
+	(void)lcd_command_send(LCD_RETURN_HOME_COMMAND);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_init
+*
+** Description:
+*  This function sets up a marquee in a window of the framebuffer, and draws the start of the text.
+*
+** Input Parameters:
+*  - marquee: lcd_marquee_t*
+*    Pointer to the marquee.
+*  - text: const char*
+*    The NULL terminated text.
+*  - x: uint8_t
+*    The first column of the window.
+*  - y: uint8_t
+*    The line of the window.
+*  - width: uint8_t
+*    The number of columns of the window.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the window fits on the screen, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_marquee_init(lcd_marquee_t* marquee, const char* text, uint8_t x, uint8_t y,
+                                      uint8_t width)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+	uint8_t length = 0;
+
+	if ((NULL != marquee) && (NULL != text) && (0 != width) && (LCD_COLUMNS >= width) &&
+	    ((LCD_COLUMNS - width) >= x) && (LCD_ROWS > y))
+	{
+		while ((0 != text[length]) && ((0xFFU - LCD_MARQUEE_GAP) > length))
+		{
+			length++;
+		}
+		marquee->text = text;
+		marquee->length = length;
+		marquee->x = x;
+		marquee->y = y;
+		marquee->width = width;
+		marquee->position = 0;
+		lcd_marquee_draw(marquee);
+		return_error = LCD_OK;
+	}
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_step
+*
+** Description:
+*  This function scrolls the text of a marquee by one character to the left in the framebuffer.
+*
+** Input Parameters:
+*  - marquee: lcd_marquee_t*
+*    Pointer to the marquee.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_marquee_step(lcd_marquee_t* marquee)
+{
+	/* A text that fits in the window stays still: */
+	if (marquee->length > marquee->width)
+	{
+		marquee->position++;
+		if ((uint16_t)marquee->length + LCD_MARQUEE_GAP == marquee->position)
+		{
+			marquee->position = 0;
+		}
+		lcd_marquee_draw(marquee);
+	}
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_draw
+*
+** Description:
+*  This function writes the part of the text seen through the window into the framebuffer. The text is followed by
+*  LCD_MARQUEE_GAP blanks, then starts again.
+*
+** Input Parameters:
+*  - marquee: const lcd_marquee_t*
+*    Pointer to the marquee.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+static void lcd_marquee_draw(const lcd_marquee_t* marquee)
+{
+	uint16_t text_index = marquee->position;
+	uint16_t period = (uint16_t)marquee->length + LCD_MARQUEE_GAP;
+
+	for (uint8_t column = 0; column < marquee->width; column++)
+	{
+		if (marquee->length > text_index)
+		{
+			(void)lcd_framebuffer_character_write(marquee->x + column, marquee->y, (uint8_t)marquee->text[text_index]);
+		}
+		else
+		{
+			(void)lcd_framebuffer_character_write(marquee->x + column, marquee->y, BLANK_CHARACTER);
+		}
+
+		/* A text that fits in the window is only padded, it isn't repeated: */
+		text_index++;
+		if ((period == text_index) && (marquee->length > marquee->width))
+		{
+			text_index = 0;
+		}
+	}
+}
+
+/*********************************************************************************************************************
+                                                << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,200 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  lcd_marquee.h
+*
+** Description:
+*  This file contains the public programming interfaces for scrolling text on the LCD, in one of two ways:
+*
+*  [1] Hardware shift: The text is written once into the whole 40 characters of a DDRAM line, and each scroll step is
+*      a single display shift command. The LCD shifts all its lines together, so this suits screens where every line
+*      scrolls, or where the other lines are loaded the same way. While the display is shifted, lcd_gotoxy() locations
+*      no longer match the screen, so the framebuffer can't be used until lcd_marquee_hardware_reset().
+*
+*  [2] Framebuffer window: Each marquee scrolls its text inside a window of one line through the framebuffer, so any
+*      number of windows scroll independently of the rest of the screen. lcd_framebuffer_flush() then sends only the
+*      characters that changed.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef LCD_MARQUEE_H_
+#define LCD_MARQUEE_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "lcd.h"
+
+/*********************************************************************************************************************
+                                               << Public Constants >>
+*********************************************************************************************************************/
+#define   LCD_DDRAM_LINE_LENGTH   (40U)   /* Characters of each DDRAM line, visible or not. */
+#define   LCD_MARQUEE_GAP         (3U)    /* Blanks between the end of a window text and its next start. */
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+typedef enum
+{
+	LCD_MARQUEE_LEFT = 0,   /* The text moves to the left. */
+	LCD_MARQUEE_RIGHT
+} lcd_marquee_direction_t;
+
+/* A text scrolling in a window of the framebuffer. The fields are set by lcd_marquee_init(). */
+typedef struct
+{
+	const char* text;       /* The text, which needs to stay in memory while the marquee is used. */
+	uint8_t     length;     /* The text length, the text is cut after 252 characters. */
+	uint8_t     x;          /* The first column of the window. */
+	uint8_t     y;          /* The line of the window. */
+	uint8_t     width;      /* The number of columns of the window. */
+	uint8_t     position;   /* The text character shown in the first column of the window. */
+} lcd_marquee_t;
+
+/*********************************************************************************************************************
+                                          << Public Variable Declarations >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_hardware_load
+*
+** Description:
+*  This function writes a text into the whole DDRAM line of a certain LCD line, padded with spaces, so it can be
+*  scrolled with lcd_marquee_hardware_step(). Characters after the first LCD_DDRAM_LINE_LENGTH are dropped. It costs
+*  one cursor move plus LCD_DDRAM_LINE_LENGTH character writes, once for each text.
+*
+** Input Parameters:
+*  - y: uint8_t
+*    The line number, 0 or 1. On 4 line LCDs, lines 2 and 3 are the hidden parts of the DDRAM lines 0 and 1.
+*  - text: const char*
+*    The NULL terminated text.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' for a correct line number, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_marquee_hardware_load(uint8_t y, const char* text);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_hardware_step
+*
+** Description:
+*  This function scrolls all the LCD lines by one character with a single display shift command. After
+*  LCD_DDRAM_LINE_LENGTH steps in the same direction, the display is back where it started.
+*
+** Input Parameters:
+*  - direction: lcd_marquee_direction_t
+*    'LCD_MARQUEE_LEFT' or 'LCD_MARQUEE_RIGHT'.
+*
+** Return Value:
+*  - void
+*
+** Example:
+*  lcd_marquee_hardware_load(0, "Door open - close the door before starting the cycle");
+*  while (1)
+*  {
+*  	lcd_marquee_hardware_step(LCD_MARQUEE_LEFT);
+*  	_delay_ms(300);
+*  }
+*********************************************************************************************************************/
+extern void lcd_marquee_hardware_step(lcd_marquee_direction_t direction);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_hardware_reset
+*
+** Description:
+*  This function removes the display shift with a return home command, so the lcd_gotoxy() locations match the screen
+*  again. The DDRAM content is kept.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void lcd_marquee_hardware_reset(void);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_init
+*
+** Description:
+*  This function sets up a marquee in a window of the framebuffer of the selected display, and draws the start of the
+*  text. A text that fits in the window is drawn padded with spaces and never scrolls.
+*
+** Input Parameters:
+*  - marquee: lcd_marquee_t*
+*    Pointer to the marquee.
+*  - text: const char*
+*    The NULL terminated text, which needs to stay in memory while the marquee is used.
+*  - x: uint8_t
+*    The first column of the window.
+*  - y: uint8_t
+*    The line of the window.
+*  - width: uint8_t
+*    The number of columns of the window.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the window fits on the screen, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_marquee_init(lcd_marquee_t* marquee, const char* text, uint8_t x, uint8_t y,
+                                             uint8_t width);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_marquee_step
+*
+** Description:
+*  This function scrolls the text of a marquee by one character to the left in the framebuffer. The text restarts
+*  LCD_MARQUEE_GAP blanks after its end. The LCD isn't accessed until lcd_framebuffer_flush().
+*
+** Input Parameters:
+*  - marquee: lcd_marquee_t*
+*    Pointer to the marquee.
+*
+** Return Value:
+*  - void
+*
+** Example:
+*  lcd_marquee_t g_status_marquee;
+*  lcd_marquee_init(&g_status_marquee, "Pump 2 pressure low", 0, 1, 10);
+*  while (1)
+*  {
+*  	lcd_marquee_step(&g_status_marquee);
+*  	lcd_framebuffer_flush();
+*  	_delay_ms(300);
+*  }
+*********************************************************************************************************************/
+extern void lcd_marquee_step(lcd_marquee_t* marquee);
+
+
+#endif /* LCD_MARQUEE_H_ */
+/*********************************************************************************************************************
+                                               << End of File >>
+*********************************************************************************************************************/
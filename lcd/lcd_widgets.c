@@ -0,0 +1,492 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  lcd_widgets.c
+*
+** Description:
+*  This file contains the implementation of the LCD widgets.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include "lcd_config.h"
+#include <avr/pgmspace.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "lcd.h"
+#include "lcd_framebuffer.h"
+#include "lcd_glyph.h"
+#include "lcd_widgets.h"
+#include "fmt.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   BLANK_CHARACTER        (' ')
+#define   FULL_CHARACTER         (0xFFU)   /* The solid block of the LCD character ROM. */
+#define   CHARACTER_COLUMNS      (5U)      /* Pixel columns of a character. */
+#define   SPARKLINE_FULL_LEVEL   (8U)      /* Pixel rows of a character. */
+#define   SPARKLINE_LEVEL_SHIFT  (3U)      /* Multiplies a sample by SPARKLINE_FULL_LEVEL. */
+#define   WIDGET_MAX_SHIFT       (16U)
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+/* The partial characters of the bar, with 1 to 4 pixel columns filled from the left: */
+static const uint8_t g_bar_glyphs[CHARACTER_COLUMNS - 1][LCD_GLYPH_ROWS] PROGMEM =
+{
+	{0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10},
+	{0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18},
+	{0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C},
+	{0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E}
+};
+
+/* The partial characters of the sparkline, with 1 to 7 pixel rows filled from the bottom: */
+static const uint8_t g_sparkline_glyphs[SPARKLINE_FULL_LEVEL - 1][LCD_GLYPH_ROWS] PROGMEM =
+{
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F},
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F},
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F},
+	{0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F},
+	{0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},
+	{0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},
+	{0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F}
+};
+
+/*********************************************************************************************************************
+                                          << Public Variable Definitions >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                         << Private Functions Prototypes >>
+*********************************************************************************************************************/
+static uint8_t lcd_widget_window_check(uint8_t x, uint8_t y, uint8_t width, uint8_t full_scale_shift);
+static uint8_t lcd_sparkline_code_get(uint8_t level);
+static void lcd_sparkline_draw(lcd_sparkline_t* sparkline);
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_bar_init
+*
+** Description:
+*  This function sets up a bar in the framebuffer, and draws it empty.
+*
+** Input Parameters:
+*  - bar: lcd_bar_t*
+*    Pointer to the bar.
+*  - x: uint8_t
+*    The first column.
+*  - y: uint8_t
+*    The line.
+*  - width: uint8_t
+*    The number of characters.
+*  - full_scale_shift: uint8_t
+*    The value that fills the bar is (1 << full_scale_shift).
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the bar fits on the screen, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_bar_init(lcd_bar_t* bar, uint8_t x, uint8_t y, uint8_t width, uint8_t full_scale_shift)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+
+	if ((NULL != bar) && lcd_widget_window_check(x, y, width, full_scale_shift))
+	{
+		bar->x = x;
+		bar->y = y;
+		bar->width = width;
+		bar->full_scale_shift = full_scale_shift;
+		bar->shown_columns = 0;
+		bar->shown_code = BLANK_CHARACTER;
+		for (uint8_t column = 0; column < width; column++)
+		{
+			(void)lcd_framebuffer_character_write(x + column, y, BLANK_CHARACTER);
+		}
+		return_error = LCD_OK;
+	}
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_bar_update
+*
+** Description:
+*  This function shows a new value on a bar, writing the framebuffer only if the shown bar changes.
+*
+** Input Parameters:
+*  - bar: lcd_bar_t*
+*    Pointer to the bar.
+*  - value: uint16_t
+*    The value, from 0 to the full scale.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_bar_update(lcd_bar_t* bar, uint16_t value)
+{
+	uint8_t bar_columns = bar->width * CHARACTER_COLUMNS;
+	uint32_t filled_columns = ((uint32_t)value * bar_columns) >> bar->full_scale_shift;
+	uint8_t partial_columns;
+	uint8_t partial_code = BLANK_CHARACTER;
+	uint8_t remaining_columns;
+
+	if (filled_columns > bar_columns)
+	{
+		filled_columns = bar_columns;
+	}
+
+	/* The columns of the partial character, found without a division: */
+	partial_columns = (uint8_t)filled_columns;
+	while (CHARACTER_COLUMNS <= partial_columns)
+	{
+		partial_columns -= CHARACTER_COLUMNS;
+	}
+
+	/* The glyph is acquired on every update, so it is kept in its slot while the bar doesn't change: */
+	if (0 != partial_columns)
+	{
+		if (LCD_OK != lcd_glyph_acquire(g_bar_glyphs[partial_columns - 1], &partial_code))
+		{
+			partial_code = ((CHARACTER_COLUMNS / 2) < partial_columns) ? FULL_CHARACTER : BLANK_CHARACTER;
+		}
+	}
+
+	if (((uint8_t)filled_columns == bar->shown_columns) && (partial_code == bar->shown_code))
+	{
+		return;
+	}
+
+	remaining_columns = (uint8_t)filled_columns;
+	for (uint8_t column = 0; column < bar->width; column++)
+	{
+		if (CHARACTER_COLUMNS <= remaining_columns)
+		{
+			(void)lcd_framebuffer_character_write(bar->x + column, bar->y, FULL_CHARACTER);
+			remaining_columns -= CHARACTER_COLUMNS;
+		}
+		else if (0 != remaining_columns)
+		{
+			(void)lcd_framebuffer_character_write(bar->x + column, bar->y, partial_code);
+			remaining_columns = 0;
+		}
+		else
+		{
+			(void)lcd_framebuffer_character_write(bar->x + column, bar->y, BLANK_CHARACTER);
+		}
+	}
+	bar->shown_columns = (uint8_t)filled_columns;
+	bar->shown_code = partial_code;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_sparkline_init
+*
+** Description:
+*  This function sets up a sparkline in the framebuffer, and draws it empty.
+*
+** Input Parameters:
+*  - sparkline: lcd_sparkline_t*
+*    Pointer to the sparkline.
+*  - x: uint8_t
+*    The first column.
+*  - y: uint8_t
+*    The line.
+*  - width: uint8_t
+*    The number of characters.
+*  - full_scale_shift: uint8_t
+*    The value that fills a character is (1 << full_scale_shift).
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the sparkline fits on the screen, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_sparkline_init(lcd_sparkline_t* sparkline, uint8_t x, uint8_t y, uint8_t width,
+                                        uint8_t full_scale_shift)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+
+	if ((NULL != sparkline) && (LCD_SPARKLINE_MAX_WIDTH >= width) && (SPARKLINE_LEVEL_SHIFT <= full_scale_shift) &&
+	    lcd_widget_window_check(x, y, width, full_scale_shift))
+	{
+		sparkline->x = x;
+		sparkline->y = y;
+		sparkline->width = width;
+		sparkline->full_scale_shift = full_scale_shift;
+		for (uint8_t column = 0; column < width; column++)
+		{
+			sparkline->levels[column] = 0;
+			sparkline->codes[column] = BLANK_CHARACTER;
+			(void)lcd_framebuffer_character_write(x + column, y, BLANK_CHARACTER);
+		}
+		return_error = LCD_OK;
+	}
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_sparkline_push
+*
+** Description:
+*  This function adds a sample at the right end of a sparkline, and moves the older samples to the left.
+*
+** Input Parameters:
+*  - sparkline: lcd_sparkline_t*
+*    Pointer to the sparkline.
+*  - value: uint16_t
+*    The sample, from 0 to the full scale.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_sparkline_push(lcd_sparkline_t* sparkline, uint16_t value)
+{
+	uint32_t level = ((uint32_t)value << SPARKLINE_LEVEL_SHIFT) >> sparkline->full_scale_shift;
+
+	if (SPARKLINE_FULL_LEVEL < level)
+	{
+		level = SPARKLINE_FULL_LEVEL;
+	}
+
+	for (uint8_t column = 1; column < sparkline->width; column++)
+	{
+		sparkline->levels[column - 1] = sparkline->levels[column];
+	}
+	sparkline->levels[sparkline->width - 1] = (uint8_t)level;
+
+	lcd_sparkline_draw(sparkline);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_sparkline_refresh
+*
+** Description:
+*  This function acquires the glyphs of a sparkline for the current frame without adding a sample.
+*
+** Input Parameters:
+*  - sparkline: lcd_sparkline_t*
+*    Pointer to the sparkline.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_sparkline_refresh(lcd_sparkline_t* sparkline)
+{
+	lcd_sparkline_draw(sparkline);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_gauge_init
+*
+** Description:
+*  This function sets up a gauge in the framebuffer. It is drawn by the first update.
+*
+** Input Parameters:
+*  - gauge: lcd_gauge_t*
+*    Pointer to the gauge.
+*  - x: uint8_t
+*    The first column.
+*  - y: uint8_t
+*    The line.
+*  - width: uint8_t
+*    The minimum number of characters.
+*  - fraction_digits: uint8_t
+*    The number of digits after the decimal point.
+*  - hysteresis: uint16_t
+*    The value needs to move more than this to be redrawn.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the gauge starts on the screen, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+lcd_std_error_type_t lcd_gauge_init(lcd_gauge_t* gauge, uint8_t x, uint8_t y, uint8_t width,
+                                    uint8_t fraction_digits, uint16_t hysteresis)
+{
+	lcd_std_error_type_t return_error = LCD_NOT_OK;
+
+	if ((NULL != gauge) && (LCD_COLUMNS > x) && (LCD_ROWS > y) && (FMT_FIXED_POINT_MAX_DIGITS >= fraction_digits))
+	{
+		gauge->x = x;
+		gauge->y = y;
+		gauge->width = width;
+		gauge->fraction_digits = fraction_digits;
+		gauge->hysteresis = hysteresis;
+		gauge->shown_valid = 0;
+		gauge->shown_length = 0;
+		gauge->shown_value = 0;
+		return_error = LCD_OK;
+	}
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_gauge_update
+*
+** Description:
+*  This function shows a new value on a gauge if it moved more than the hysteresis from the shown value.
+*
+** Input Parameters:
+*  - gauge: lcd_gauge_t*
+*    Pointer to the gauge.
+*  - value: int32_t
+*    The value in units of 10^-fraction_digits.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void lcd_gauge_update(lcd_gauge_t* gauge, int32_t value)
+{
+	int32_t change = value - gauge->shown_value;
+	uint8_t length;
+
+	if (gauge->shown_valid && (change <= (int32_t)gauge->hysteresis) && (change >= -(int32_t)gauge->hysteresis))
+	{
+		return;
+	}
+
+	(void)lcd_framebuffer_gotoxy(gauge->x, gauge->y);
+	length = fmt_fixed_point_write(lcd_framebuffer_putc, value, gauge->fraction_digits, gauge->width,
+	                               FMT_PAD_WITH_SPACES);
+	/* Blank what is left of a wider number: */
+	for (uint8_t i = length; i < gauge->shown_length; i++)
+	{
+		lcd_framebuffer_putc(BLANK_CHARACTER);
+	}
+
+	gauge->shown_value = value;
+	gauge->shown_length = length;
+	gauge->shown_valid = 1;
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_widget_window_check
+*
+** Description:
+*  This function checks that a widget fits on one line of the screen and that its full scale is supported.
+*
+** Input Parameters:
+*  - x: uint8_t
+*    The first column.
+*  - y: uint8_t
+*    The line.
+*  - width: uint8_t
+*    The number of characters.
+*  - full_scale_shift: uint8_t
+*    The full scale of the widget is (1 << full_scale_shift).
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 if the widget is correct, and 0 otherwise.
+*********************************************************************************************************************/
+static uint8_t lcd_widget_window_check(uint8_t x, uint8_t y, uint8_t width, uint8_t full_scale_shift)
+{
+	return ((0 != width) && (LCD_COLUMNS >= width) && ((LCD_COLUMNS - width) >= x) && (LCD_ROWS > y) &&
+	        (WIDGET_MAX_SHIFT >= full_scale_shift));
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_sparkline_code_get
+*
+** Description:
+*  This function gives the character that shows a sparkline level, acquiring its glyph if it is a partial character.
+*
+** Input Parameters:
+*  - level: uint8_t
+*    The level, from 0 to SPARKLINE_FULL_LEVEL.
+*
+** Return Value:
+*  - uint8_t
+*    The character code. If no glyph slot is free, it is the nearest full or blank character.
+*********************************************************************************************************************/
+static uint8_t lcd_sparkline_code_get(uint8_t level)
+{
+	uint8_t character_code;
+
+	if (0 == level)
+	{
+		character_code = BLANK_CHARACTER;
+	}
+	else if (SPARKLINE_FULL_LEVEL == level)
+	{
+		character_code = FULL_CHARACTER;
+	}
+	else if (LCD_OK != lcd_glyph_acquire(g_sparkline_glyphs[level - 1], &character_code))
+	{
+		character_code = ((SPARKLINE_FULL_LEVEL / 2) < level) ? FULL_CHARACTER : BLANK_CHARACTER;
+	}
+
+	return character_code;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_sparkline_draw
+*
+** Description:
+*  This function acquires the glyphs of all the sparkline levels, and writes the characters that changed to the
+*  framebuffer.
+*
+** Input Parameters:
+*  - sparkline: lcd_sparkline_t*
+*    Pointer to the sparkline.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+static void lcd_sparkline_draw(lcd_sparkline_t* sparkline)
+{
+	uint8_t character_code;
+
+	for (uint8_t column = 0; column < sparkline->width; column++)
+	{
+		character_code = lcd_sparkline_code_get(sparkline->levels[column]);
+		if (character_code != sparkline->codes[column])
+		{
+			(void)lcd_framebuffer_character_write(sparkline->x + column, sparkline->y, character_code);
+			sparkline->codes[column] = character_code;
+		}
+	}
+}
+
+/*********************************************************************************************************************
+                                                << End of File >>
+*********************************************************************************************************************/
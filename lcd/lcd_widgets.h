@@ -0,0 +1,279 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  lcd_widgets.h
+*
+** Description:
+*  This file contains the public programming interfaces for the LCD widgets, which show live values such as ADC
+*  readings in the framebuffer of the selected display:
+*  [1] Bar: A horizontal bar with a resolution of one pixel column (5 steps for each character).
+*  [2] Sparkline: A line of vertical bars, each showing one of the last samples with 9 levels.
+*  [3] Gauge: A number that is only redrawn when it moves more than a hysteresis, so noise in the last digit doesn't
+*      make it flicker.
+*
+*  Each widget keeps the value it shows, and its update function doesn't touch the framebuffer unless the shown value
+*  changes, so updating the widgets at the ADC rate costs no LCD access between visible changes.
+*
+*  The bar and the sparkline draw partial characters with custom glyphs from lcd_glyph.h, and call
+*  lcd_glyph_acquire() on every update. A frame is:
+*  lcd_bar_update(&g_pressure_bar, adc_read_channel(ADC_CHANNEL_0));
+*  lcd_gauge_update(&g_pressure_gauge, adc_read_channel(ADC_CHANNEL_0));
+*  lcd_glyph_flush();
+*  lcd_framebuffer_flush();
+*
+*  Note: The bar needs 1 glyph slot, and the sparkline up to 7. If the slots of a frame run out, a partial character
+*  is drawn as the nearest full or blank character.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef LCD_WIDGETS_H_
+#define LCD_WIDGETS_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "lcd.h"
+
+/*********************************************************************************************************************
+                                               << Public Constants >>
+*********************************************************************************************************************/
+#define   LCD_SPARKLINE_MAX_WIDTH   (20U)   /* The most characters, and samples, of a sparkline. */
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+/* The widgets are set by their init functions. The values are scaled to full scale by a shift, so no division is
+   needed: a widget with a full_scale_shift of 10 shows 0 to 1024, which suits the 10 bit ADC readings. */
+typedef struct
+{
+	uint8_t x;                 /* The first column. */
+	uint8_t y;                 /* The line. */
+	uint8_t width;             /* The number of characters. */
+	uint8_t full_scale_shift;  /* The full scale is (1 << full_scale_shift). */
+	uint8_t shown_columns;     /* The pixel columns filled on the screen. */
+	uint8_t shown_code;        /* The character code of the partial character on the screen. */
+} lcd_bar_t;
+
+typedef struct
+{
+	uint8_t x;
+	uint8_t y;
+	uint8_t width;
+	uint8_t full_scale_shift;
+	uint8_t levels[LCD_SPARKLINE_MAX_WIDTH];  /* The levels of the last samples, the oldest first. */
+	uint8_t codes[LCD_SPARKLINE_MAX_WIDTH];   /* The character codes on the screen. */
+} lcd_sparkline_t;
+
+typedef struct
+{
+	uint8_t  x;
+	uint8_t  y;
+	uint8_t  width;            /* The minimum number of characters, including the sign and the decimal point. */
+	uint8_t  fraction_digits;  /* The value is in units of 10^-fraction_digits, as in fmt_fixed_point_write(). */
+	uint16_t hysteresis;       /* The value needs to move more than this to be redrawn. */
+	uint8_t  shown_valid;
+	uint8_t  shown_length;     /* The number of characters on the screen. */
+	int32_t  shown_value;
+} lcd_gauge_t;
+
+/*********************************************************************************************************************
+                                          << Public Variable Declarations >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_bar_init
+*
+** Description:
+*  This function sets up a bar in the framebuffer of the selected display, and draws it empty.
+*
+** Input Parameters:
+*  - bar: lcd_bar_t*
+*    Pointer to the bar.
+*  - x: uint8_t
+*    The first column.
+*  - y: uint8_t
+*    The line.
+*  - width: uint8_t
+*    The number of characters.
+*  - full_scale_shift: uint8_t
+*    The value that fills the bar is (1 << full_scale_shift), up to 16.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the bar fits on the screen, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_bar_init(lcd_bar_t* bar, uint8_t x, uint8_t y, uint8_t width, uint8_t full_scale_shift);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_bar_update
+*
+** Description:
+*  This function shows a new value on a bar. The framebuffer is only written when the number of filled pixel columns
+*  changes, or when the glyph of the partial character moves to another slot.
+*
+** Input Parameters:
+*  - bar: lcd_bar_t*
+*    Pointer to the bar.
+*  - value: uint16_t
+*    The value, from 0 to the full scale. Larger values fill the bar.
+*
+** Return Value:
+*  - void
+*
+** Example:
+*  lcd_bar_t g_level_bar;
+*  lcd_bar_init(&g_level_bar, 0, 1, 16, 10);
+*  lcd_bar_update(&g_level_bar, adc_read_channel(ADC_CHANNEL_0));
+*********************************************************************************************************************/
+extern void lcd_bar_update(lcd_bar_t* bar, uint16_t value);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_sparkline_init
+*
+** Description:
+*  This function sets up a sparkline in the framebuffer of the selected display, and draws it empty.
+*
+** Input Parameters:
+*  - sparkline: lcd_sparkline_t*
+*    Pointer to the sparkline.
+*  - x: uint8_t
+*    The first column.
+*  - y: uint8_t
+*    The line.
+*  - width: uint8_t
+*    The number of characters, which is the number of samples shown, up to LCD_SPARKLINE_MAX_WIDTH.
+*  - full_scale_shift: uint8_t
+*    The value that fills a character is (1 << full_scale_shift), from 3 to 16.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the sparkline fits on the screen, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_sparkline_init(lcd_sparkline_t* sparkline, uint8_t x, uint8_t y, uint8_t width,
+                                               uint8_t full_scale_shift);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_sparkline_push
+*
+** Description:
+*  This function adds a sample at the right end of a sparkline, and moves the older samples to the left. Only the
+*  characters whose level changes are written to the framebuffer.
+*
+** Input Parameters:
+*  - sparkline: lcd_sparkline_t*
+*    Pointer to the sparkline.
+*  - value: uint16_t
+*    The sample, from 0 to the full scale. Larger values fill the character.
+*
+** Return Value:
+*  - void
+*
+** Example:
+*  Pushing one averaged sample each second draws the last minute on a 20 column LCD every 3 seconds:
+*  if (0 == (seconds % 3))
+*  {
+*  	lcd_sparkline_push(&g_temperature_history, temperature_average);
+*  }
+*********************************************************************************************************************/
+extern void lcd_sparkline_push(lcd_sparkline_t* sparkline, uint16_t value);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_sparkline_refresh
+*
+** Description:
+*  This function acquires the glyphs of a sparkline for the current frame without adding a sample, and fixes the
+*  characters whose glyph moved to another slot. It is needed in the frames without a new sample only if other
+*  users of lcd_glyph.h may evict the sparkline glyphs.
+*
+** Input Parameters:
+*  - sparkline: lcd_sparkline_t*
+*    Pointer to the sparkline.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+extern void lcd_sparkline_refresh(lcd_sparkline_t* sparkline);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_gauge_init
+*
+** Description:
+*  This function sets up a gauge in the framebuffer of the selected display. It is drawn by the first update.
+*
+** Input Parameters:
+*  - gauge: lcd_gauge_t*
+*    Pointer to the gauge.
+*  - x: uint8_t
+*    The first column.
+*  - y: uint8_t
+*    The line.
+*  - width: uint8_t
+*    The minimum number of characters, including the sign and the decimal point. Wider numbers take more characters.
+*  - fraction_digits: uint8_t
+*    The number of digits after the decimal point, from 0 to FMT_FIXED_POINT_MAX_DIGITS.
+*  - hysteresis: uint16_t
+*    The value needs to move more than this, in the same units, to be redrawn.
+*
+** Return Value:
+*  - lcd_std_error_type_t
+*    Returns 'LCD_OK' if the gauge starts on the screen, and 'LCD_NOT_OK' otherwise.
+*********************************************************************************************************************/
+extern lcd_std_error_type_t lcd_gauge_init(lcd_gauge_t* gauge, uint8_t x, uint8_t y, uint8_t width,
+                                           uint8_t fraction_digits, uint16_t hysteresis);
+
+/*********************************************************************************************************************
+** Function Name:
+*  lcd_gauge_update
+*
+** Description:
+*  This function shows a new value on a gauge if it moved more than the hysteresis from the shown value.
+*
+** Input Parameters:
+*  - gauge: lcd_gauge_t*
+*    Pointer to the gauge.
+*  - value: int32_t
+*    The value in units of 10^-fraction_digits.
+*
+** Return Value:
+*  - void
+*
+** Example:
+*  Showing a 0-5 V input as "4.98" with the 10 bit ADC, ignoring changes of 1 count:
+*  lcd_gauge_init(&g_voltage_gauge, 12, 0, 4, 2, 1);
+*  lcd_gauge_update(&g_voltage_gauge, ((int32_t)adc_read_channel(ADC_CHANNEL_0) * 500) >> 10);
+*********************************************************************************************************************/
+extern void lcd_gauge_update(lcd_gauge_t* gauge, int32_t value);
+
+
+#endif /* LCD_WIDGETS_H_ */
+/*********************************************************************************************************************
+                                               << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,154 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  fmt_cycles.c
+*
+** Description:
+*  This file measures the CPU cycles of lcd_int_to_string() for every digit count on the atmega32, next to the old
+*  conversion that divided by ten for every digit. Timer1 counts the CPU clock with no prescaler, and the table is
+*  printed on the UART. Build and run it with "make -C tests cycles", which needs avr-gcc and simavr.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdint.h>
+#include "lcd.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   MAX_DIGITS          (10U)
+#define   UART_BAUD_RATE      (38400UL)
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+/* The slowest number of each digit count, where every digit needs nine subtractions: */
+static const uint32_t g_worst_numbers[MAX_DIGITS] =
+{
+	9UL, 99UL, 999UL, 9999UL, 99999UL, 999999UL, 9999999UL, 99999999UL, 999999999UL, 3999999999UL
+};
+
+static volatile uint32_t g_number;  /* Volatile, so the compiler can't fold the conversion of a constant. */
+/* Called through a pointer, so the compiler can't inline the conversions or drop the ones whose digits aren't used: */
+static void (* volatile g_conversion)(uint32_t, uint8_t, char*);
+static uint16_t g_measurement_cost;
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+/* The conversion lcd_int_to_string() used before the subtraction core, kept for comparison: */
+static void division_int_to_string(uint32_t int_number, uint8_t number_of_digits, char* conversion_string)
+{
+	for (int8_t i = number_of_digits - 1; i >= 0; i--)
+	{
+		conversion_string[i] = (int_number % 10) + '0';
+		int_number /= 10;
+	}
+	
+	conversion_string[number_of_digits] = 0;
+}
+
+/* Measured alone to find the cycles of the call and the timer reads, which are subtracted from every result: */
+static void empty_int_to_string(uint32_t int_number, uint8_t number_of_digits, char* conversion_string)
+{
+	(void)int_number;
+	(void)number_of_digits;
+	conversion_string[0] = 0;
+}
+
+static void uart_character_write(char character)
+{
+	while (!(UCSRA & (1<<UDRE)));
+	UDR = character;
+}
+
+static void uart_string_write(const char* string)
+{
+	while (*string)
+	{
+		uart_character_write(*string++);
+	}
+}
+
+static void uart_number_write(uint16_t number)
+{
+	char digits[MAX_DIGITS + 1U];
+	
+	lcd_int_to_string(number, LCD_INT_DIGITS_AUTO, digits);
+	uart_string_write(digits);
+}
+
+static uint16_t conversion_cycles(void (*conversion)(uint32_t, uint8_t, char*), uint8_t number_of_digits)
+{
+	char digits[MAX_DIGITS + 1U];
+	uint16_t start;
+	uint16_t end;
+	
+	g_conversion = conversion;
+	start = TCNT1;
+	g_conversion(g_number, number_of_digits, digits);
+	end = TCNT1;
+	
+	return (uint16_t)(end - start) - g_measurement_cost;
+}
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(void)
+{
+	UBRRH = (uint8_t)(((F_CPU / (16UL * UART_BAUD_RATE)) - 1UL) >> 8);
+	UBRRL = (uint8_t)((F_CPU / (16UL * UART_BAUD_RATE)) - 1UL);
+	UCSRB = (1<<TXEN);
+	UCSRC = (1<<URSEL) | (1<<UCSZ1) | (1<<UCSZ0);
+	
+	TCCR1A = 0;
+	TCCR1B = (1<<CS10);
+	
+	g_measurement_cost = 0;
+	g_measurement_cost = conversion_cycles(&empty_int_to_string, 0);
+	
+	uart_string_write("digits lcd_int_to_string division\r\n");
+	
+	for (uint8_t number_of_digits = 1; number_of_digits <= MAX_DIGITS; number_of_digits++)
+	{
+		g_number = g_worst_numbers[number_of_digits - 1U];
+		
+		uart_number_write(number_of_digits);
+		uart_character_write(' ');
+		uart_number_write(conversion_cycles(&lcd_int_to_string, number_of_digits));
+		uart_character_write(' ');
+		uart_number_write(conversion_cycles(&division_int_to_string, number_of_digits));
+		uart_string_write("\r\n");
+	}
+	
+	/* Sleeping with the interrupts disabled ends the simulation: */
+	cli();
+	sleep_mode();
+	
+	return 0;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
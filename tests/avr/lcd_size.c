@@ -0,0 +1,57 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  lcd_size.c
+*
+** Description:
+*  This file is a minimal application of the LCD drivers, linked once with the previous 4 bit driver, lcd-4bit.c, and
+*  once with each pin backend of lcd/lcd.c, all with the wiring of lcd-4bit.c. Only the functions it calls are kept
+*  by the linker, so the sizes compare the same operations. Build them and print their sizes with
+*  "make -C tests sizes", which needs avr-gcc.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "lcd.h"
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static char g_string[] = "Hello, world!";
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(void)
+{
+	lcd_init();
+	lcd_command_send(0x01);
+	lcd_gotoxy(3, 1);
+	lcd_print_string(g_string);
+	lcd_data_send('!');
+	
+	for (;;);
+	
+	return 0;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
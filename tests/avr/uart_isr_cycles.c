@@ -0,0 +1,167 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  uart_isr_cycles.c
+*
+** Description:
+*  This file measures the CPU cycles of the UART receive complete interrupt service routine on the atmega32, for the
+*  hook binding of the "uart_config.h" it is built with. Each received byte is stored in a ring buffer, by the
+*  callback with "UART_RUNTIME_CALLBACKS" and by the inlined hook of "uart_ring_hooks.h" with
+*  "UART_COMPILE_TIME_HOOKS". The routine is called like a function with the interrupts disabled, and Timer1 counts
+*  the CPU clock with no prescaler around the call. The cycles of an empty call are subtracted, the interrupt response
+*  and the jump of the vector table, 7 more cycles, are the same for both bindings. The result is printed on the
+*  UART. Build and run both bindings with "make -C tests uart-cycles", which needs avr-gcc and simavr.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdint.h>
+#include "uart_config.h"
+#include "uart_atmega32.h"
+#include "uart_ring_hooks.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   UART_BAUD_RATE      (38400UL)
+#define   MAX_DIGITS          (5U)
+
+/*********************************************************************************************************************
+                                          << Public Variable Definitions >>
+*********************************************************************************************************************/
+volatile uint8_t g_rx_buffer[RX_BUFFER_SIZE];
+volatile uint8_t g_rx_head;
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+/* Called through a pointer, so the compiler can't drop the empty call: */
+static void (* volatile g_empty_routine)(void);
+static void (* volatile g_receive_routine)(void);
+
+/*********************************************************************************************************************
+                                         << Private Functions Prototypes >>
+*********************************************************************************************************************/
+/* The receive complete interrupt service routine of uart_atmega32.c: */
+void USART_RXC_vect(void);
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+#if (UART_RUNTIME_CALLBACKS == UART_ISR_HOOK_BINDING)
+static void ring_buffer_store(void)
+{
+	uint8_t head = g_rx_head;
+	
+	g_rx_buffer[head] = uart_data_read();
+	g_rx_head = (head + 1U) & (RX_BUFFER_SIZE - 1U);
+}
+#endif
+
+static void empty_routine(void)
+{
+}
+
+static void uart_character_write(char character)
+{
+	while (!(UCSRA & (1<<UDRE)));
+	UDR = character;
+}
+
+static void uart_string_write(const char* string)
+{
+	while (*string)
+	{
+		uart_character_write(*string++);
+	}
+}
+
+static void uart_number_write(uint16_t number)
+{
+	char digits[MAX_DIGITS];
+	uint8_t digit_count = 0;
+	
+	do
+	{
+		digits[digit_count++] = (char)('0' + (number % 10U));
+		number /= 10U;
+	} while (0U != number);
+	
+	while (digit_count)
+	{
+		uart_character_write(digits[--digit_count]);
+	}
+}
+
+static uint16_t routine_cycles(void (* volatile* routine)(void))
+{
+	uint16_t start;
+	uint16_t end;
+	
+	start = TCNT1;
+	(*routine)();
+	end = TCNT1;
+	/* The interrupt service routine returns with reti, which enables the interrupts: */
+	cli();
+	
+	return (uint16_t)(end - start);
+}
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(void)
+{
+	uint16_t empty_cycles;
+	
+	UBRRH = (uint8_t)(((F_CPU / (16UL * UART_BAUD_RATE)) - 1UL) >> 8);
+	UBRRL = (uint8_t)((F_CPU / (16UL * UART_BAUD_RATE)) - 1UL);
+	UCSRB = (1<<TXEN);
+	UCSRC = (1<<URSEL) | (1<<UCSZ1) | (1<<UCSZ0);
+	
+	TCCR1A = 0;
+	TCCR1B = (1<<CS10);
+	
+	#if (UART_RUNTIME_CALLBACKS == UART_ISR_HOOK_BINDING)
+	uart_receive_complete_interrupt_callback_set(&ring_buffer_store);
+	uart_string_write("runtime callbacks");
+	#else
+	uart_string_write("compile time hooks");
+	#endif
+	g_empty_routine = &empty_routine;
+	g_receive_routine = &USART_RXC_vect;
+	
+	empty_cycles = routine_cycles(&g_empty_routine);
+	uart_string_write(": ");
+	uart_number_write(routine_cycles(&g_receive_routine) - empty_cycles);
+	uart_string_write(" cycles per received byte\r\n");
+	
+	/* Sleeping with the interrupts disabled ends the simulation: */
+	cli();
+	sleep_mode();
+	
+	return 0;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
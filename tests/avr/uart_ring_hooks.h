@@ -0,0 +1,69 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  uart_ring_hooks.h
+*
+** Description:
+*  This file contains the UART hooks of uart_isr_cycles.c for "UART_COMPILE_TIME_HOOKS": the received bytes are stored
+*  in a ring buffer, the same store that its callback does for "UART_RUNTIME_CALLBACKS".
+*********************************************************************************************************************/
+
+
+#ifndef UART_RING_HOOKS_H_
+#define UART_RING_HOOKS_H_
+
+
+/*********************************************************************************************************************
+                                                  << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+
+
+/*********************************************************************************************************************
+                                                << Public Constants >>
+*********************************************************************************************************************/
+#define   RX_BUFFER_SIZE   (32U)   /* A power of two. */
+
+
+/*********************************************************************************************************************
+                                          << Public Variable Declarations >>
+*********************************************************************************************************************/
+extern volatile uint8_t g_rx_buffer[RX_BUFFER_SIZE];
+extern volatile uint8_t g_rx_head;
+
+
+/*********************************************************************************************************************
+                                          << Hook Function Definitions >>
+*********************************************************************************************************************/
+static inline void uart_transmit_ready_hook(void)
+{
+}
+
+static inline void uart_receive_complete_hook(uint8_t data)
+{
+	uint8_t head = g_rx_head;
+	
+	g_rx_buffer[head] = data;
+	g_rx_head = (head + 1U) & (RX_BUFFER_SIZE - 1U);
+}
+
+
+#endif /* UART_RING_HOOKS_H_ */
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,165 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  bench_lcd.c
+*
+** Description:
+*  This file runs the same LCD operations through the previous 4 bit driver, lcd-4bit.c, or through lcd/lcd.c, with
+*  the wiring of lcd-4bit.c: D4-D7 on PA4-PA7 and RS, RW and EN on PA0-PA2. It is built once for each driver, see
+*  "make -C tests bench". For each operation, it prints the bus time, the register accesses and the transfers the
+*  HD44780 model decoded, with the timing violations it found. The flash size of each driver is measured on the
+*  target by "make -C tests sizes".
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "host_avr.h"
+#include "host_hd44780.h"
+#include "lcd.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#ifndef BENCH_DRIVER_NAME
+#define   BENCH_DRIVER_NAME           "lcd/lcd.c"
+#endif
+
+#define   LCD_PORT                    (HOST_PORTA)
+#define   LCD_RS_PIN                  (0U)
+#define   LCD_RW_PIN                  (1U)
+#define   LCD_EN_PIN                  (2U)
+#define   CLEAR_DISPLAY_COMMAND       (0x01U)
+/* lcd-4bit.c waits only 2 ms for the power-on reset of the LCD, so the benchmark waits for it before lcd_init(), which
+   lcd/lcd.c then waits for again: */
+#define   POWER_ON_WAIT_MS            (15U)
+/* The longest instruction, the clear display command, takes 1.52 ms. The operations are measured from an idle LCD: */
+#define   IDLE_WAIT_MS                (2U)
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static uint32_t g_register_accesses;
+static char g_string[] = "Hello, world!";
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+/* Counts the register accesses of the driver, the delay steps aren't accesses: */
+static void counting_io_listener(host_io_t io_register)
+{
+	if (HOST_IO_REGISTERS_COUNT != io_register)
+	{
+		g_register_accesses++;
+	}
+	host_hd44780_io_listener(io_register);
+}
+
+static void init_operation(void)
+{
+	(void)lcd_init();
+}
+
+static void string_operation(void)
+{
+	lcd_print_string(g_string);
+}
+
+static void character_operation(void)
+{
+	(void)lcd_gotoxy(3, 1);
+	lcd_data_send('!');
+}
+
+static void clear_operation(void)
+{
+	(void)lcd_command_send(CLEAR_DISPLAY_COMMAND);
+}
+
+static void operation_measure(const char* name, void (*operation)(void))
+{
+	host_hd44780_statistics_t statistics;
+	uint64_t start_ns;
+	uint64_t bus_time_ns;
+	
+	fflush(stdout);
+	host_hd44780_statistics_clear();
+	g_register_accesses = 0;
+	start_ns = host_time_ns();
+	operation();
+	bus_time_ns = host_time_ns() - start_ns;
+	host_hd44780_statistics_get(0, &statistics);
+	
+	printf("  %-32s %9llu.%03llu us %5lu register accesses %3lu instructions %3lu data writes %3lu violations\n",
+	       name, (unsigned long long)(bus_time_ns / 1000ULL), (unsigned long long)(bus_time_ns % 1000ULL),
+	       (unsigned long)g_register_accesses, (unsigned long)statistics.instructions,
+	       (unsigned long)statistics.data_writes, (unsigned long)statistics.violations);
+}
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(void)
+{
+	host_hd44780_wiring_t wiring;
+	char line[17];
+	
+	memset(&wiring, 0, sizeof(wiring));
+	memset(wiring.data_pins, HOST_HD44780_NOT_CONNECTED, sizeof(wiring.data_pins));
+	wiring.data_port = LCD_PORT;
+	for (uint8_t pin = 4; pin < 8U; pin++)
+	{
+		wiring.data_pins[pin] = pin;
+	}
+	wiring.register_select.port = LCD_PORT;
+	wiring.register_select.pin = LCD_RS_PIN;
+	wiring.read_write.port = LCD_PORT;
+	wiring.read_write.pin = LCD_RW_PIN;
+	wiring.enable[0].port = LCD_PORT;
+	wiring.enable[0].pin = LCD_EN_PIN;
+	wiring.displays_count = 1;
+	
+	host_reset(HOST_DEFAULT_CPU_FREQUENCY);
+	host_hd44780_power_on(&wiring);
+	host_io_listener_set(counting_io_listener);
+	
+	printf("bench_lcd (%s):\n", BENCH_DRIVER_NAME);
+	host_delay_ns(POWER_ON_WAIT_MS * 1000000ULL);
+	operation_measure("lcd_init()", init_operation);
+	host_delay_ns(IDLE_WAIT_MS * 1000000ULL);
+	operation_measure("lcd_print_string(13 characters)", string_operation);
+	host_delay_ns(IDLE_WAIT_MS * 1000000ULL);
+	operation_measure("lcd_gotoxy() + lcd_data_send()", character_operation);
+	host_hd44780_line_get(0, 0, 16U, line);
+	printf("  line 0: \"%s\"\n", line);
+	host_hd44780_line_get(0, 1, 16U, line);
+	printf("  line 1: \"%s\"\n", line);
+	host_delay_ns(IDLE_WAIT_MS * 1000000ULL);
+	operation_measure("lcd_command_send(clear)", clear_operation);
+	host_delay_ns(IDLE_WAIT_MS * 1000000ULL);
+	operation_measure("lcd_data_send() after the clear", character_operation);
+	
+	return 0;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,35 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  avr/interrupt.h
+*
+** Description:
+*  Host stand-in for <avr/interrupt.h>. An interrupt service routine is a plain function that a test calls to inject
+*  the interrupt, and sei()/cli() only change the I bit of SREG.
+*********************************************************************************************************************/
+
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define   ISR(vector, ...)   void vector(void); void vector(void)
+#define   sei()              (SREG |= 0x80U)
+#define   cli()              (SREG &= (uint8_t)~0x80U)
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
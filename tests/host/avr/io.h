@@ -0,0 +1,171 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  avr/io.h
+*
+** Description:
+*  Host stand-in for <avr/io.h>. The registers used by the drivers of this repository map to host_io_access(), the bit
+*  positions are those of the atmega32.
+*********************************************************************************************************************/
+
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+#include <stdint.h>
+#include "host_avr.h"
+
+/* GPIO: */
+#define   PORTA   HOST_IO(HOST_PORTA)
+#define   DDRA    HOST_IO(HOST_DDRA)
+#define   PINA    HOST_IO(HOST_PINA)
+#define   PORTB   HOST_IO(HOST_PORTB)
+#define   DDRB    HOST_IO(HOST_DDRB)
+#define   PINB    HOST_IO(HOST_PINB)
+#define   PORTC   HOST_IO(HOST_PORTC)
+#define   DDRC    HOST_IO(HOST_DDRC)
+#define   PINC    HOST_IO(HOST_PINC)
+#define   PORTD   HOST_IO(HOST_PORTD)
+#define   DDRD    HOST_IO(HOST_DDRD)
+#define   PIND    HOST_IO(HOST_PIND)
+
+/* UART: */
+#define   UDR     (*host_udr_access())
+#define   UCSRA   HOST_IO(HOST_UCSRA)
+#define   UCSRB   HOST_IO(HOST_UCSRB)
+#define   UCSRC   HOST_IO(HOST_UCSRC)
+#define   UBRRH   HOST_IO(HOST_UBRRH)
+#define   UBRRL   HOST_IO(HOST_UBRRL)
+
+#define   RXC     7
+#define   TXC     6
+#define   UDRE    5
+#define   FE      4
+#define   DOR     3
+#define   PE      2
+#define   U2X     1
+#define   MPCM    0
+#define   RXCIE   7
+#define   TXCIE   6
+#define   UDRIE   5
+#define   RXEN    4
+#define   TXEN    3
+#define   UCSZ2   2
+#define   RXB8    1
+#define   TXB8    0
+#define   URSEL   7
+#define   UMSEL   6
+#define   UPM1    5
+#define   UPM0    4
+#define   USBS    3
+#define   UCSZ1   2
+#define   UCSZ0   1
+#define   UCPOL   0
+
+/* ADC: */
+#define   ADMUX    HOST_IO(HOST_ADMUX)
+#define   ADCSRA   HOST_IO(HOST_ADCSRA)
+#define   SFIOR    HOST_IO(HOST_SFIOR)
+#define   ADCL     HOST_IO(HOST_ADCL)
+#define   ADCH     HOST_IO(HOST_ADCH)
+#define   ADC      host_adc_data
+#define   ADCW     host_adc_data
+
+#define   REFS1   7
+#define   REFS0   6
+#define   ADLAR   5
+#define   MUX4    4
+#define   MUX3    3
+#define   MUX2    2
+#define   MUX1    1
+#define   MUX0    0
+#define   ADEN    7
+#define   ADSC    6
+#define   ADATE   5
+#define   ADIF    4
+#define   ADIE    3
+#define   ADPS2   2
+#define   ADPS1   1
+#define   ADPS0   0
+#define   ADTS2   7
+#define   ADTS1   6
+#define   ADTS0   5
+
+/* Timers: */
+#define   TCCR0   HOST_IO(HOST_TCCR0)
+#define   TCNT0   HOST_IO(HOST_TCNT0)
+#define   OCR0    HOST_IO(HOST_OCR0)
+#define   TCCR2   HOST_IO(HOST_TCCR2)
+#define   TCNT2   HOST_IO(HOST_TCNT2)
+#define   OCR2    HOST_IO(HOST_OCR2)
+#define   TIMSK   HOST_IO(HOST_TIMSK)
+#define   TIFR    HOST_IO(HOST_TIFR)
+
+#define   FOC0    7
+#define   WGM00   6
+#define   COM01   5
+#define   COM00   4
+#define   WGM01   3
+#define   CS02    2
+#define   CS01    1
+#define   CS00    0
+#define   FOC2    7
+#define   WGM20   6
+#define   COM21   5
+#define   COM20   4
+#define   WGM21   3
+#define   CS22    2
+#define   CS21    1
+#define   CS20    0
+#define   OCIE2   7
+#define   TOIE2   6
+#define   TICIE1  5
+#define   OCIE1A  4
+#define   OCIE1B  3
+#define   TOIE1   2
+#define   OCIE0   1
+#define   TOIE0   0
+#define   OCF2    7
+#define   TOV2    6
+#define   ICF1    5
+#define   OCF1A   4
+#define   OCF1B   3
+#define   TOV1    2
+#define   OCF0    1
+#define   TOV0    0
+
+/* TWI: */
+#define   TWBR    HOST_IO(HOST_TWBR)
+#define   TWSR    HOST_IO(HOST_TWSR)
+#define   TWAR    HOST_IO(HOST_TWAR)
+#define   TWDR    HOST_IO(HOST_TWDR)
+#define   TWCR    HOST_IO(HOST_TWCR)
+
+#define   TWINT   7
+#define   TWEA    6
+#define   TWSTA   5
+#define   TWSTO   4
+#define   TWWC    3
+#define   TWEN    2
+#define   TWIE    0
+#define   TWPS1   1
+#define   TWPS0   0
+
+/* Status register: */
+#define   SREG    HOST_IO(HOST_SREG)
+
+#endif /* HOST_AVR_IO_H_ */
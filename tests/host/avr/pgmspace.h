@@ -0,0 +1,36 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  avr/pgmspace.h
+*
+** Description:
+*  Host stand-in for <avr/pgmspace.h>. There is one address space on the host, so flash reads are plain reads.
+*********************************************************************************************************************/
+
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+
+#define   PROGMEM
+#define   PSTR(string)              (string)
+#define   pgm_read_byte(address)    (*(const uint8_t*)(address))
+#define   pgm_read_word(address)    (*(const uint16_t*)(address))
+#define   pgm_read_dword(address)   (*(const uint32_t*)(address))
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
@@ -0,0 +1,209 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_adc.c
+*
+** Description:
+*  This file contains the implementation of the ADC model. It keeps one conversion at a time: the ADMUX value it
+*  started with and its result, and it follows ADSC, ADATE, ADIF and ADIE of ADCSRA as the datasheet describes them.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <avr/io.h>
+#include "host_avr.h"
+#include "host_adc.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   GLOBAL_INTERRUPT_ENABLE   (0x80U)
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static host_adc_conversion_t g_conversion;
+static uint8_t g_running;
+static uint16_t g_result;
+
+/*********************************************************************************************************************
+                                         << Private Function Declarations >>
+*********************************************************************************************************************/
+static void conversion_start_check(void);
+static void conversion_end(void);
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  host_adc_power_on
+*
+** Description:
+*  This function resets the model, with no conversion running. Call it after host_reset().
+*
+** Input Parameters:
+*  - conversion: host_adc_conversion_t
+*    Gives the result of each conversion.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_adc_power_on(host_adc_conversion_t conversion)
+{
+	g_conversion = conversion;
+	g_running = 0;
+	g_result = 0;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_adc_io_listener
+*
+** Description:
+*  This function is the register access listener of the model. A conversion starts when ADSC is found set, which is
+*  before the access that follows the write, so ADMUX is taken as it was when ADSC was set. A running conversion
+*  completes when ADCSRA is about to be read with the interrupt disabled, as the polling loops wait for it.
+*
+** Input Parameters:
+*  - io_register: host_io_t
+*    The register about to be accessed, or HOST_IO_REGISTERS_COUNT during a delay.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_adc_io_listener(host_io_t io_register)
+{
+	conversion_start_check();
+	
+	if (g_running && (HOST_ADCSRA == io_register) && !(host_io[HOST_ADCSRA] & (1U << ADIE)))
+	{
+		conversion_end();
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_adc_conversion_complete
+*
+** Description:
+*  This function completes the running conversion: ADC gets its result, ADSC is cleared and ADIF is set. If ADIE and
+*  the I bit of SREG are set, ADIF is cleared again and ADC_vect is called, as the interrupt vector does.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 if a conversion was running, and 0 otherwise.
+*********************************************************************************************************************/
+uint8_t host_adc_conversion_complete(void)
+{
+	conversion_start_check();
+	
+	if (!g_running)
+	{
+		return 0;
+	}
+	
+	conversion_end();
+	if ((host_io[HOST_ADCSRA] & (1U << ADIE)) && (host_io[HOST_SREG] & GLOBAL_INTERRUPT_ENABLE))
+	{
+		host_io[HOST_ADCSRA] &= (uint8_t)~(1U << ADIF);
+		ADC_vect();
+	}
+	
+	return 1;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_adc_trigger
+*
+** Description:
+*  This function is a rising edge of the auto trigger source. It starts a conversion if ADATE is set and no
+*  conversion is running, and it is ignored otherwise, as the datasheet says.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 if a conversion started, and 0 otherwise.
+*********************************************************************************************************************/
+uint8_t host_adc_trigger(void)
+{
+	conversion_start_check();
+	
+	if (g_running || !(host_io[HOST_ADCSRA] & (1U << ADATE)))
+	{
+		return 0;
+	}
+	
+	host_io[HOST_ADCSRA] |= (uint8_t)(1U << ADSC);
+	conversion_start_check();
+	
+	return 1;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_adc_conversion_running
+*
+** Description:
+*  This function tells whether a conversion is running.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 if a conversion is running, and 0 otherwise.
+*********************************************************************************************************************/
+uint8_t host_adc_conversion_running(void)
+{
+	conversion_start_check();
+	
+	return g_running;
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+static void conversion_start_check(void)
+{
+	if (!g_running && (host_io[HOST_ADCSRA] & (1U << ADSC)) && (host_io[HOST_ADCSRA] & (1U << ADEN)))
+	{
+		g_running = 1;
+		g_result = (NULL != g_conversion) ? g_conversion(host_io[HOST_ADMUX]) : 0U;
+	}
+}
+
+static void conversion_end(void)
+{
+	host_adc_data = g_result;
+	host_io[HOST_ADCSRA] = (uint8_t)((host_io[HOST_ADCSRA] & ~(1U << ADSC)) | (1U << ADIF));
+	g_running = 0;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,70 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_adc.h
+*
+** Description:
+*  This file contains the interface of a model of the ATmega32 ADC on the registers of the host build. A conversion
+*  starts when ADSC is set, with the channel that ADMUX selects at that moment, and it completes when the test says
+*  so, or at once when the code polls ADCSRA with the interrupt disabled. On completion, ADC gets the result that the
+*  test gives for the ADMUX value, and ADC_vect is called if ADIE and the I bit of SREG are set.
+*
+*  The model is driven by the register accesses of the code under test: host_adc_io_listener() has to be called from
+*  the listener set by host_io_listener_set(), or set as that listener directly. Writing 1 to ADIF can't be told apart
+*  from keeping it set on the host registers, so the model never raises the interrupt of a flag left set.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef HOST_ADC_H_
+#define HOST_ADC_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "host_avr.h"
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+/* Gives the result of a conversion started with the given ADMUX value, called when the conversion starts: */
+typedef uint16_t (*host_adc_conversion_t)(uint8_t admux);
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+extern void host_adc_power_on(host_adc_conversion_t conversion);
+
+extern void host_adc_io_listener(host_io_t io_register);
+
+extern uint8_t host_adc_conversion_complete(void);
+
+extern uint8_t host_adc_trigger(void);
+
+extern uint8_t host_adc_conversion_running(void);
+
+/* The interrupt service routine of the code under test: */
+extern void ADC_vect(void);
+
+
+#endif /* HOST_ADC_H_ */
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,225 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_avr.c
+*
+** Description:
+*  This file contains the implementation of the host side stand-in for the atmega32 hardware.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "host_avr.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   NANOSECONDS_PER_SECOND   (1000000000ULL)
+
+/*********************************************************************************************************************
+                                          << Public Variable Definitions >>
+*********************************************************************************************************************/
+volatile uint8_t host_io[HOST_IO_REGISTERS_COUNT];
+volatile uint16_t host_adc_data;
+volatile uint16_t host_udr;
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static host_io_listener_t g_io_listener = NULL;
+static uint64_t g_time_ns;
+static uint64_t g_cycle_time_ps;  /* Picoseconds, so 12 MHz and 16 MHz don't round to whole nanoseconds. */
+static uint64_t g_cycles;
+static uint32_t g_cpu_frequency;
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  host_reset
+*
+** Description:
+*  This function clears all the registers, removes the listener and restarts the virtual clock at zero.
+*
+** Input Parameters:
+*  - cpu_frequency: uint32_t
+*    The microcontroller clock in Hz, which sets the virtual time of one register access.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_reset(uint32_t cpu_frequency)
+{
+	memset((void*)host_io, 0, sizeof(host_io));
+	host_adc_data = 0;
+	host_udr = HOST_UDR_UNWRITTEN;
+	g_io_listener = NULL;
+	g_time_ns = 0;
+	g_cycles = 0;
+	g_cpu_frequency = cpu_frequency;
+	g_cycle_time_ps = (NANOSECONDS_PER_SECOND * 1000ULL) / cpu_frequency;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_io_access
+*
+** Description:
+*  This function is what every register macro of the stub <avr/io.h> expands to. It costs one CPU cycle of virtual
+*  time and lets the listener see the access before it happens.
+*
+** Input Parameters:
+*  - io_register: host_io_t
+*
+** Return Value:
+*  - volatile uint8_t*
+*    The storage of the register.
+*********************************************************************************************************************/
+volatile uint8_t* host_io_access(host_io_t io_register)
+{
+	if (0 == g_cycle_time_ps)
+	{
+		host_reset(HOST_DEFAULT_CPU_FREQUENCY);
+	}
+	
+	g_cycles++;
+	
+	if (NULL != g_io_listener)
+	{
+		g_io_listener(io_register);
+	}
+	
+	return &host_io[io_register];
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_udr_access
+*
+** Description:
+*  This function is what UDR expands to. It is host_io_access() for the 16-bit host UDR, see "host_avr.h".
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - volatile uint16_t*
+*    The storage of UDR.
+*********************************************************************************************************************/
+volatile uint16_t* host_udr_access(void)
+{
+	(void)host_io_access(HOST_UDR);
+	
+	return &host_udr;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_io_listener_set
+*
+** Description:
+*  This function sets the function called before every register access, or removes it when NULL is passed.
+*
+** Input Parameters:
+*  - listener: host_io_listener_t
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_io_listener_set(host_io_listener_t listener)
+{
+	g_io_listener = listener;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_delay_ns
+*
+** Description:
+*  This function advances the virtual clock. The stub _delay_us() and _delay_ms() use it. The listener is called
+*  first, so the register writes made before the delay are stamped with the time they were made at, and then after
+*  every HOST_DELAY_STEP_NS of the delay.
+*
+** Input Parameters:
+*  - delay_ns: uint64_t
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_delay_ns(uint64_t delay_ns)
+{
+	uint64_t step_ns;
+	
+	do
+	{
+		if (NULL != g_io_listener)
+		{
+			g_io_listener(HOST_IO_REGISTERS_COUNT);
+		}
+		
+		step_ns = (delay_ns < HOST_DELAY_STEP_NS) ? delay_ns : HOST_DELAY_STEP_NS;
+		g_time_ns += step_ns;
+		delay_ns -= step_ns;
+	} while (0 != delay_ns);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_time_ns
+*
+** Description:
+*  This function returns the virtual time since host_reset(): the delays plus one CPU cycle per register access.
+*  Everything else the code does is free, so the time is a lower bound of the time on the microcontroller.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint64_t
+*********************************************************************************************************************/
+uint64_t host_time_ns(void)
+{
+	return g_time_ns + ((g_cycles * g_cycle_time_ps) / 1000ULL);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_cpu_frequency
+*
+** Description:
+*  This function returns the microcontroller clock passed to host_reset().
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint32_t
+*********************************************************************************************************************/
+uint32_t host_cpu_frequency(void)
+{
+	return g_cpu_frequency;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
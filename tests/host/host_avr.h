@@ -0,0 +1,104 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_avr.h
+*
+** Description:
+*  This file contains the interface of the host side stand-in for the atmega32 hardware. The driver sources are built
+*  unchanged on Linux against the stub <avr/...> and <util/...> headers next to this file. Every I/O register lives in
+*  an array and is reached through host_io_access(), so a test can watch the register traffic, and a virtual clock
+*  that advances one CPU cycle per register access and by the requested time in _delay_us() gives the elapsed
+*  microcontroller time.
+*  UDR is the exception: it is 16 bits wide on the host. Reads return the received byte from the low byte, and the
+*  high byte is kept at HOST_UDR_UNWRITTEN until the driver writes the register, which is how a UART double tells a
+*  transmitted byte from a read.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef HOST_AVR_H_
+#define HOST_AVR_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+
+/*********************************************************************************************************************
+                                               << Public Constants >>
+*********************************************************************************************************************/
+#define   HOST_DEFAULT_CPU_FREQUENCY   (12000000UL)
+
+#define   HOST_UDR_UNWRITTEN           (0xFF00U)
+#define   HOST_DELAY_STEP_NS           (10000ULL)  /* Delays call the listener at least this often. */
+
+/* What the register names of the stub <avr/io.h> expand to: */
+#define   HOST_IO(io_register)   (*host_io_access(io_register))
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+typedef enum
+{
+	HOST_PORTA, HOST_DDRA, HOST_PINA,
+	HOST_PORTB, HOST_DDRB, HOST_PINB,
+	HOST_PORTC, HOST_DDRC, HOST_PINC,
+	HOST_PORTD, HOST_DDRD, HOST_PIND,
+	HOST_UDR, HOST_UCSRA, HOST_UCSRB, HOST_UCSRC, HOST_UBRRH, HOST_UBRRL,
+	HOST_ADMUX, HOST_ADCSRA, HOST_SFIOR, HOST_ADCL, HOST_ADCH,
+	HOST_TCCR0, HOST_TCNT0, HOST_OCR0, HOST_TCCR2, HOST_TCNT2, HOST_OCR2, HOST_TIMSK, HOST_TIFR,
+	HOST_TWBR, HOST_TWSR, HOST_TWAR, HOST_TWDR, HOST_TWCR,
+	HOST_SREG,
+	HOST_IO_REGISTERS_COUNT
+} host_io_t;
+
+/* Called before every register access with the register about to be accessed, and every HOST_DELAY_STEP_NS during a
+   delay with HOST_IO_REGISTERS_COUNT, so a test can raise interrupts while the code waits. Register writes are seen on the next call, so the listener compares the registers it watches
+   against their last known values. A listener can also refresh an input register, like PINx, before it is read. */
+typedef void (*host_io_listener_t)(host_io_t io_register);
+
+/*********************************************************************************************************************
+                                          << Public Variable Declarations >>
+*********************************************************************************************************************/
+extern volatile uint8_t host_io[HOST_IO_REGISTERS_COUNT];
+extern volatile uint16_t host_adc_data;
+extern volatile uint16_t host_udr;
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+extern volatile uint8_t* host_io_access(host_io_t io_register);
+
+extern volatile uint16_t* host_udr_access(void);
+
+extern void host_io_listener_set(host_io_listener_t listener);
+
+extern void host_reset(uint32_t cpu_frequency);
+
+extern void host_delay_ns(uint64_t delay_ns);
+
+extern uint64_t host_time_ns(void);
+
+extern uint32_t host_cpu_frequency(void);
+
+
+#endif /* HOST_AVR_H_ */
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
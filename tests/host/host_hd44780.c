@@ -0,0 +1,833 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_hd44780.c
+*
+** Description:
+*  This file contains the implementation of the HD44780 controller model. Each controller follows its instruction
+*  set: the interface width set by the function set instruction, with the 4 bit nibbles of writes and reads counted
+*  together, the address counter moving through DDRAM or CGRAM as the entry mode says, the display shift, and the
+*  busy flag set for the execution time of each instruction.
+*  The timings checked are the enable pulse width (PWEH), the enable cycle time (tcycE), the RS and RW setup and
+*  hold around the enable pulse (tAS, tAH), the data setup and hold around the falling edge (tDSW, tH), the data
+*  delay of reads (tDDR), the execution times, the power-on reset and the waits of the wake-up sequence.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "host_avr.h"
+#include "host_hd44780.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+/* The HD44780U datasheet minimum timings for VCC 4.5 V to 5.5 V, and the execution times at fOSC = 270 kHz: */
+#define   ENABLE_PULSE_WIDTH_MIN_NS        (230ULL)
+#define   ENABLE_CYCLE_TIME_MIN_NS         (500ULL)
+#define   ADDRESS_SETUP_TIME_MIN_NS        (40ULL)
+#define   ADDRESS_HOLD_TIME_MIN_NS         (10ULL)
+#define   DATA_SETUP_TIME_MIN_NS           (80ULL)
+#define   DATA_HOLD_TIME_MIN_NS            (10ULL)
+#define   DATA_DELAY_TIME_MAX_NS           (160ULL)
+#define   POWER_ON_TIME_NS                 (15000000ULL)
+#define   SHORT_EXECUTION_TIME_NS          (37000ULL)
+#define   LONG_EXECUTION_TIME_NS           (1520000ULL)
+/* The waits after the first and the second function set of the wake-up sequence: */
+#define   WAKEUP_FIRST_EXECUTION_TIME_NS   (4100000ULL)
+#define   WAKEUP_SECOND_EXECUTION_TIME_NS  (100000ULL)
+#define   WAKEUP_INSTRUCTIONS_COUNT        (3U)
+
+#define   DATA_BITS_COUNT                  (8U)
+#define   HIGH_NIBBLE_MASK                 (0xF0U)
+#define   HALF_BYTE                        (4U)
+#define   BUSY_FLAG                        (0x80U)
+#define   ADDRESS_COUNTER_MASK             (0x7FU)
+#define   LINE_LENGTH                      (40U)
+#define   ONE_LINE_LENGTH                  (80U)
+#define   SECOND_LINE_ADDRESS              (0x40U)
+#define   CGRAM_ADDRESS_MASK               (0x3FU)
+#define   SPACE_CHARACTER                  (0x20U)
+#define   REGISTERS_PER_PORT               (3U)
+#define   PORTS_COUNT                      (4U)
+#define   REPORTED_VIOLATIONS_MAX          (20U)
+
+/* The instructions, tested from the highest bit down: */
+#define   SET_DDRAM_ADDRESS                (0x80U)
+#define   SET_CGRAM_ADDRESS                (0x40U)
+#define   FUNCTION_SET                     (0x20U)
+#define   CURSOR_OR_DISPLAY_SHIFT          (0x10U)
+#define   DISPLAY_CONTROL                  (0x08U)
+#define   ENTRY_MODE_SET                   (0x04U)
+#define   RETURN_HOME                      (0x02U)
+#define   CLEAR_DISPLAY                    (0x01U)
+#define   FUNCTION_SET_EIGHT_BITS          (0x10U)
+#define   FUNCTION_SET_TWO_LINES           (0x08U)
+#define   SHIFT_DISPLAY                    (0x08U)
+#define   SHIFT_RIGHT                      (0x04U)
+#define   DISPLAY_ON                       (0x04U)
+#define   CURSOR_ON                        (0x02U)
+#define   BLINK_ON                         (0x01U)
+#define   ENTRY_INCREMENT                  (0x02U)
+#define   ENTRY_SHIFT                      (0x01U)
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+typedef struct
+{
+	host_hd44780_state_t      state;
+	host_hd44780_statistics_t statistics;
+	uint64_t power_on_ns;
+	uint64_t busy_until_ns;
+	uint64_t enable_rise_ns;
+	uint8_t  enable_rise_seen;      /* enable_rise_ns holds a rising edge. */
+	uint8_t  nibble_pending;        /* The high nibble of a 4 bit transfer went, the low one is next. */
+	uint8_t  nibble_ignored;        /* The high nibble was written while busy, so the whole byte is ignored. */
+	uint8_t  high_nibble;
+	uint8_t  read_value;            /* What the controller drives on DB0-DB7 during a read. */
+	uint8_t  function_sets_count;   /* Up to WAKEUP_INSTRUCTIONS_COUNT + 1, for the wake-up sequence. */
+	uint8_t  busy_flag_checkable;   /* The function set after the wake-up sequence has been executed. */
+} controller_t;
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static host_hd44780_wiring_t g_wiring;
+static controller_t g_controllers[HOST_HD44780_MAX_DISPLAYS];
+static uint8_t g_powered;
+static uint8_t g_reported_violations;
+
+/* The port registers as last seen, and the levels of the LCD pins they give: */
+static uint8_t g_port_registers[PORTS_COUNT * REGISTERS_PER_PORT];
+static uint8_t g_register_select;
+static uint8_t g_read_write;
+static uint8_t g_data;
+static uint8_t g_enable[HOST_HD44780_MAX_DISPLAYS];
+static uint64_t g_address_change_ns;
+static uint64_t g_data_change_ns;
+static uint64_t g_previous_access_ns;
+
+/*********************************************************************************************************************
+                                         << Private Function Declarations >>
+*********************************************************************************************************************/
+static void registers_check(void);
+static void bus_update(uint64_t time_ns);
+static void enable_rise(uint8_t display, uint64_t time_ns);
+static void enable_fall(uint8_t display, uint64_t time_ns, uint8_t register_select, uint8_t read_write, uint8_t data);
+static void write_latch(uint8_t display, uint64_t time_ns, uint8_t register_select, uint8_t data);
+static void instruction_execute(uint8_t display, uint64_t time_ns, uint8_t instruction);
+static void data_write(uint8_t display, uint64_t time_ns, uint8_t data);
+static void address_counter_move(controller_t* controller, uint8_t increment);
+static void display_shift(controller_t* controller, uint8_t left);
+static void pin_register_refresh(host_io_t io_register, uint64_t time_ns);
+static uint8_t pin_level(host_io_t port, uint8_t pin);
+static uint8_t data_pins_read(void);
+static uint8_t data_bits_mask(uint8_t display);
+static uint8_t data_port_pins_mask(uint8_t display);
+static void violation_report(uint8_t display, uint64_t time_ns, const char* format, ...)
+	__attribute__((format(printf, 3, 4)));
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  host_hd44780_power_on
+*
+** Description:
+*  This function connects the controllers to the given pins and powers them on at the current virtual time, in the
+*  state the internal reset leaves: 8 bit interface, one line, display off, DDRAM filled with spaces and the address
+*  counter at 0. Call it after host_reset() and before the driver initializes the LCD.
+*
+** Input Parameters:
+*  - wiring: const host_hd44780_wiring_t*
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_hd44780_power_on(const host_hd44780_wiring_t* wiring)
+{
+	uint64_t now = host_time_ns();
+	
+	g_wiring = *wiring;
+	memset(g_controllers, 0, sizeof(g_controllers));
+	for (uint8_t display = 0; display < g_wiring.displays_count; display++)
+	{
+		memset(g_controllers[display].state.ddram, SPACE_CHARACTER, HOST_HD44780_DDRAM_SIZE);
+		g_controllers[display].state.increment = 1;
+		g_controllers[display].state.eight_bit_interface = 1;
+		g_controllers[display].power_on_ns = now;
+	}
+	
+	memcpy(g_port_registers, (const void*)&host_io[HOST_PORTA], sizeof(g_port_registers));
+	g_register_select = pin_level(g_wiring.register_select.port, g_wiring.register_select.pin);
+	g_read_write = pin_level(g_wiring.read_write.port, g_wiring.read_write.pin);
+	g_data = data_pins_read();
+	for (uint8_t display = 0; display < g_wiring.displays_count; display++)
+	{
+		g_enable[display] = pin_level(g_wiring.enable[display].port, g_wiring.enable[display].pin);
+	}
+	g_address_change_ns = now;
+	g_data_change_ns = now;
+	g_previous_access_ns = now;
+	g_reported_violations = 0;
+	g_powered = 1;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_hd44780_io_listener
+*
+** Description:
+*  This function is the register access listener of the model. The port registers are compared with their last
+*  values, a change is handed to the controllers with the time of the access that made it, and a PINx register about
+*  to be read gets the levels the controllers drive.
+*
+** Input Parameters:
+*  - io_register: host_io_t
+*    The register about to be accessed, or HOST_IO_REGISTERS_COUNT during a delay.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_hd44780_io_listener(host_io_t io_register)
+{
+	uint64_t now = host_time_ns();
+	
+	if (!g_powered)
+	{
+		return;
+	}
+	
+	registers_check();
+	
+	if ((HOST_PIND >= io_register) && ((REGISTERS_PER_PORT - 1U) == ((io_register - HOST_PORTA) % REGISTERS_PER_PORT)))
+	{
+		pin_register_refresh(io_register, now);
+	}
+	
+	g_previous_access_ns = now;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_hd44780_state_get
+*
+** Description:
+*  This function gives the memories and the mode bits of a controller.
+*
+** Input Parameters:
+*  - display: uint8_t
+*  - state: host_hd44780_state_t*
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_hd44780_state_get(uint8_t display, host_hd44780_state_t* state)
+{
+	registers_check();
+	*state = g_controllers[display].state;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_hd44780_line_get
+*
+** Description:
+*  This function gives the characters a line of the LCD shows, after the display shift. Lines 0 and 1 start at the
+*  DDRAM addresses 0x00 and 0x40, and lines 2 and 3 of 4 line LCDs continue them after the visible columns. The
+*  character codes are copied as they are, so CGRAM characters read as 0x00 to 0x07.
+*
+** Input Parameters:
+*  - display: uint8_t
+*  - line: uint8_t
+*  - columns: uint8_t
+*    The visible columns of the LCD.
+*  - text: char*
+*    Receives the 'columns' characters and a terminating zero.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_hd44780_line_get(uint8_t display, uint8_t line, uint8_t columns, char* text)
+{
+	const host_hd44780_state_t* state = &g_controllers[display].state;
+	uint8_t line_address = (line & 0x01U) ? SECOND_LINE_ADDRESS : 0x00U;
+	uint8_t first_column = (line & 0x02U) ? columns : 0U;
+	uint8_t address;
+	
+	registers_check();
+	for (uint8_t column = 0; column < columns; column++)
+	{
+		if (state->two_lines)
+		{
+			address = line_address + ((first_column + column + state->shift_offset) % LINE_LENGTH);
+		}
+		else
+		{
+			address = (first_column + column + state->shift_offset) % ONE_LINE_LENGTH;
+			address = (LINE_LENGTH <= address) ? (address - LINE_LENGTH + SECOND_LINE_ADDRESS) : address;
+		}
+		text[column] = (char)state->ddram[address];
+	}
+	text[columns] = '\0';
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_hd44780_statistics_get
+*
+** Description:
+*  This function gives the transfer counts of a controller since it was powered on or the counts were cleared.
+*
+** Input Parameters:
+*  - display: uint8_t
+*  - statistics: host_hd44780_statistics_t*
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_hd44780_statistics_get(uint8_t display, host_hd44780_statistics_t* statistics)
+{
+	registers_check();
+	*statistics = g_controllers[display].statistics;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_hd44780_statistics_clear
+*
+** Description:
+*  This function clears the transfer counts of all the controllers, so a test can count the transfers of one
+*  operation.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_hd44780_statistics_clear(void)
+{
+	registers_check();
+	for (uint8_t display = 0; display < HOST_HD44780_MAX_DISPLAYS; display++)
+	{
+		memset(&g_controllers[display].statistics, 0, sizeof(g_controllers[display].statistics));
+	}
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+/* Takes the last register write, which the listener sees only at the next access, so the getters see it too: */
+static void registers_check(void)
+{
+	if (g_powered && (0 != memcmp(g_port_registers, (const void*)&host_io[HOST_PORTA], sizeof(g_port_registers))))
+	{
+		memcpy(g_port_registers, (const void*)&host_io[HOST_PORTA], sizeof(g_port_registers));
+		bus_update(g_previous_access_ns);
+	}
+}
+
+/* Hands a change of the LCD pins to the controllers. A falling edge latches the levels from before the change, and
+   the RS, RW or data pins changing with it break their hold time: */
+static void bus_update(uint64_t time_ns)
+{
+	uint8_t register_select = pin_level(g_wiring.register_select.port, g_wiring.register_select.pin);
+	uint8_t read_write = pin_level(g_wiring.read_write.port, g_wiring.read_write.pin);
+	uint8_t data = data_pins_read();
+	uint8_t address_changed = (register_select != g_register_select) || (read_write != g_read_write);
+	uint8_t enable;
+	
+	for (uint8_t display = 0; display < g_wiring.displays_count; display++)
+	{
+		enable = pin_level(g_wiring.enable[display].port, g_wiring.enable[display].pin);
+		if (g_enable[display] && !enable)
+		{
+			if (address_changed)
+			{
+				violation_report(display, time_ns, "RS or RW changed with the enable falling edge (tAH %llu ns)",
+				                 ADDRESS_HOLD_TIME_MIN_NS);
+			}
+			if ((!g_read_write) && ((data ^ g_data) & data_bits_mask(display)))
+			{
+				violation_report(display, time_ns, "the data changed with the enable falling edge (tH %llu ns)",
+				                 DATA_HOLD_TIME_MIN_NS);
+			}
+			enable_fall(display, time_ns, g_register_select, g_read_write, g_data);
+		}
+		else if (g_enable[display] && address_changed)
+		{
+			violation_report(display, time_ns, "RS or RW changed while the enable pin is high");
+		}
+	}
+	
+	if (address_changed)
+	{
+		g_address_change_ns = time_ns;
+	}
+	if (data != g_data)
+	{
+		g_data_change_ns = time_ns;
+	}
+	g_register_select = register_select;
+	g_read_write = read_write;
+	g_data = data;
+	
+	for (uint8_t display = 0; display < g_wiring.displays_count; display++)
+	{
+		enable = pin_level(g_wiring.enable[display].port, g_wiring.enable[display].pin);
+		if (!g_enable[display] && enable)
+		{
+			enable_rise(display, time_ns);
+		}
+		g_enable[display] = enable;
+		
+		/* The controller drives the data pins during a read, the pins left as outputs fight it: */
+		if (enable && read_write && (host_io[g_wiring.data_port + 1U] & data_port_pins_mask(display)))
+		{
+			violation_report(display, time_ns, "the data pins are outputs while the LCD drives them");
+		}
+	}
+}
+
+/* Checks the timings up to a rising edge, and sets what a read drives on the data pins: */
+static void enable_rise(uint8_t display, uint64_t time_ns)
+{
+	controller_t* controller = &g_controllers[display];
+	
+	controller->statistics.enable_pulses++;
+	if (controller->enable_rise_seen && ((time_ns - controller->enable_rise_ns) < ENABLE_CYCLE_TIME_MIN_NS))
+	{
+		violation_report(display, time_ns, "enable cycle of %llu ns (tcycE %llu ns)",
+		                 (unsigned long long)(time_ns - controller->enable_rise_ns), ENABLE_CYCLE_TIME_MIN_NS);
+	}
+	if ((time_ns - g_address_change_ns) < ADDRESS_SETUP_TIME_MIN_NS)
+	{
+		violation_report(display, time_ns, "RS or RW set %llu ns before the enable rising edge (tAS %llu ns)",
+		                 (unsigned long long)(time_ns - g_address_change_ns), ADDRESS_SETUP_TIME_MIN_NS);
+	}
+	controller->enable_rise_ns = time_ns;
+	controller->enable_rise_seen = 1;
+	
+	if (!g_read_write)
+	{
+		return;
+	}
+	
+	if ((time_ns - controller->power_on_ns) < POWER_ON_TIME_NS)
+	{
+		violation_report(display, time_ns, "read during the power-on reset");
+	}
+	else if (!controller->busy_flag_checkable)
+	{
+		violation_report(display, time_ns, "read before the function set that follows the wake-up sequence");
+	}
+	
+	if (!g_register_select)
+	{
+		controller->read_value = controller->state.address_counter & ADDRESS_COUNTER_MASK;
+		if (time_ns < controller->busy_until_ns)
+		{
+			controller->read_value |= BUSY_FLAG;
+		}
+		if (!controller->nibble_pending)
+		{
+			controller->statistics.busy_flag_reads++;
+		}
+	}
+	else
+	{
+		if (time_ns < controller->busy_until_ns)
+		{
+			violation_report(display, time_ns, "data read while busy");
+		}
+		controller->read_value = controller->state.address_in_cgram ?
+		                         controller->state.cgram[controller->state.address_counter & CGRAM_ADDRESS_MASK] :
+		                         controller->state.ddram[controller->state.address_counter];
+	}
+	
+	/* The high nibble comes first in 4 bit mode, on DB4-DB7: */
+	if ((!controller->state.eight_bit_interface) && controller->nibble_pending)
+	{
+		controller->read_value = (uint8_t)(controller->read_value << HALF_BYTE);
+	}
+}
+
+/* Checks the timings up to a falling edge, and latches a write or ends a read: */
+static void enable_fall(uint8_t display, uint64_t time_ns, uint8_t register_select, uint8_t read_write, uint8_t data)
+{
+	controller_t* controller = &g_controllers[display];
+	
+	if ((time_ns - controller->enable_rise_ns) < ENABLE_PULSE_WIDTH_MIN_NS)
+	{
+		violation_report(display, time_ns, "enable pulse of %llu ns (PWEH %llu ns)",
+		                 (unsigned long long)(time_ns - controller->enable_rise_ns), ENABLE_PULSE_WIDTH_MIN_NS);
+	}
+	
+	if (!read_write)
+	{
+		if ((time_ns - g_data_change_ns) < DATA_SETUP_TIME_MIN_NS)
+		{
+			violation_report(display, time_ns, "data set %llu ns before the enable falling edge (tDSW %llu ns)",
+			                 (unsigned long long)(time_ns - g_data_change_ns), DATA_SETUP_TIME_MIN_NS);
+		}
+		write_latch(display, time_ns, register_select, data);
+	}
+	else if (controller->state.eight_bit_interface || controller->nibble_pending)
+	{
+		/* A data read moves the address counter like a write, once the whole byte is read: */
+		if (register_select)
+		{
+			address_counter_move(controller, controller->state.increment);
+		}
+		controller->nibble_pending = 0;
+	}
+	else
+	{
+		controller->nibble_pending = 1;
+	}
+}
+
+/* Takes a byte in 8 bit mode, or a nibble on DB4-DB7 in 4 bit mode: */
+static void write_latch(uint8_t display, uint64_t time_ns, uint8_t register_select, uint8_t data)
+{
+	controller_t* controller = &g_controllers[display];
+	uint8_t ignored = 0;
+	
+	if ((time_ns - controller->power_on_ns) < POWER_ON_TIME_NS)
+	{
+		violation_report(display, time_ns, "written %llu us after power-on (%llu us needed)",
+		                 (unsigned long long)((time_ns - controller->power_on_ns) / 1000ULL),
+		                 POWER_ON_TIME_NS / 1000ULL);
+		ignored = 1;
+	}
+	else if (time_ns < controller->busy_until_ns)
+	{
+		violation_report(display, time_ns, "written %llu us before the previous instruction finished",
+		                 (unsigned long long)((controller->busy_until_ns - time_ns + 999ULL) / 1000ULL));
+		ignored = 1;
+	}
+	
+	if (!controller->state.eight_bit_interface)
+	{
+		if (!controller->nibble_pending)
+		{
+			controller->high_nibble = data & HIGH_NIBBLE_MASK;
+			controller->nibble_ignored = ignored;
+			controller->nibble_pending = 1;
+			return;
+		}
+		data = controller->high_nibble | (uint8_t)(data >> HALF_BYTE);
+		ignored |= controller->nibble_ignored;
+		controller->nibble_pending = 0;
+	}
+	
+	/* The controller doesn't take transfers while it's busy: */
+	if (ignored)
+	{
+		return;
+	}
+	
+	if (register_select)
+	{
+		data_write(display, time_ns, data);
+	}
+	else
+	{
+		instruction_execute(display, time_ns, data);
+	}
+}
+
+static void instruction_execute(uint8_t display, uint64_t time_ns, uint8_t instruction)
+{
+	controller_t* controller = &g_controllers[display];
+	host_hd44780_state_t* state = &controller->state;
+	uint64_t execution_time_ns = SHORT_EXECUTION_TIME_NS;
+	uint8_t eight_bit_interface;
+	
+	controller->statistics.instructions++;
+	
+	if (instruction & SET_DDRAM_ADDRESS)
+	{
+		state->address_counter = instruction & ADDRESS_COUNTER_MASK;
+		state->address_in_cgram = 0;
+		if (state->two_lines && ((state->address_counter & (SECOND_LINE_ADDRESS - 1U)) >= LINE_LENGTH))
+		{
+			violation_report(display, time_ns, "DDRAM address 0x%02X isn't on a line", state->address_counter);
+		}
+	}
+	else if (instruction & SET_CGRAM_ADDRESS)
+	{
+		state->address_counter = instruction & CGRAM_ADDRESS_MASK;
+		state->address_in_cgram = 1;
+	}
+	else if (instruction & FUNCTION_SET)
+	{
+		eight_bit_interface = (0U != (instruction & FUNCTION_SET_EIGHT_BITS));
+		/* The wake-up sequence: the first two function sets take longer, and the busy flag can be read after the
+		   function set that comes after the three wake-up instructions, once the interface width stays the same: */
+		if (0U == controller->function_sets_count)
+		{
+			execution_time_ns = WAKEUP_FIRST_EXECUTION_TIME_NS;
+		}
+		else if (1U == controller->function_sets_count)
+		{
+			execution_time_ns = WAKEUP_SECOND_EXECUTION_TIME_NS;
+		}
+		else if ((WAKEUP_INSTRUCTIONS_COUNT <= controller->function_sets_count) &&
+		         (eight_bit_interface == state->eight_bit_interface))
+		{
+			controller->busy_flag_checkable = 1;
+		}
+		if (WAKEUP_INSTRUCTIONS_COUNT >= controller->function_sets_count)
+		{
+			controller->function_sets_count++;
+		}
+		state->eight_bit_interface = eight_bit_interface;
+		state->two_lines = (0U != (instruction & FUNCTION_SET_TWO_LINES));
+	}
+	else if (instruction & CURSOR_OR_DISPLAY_SHIFT)
+	{
+		if (instruction & SHIFT_DISPLAY)
+		{
+			display_shift(controller, !(instruction & SHIFT_RIGHT));
+		}
+		else
+		{
+			address_counter_move(controller, (0U != (instruction & SHIFT_RIGHT)));
+		}
+	}
+	else if (instruction & DISPLAY_CONTROL)
+	{
+		state->display_on = (0U != (instruction & DISPLAY_ON));
+		state->cursor_on = (0U != (instruction & CURSOR_ON));
+		state->blink_on = (0U != (instruction & BLINK_ON));
+	}
+	else if (instruction & ENTRY_MODE_SET)
+	{
+		state->increment = (0U != (instruction & ENTRY_INCREMENT));
+		state->display_shift = (0U != (instruction & ENTRY_SHIFT));
+	}
+	else if (instruction & RETURN_HOME)
+	{
+		state->address_counter = 0;
+		state->address_in_cgram = 0;
+		state->shift_offset = 0;
+		execution_time_ns = LONG_EXECUTION_TIME_NS;
+	}
+	else if (instruction & CLEAR_DISPLAY)
+	{
+		memset(state->ddram, SPACE_CHARACTER, HOST_HD44780_DDRAM_SIZE);
+		state->address_counter = 0;
+		state->address_in_cgram = 0;
+		state->shift_offset = 0;
+		state->increment = 1;
+		execution_time_ns = LONG_EXECUTION_TIME_NS;
+	}
+	else
+	{
+		violation_report(display, time_ns, "instruction 0x00 isn't defined");
+	}
+	
+	controller->busy_until_ns = time_ns + execution_time_ns;
+}
+
+static void data_write(uint8_t display, uint64_t time_ns, uint8_t data)
+{
+	controller_t* controller = &g_controllers[display];
+	host_hd44780_state_t* state = &controller->state;
+	
+	controller->statistics.data_writes++;
+	
+	if (state->address_in_cgram)
+	{
+		state->cgram[state->address_counter & CGRAM_ADDRESS_MASK] = data;
+	}
+	else
+	{
+		state->ddram[state->address_counter] = data;
+		if (state->display_shift)
+		{
+			display_shift(controller, state->increment);
+		}
+	}
+	address_counter_move(controller, state->increment);
+	
+	controller->busy_until_ns = time_ns + SHORT_EXECUTION_TIME_NS;
+}
+
+/* The DDRAM address counter skips the gaps between the lines: 0x27 is followed by 0x40 and 0x67 by 0x00 with two
+   lines, and 0x4F by 0x00 with one line: */
+static void address_counter_move(controller_t* controller, uint8_t increment)
+{
+	host_hd44780_state_t* state = &controller->state;
+	uint8_t line_address;
+	uint8_t column;
+	
+	if (state->address_in_cgram)
+	{
+		state->address_counter = (uint8_t)(state->address_counter + (increment ? 1U : -1U)) & CGRAM_ADDRESS_MASK;
+	}
+	else if (state->two_lines)
+	{
+		line_address = state->address_counter & SECOND_LINE_ADDRESS;
+		column = state->address_counter & (SECOND_LINE_ADDRESS - 1U);
+		if (increment)
+		{
+			column++;
+			if (LINE_LENGTH <= column)
+			{
+				column = 0;
+				line_address ^= SECOND_LINE_ADDRESS;
+			}
+		}
+		else
+		{
+			if (0U == column)
+			{
+				column = LINE_LENGTH;
+				line_address ^= SECOND_LINE_ADDRESS;
+			}
+			column--;
+		}
+		state->address_counter = line_address | column;
+	}
+	else
+	{
+		state->address_counter = increment ? ((state->address_counter + 1U) % ONE_LINE_LENGTH) :
+		                         ((state->address_counter + ONE_LINE_LENGTH - 1U) % ONE_LINE_LENGTH);
+	}
+}
+
+static void display_shift(controller_t* controller, uint8_t left)
+{
+	uint8_t length = controller->state.two_lines ? LINE_LENGTH : ONE_LINE_LENGTH;
+	
+	controller->state.shift_offset = left ? ((controller->state.shift_offset + 1U) % length) :
+	                                 ((controller->state.shift_offset + length - 1U) % length);
+}
+
+/* Gives a PINx register the levels of its pins: the outputs and pull-ups set in PORTx, and on the data pins the
+   levels driven by a controller being read: */
+static void pin_register_refresh(host_io_t io_register, uint64_t time_ns)
+{
+	host_io_t port = io_register - (REGISTERS_PER_PORT - 1U);
+	uint8_t levels = host_io[port];
+	uint8_t inputs = (uint8_t)~host_io[port + 1U];
+	uint8_t pins_mask;
+	
+	if (port == g_wiring.data_port)
+	{
+		for (uint8_t display = 0; display < g_wiring.displays_count; display++)
+		{
+			if (!(g_enable[display] && g_read_write))
+			{
+				continue;
+			}
+			if ((time_ns - g_controllers[display].enable_rise_ns) < DATA_DELAY_TIME_MAX_NS)
+			{
+				violation_report(display, time_ns, "data read %llu ns after the enable rising edge (tDDR %llu ns)",
+				                 (unsigned long long)(time_ns - g_controllers[display].enable_rise_ns),
+				                 DATA_DELAY_TIME_MAX_NS);
+			}
+			pins_mask = inputs & data_port_pins_mask(display);
+			for (uint8_t bit = 0; bit < DATA_BITS_COUNT; bit++)
+			{
+				if ((HOST_HD44780_NOT_CONNECTED != g_wiring.data_pins[bit]) &&
+				    (pins_mask & (1U << g_wiring.data_pins[bit])))
+				{
+					levels &= (uint8_t)~(1U << g_wiring.data_pins[bit]);
+					levels |= (uint8_t)(((g_controllers[display].read_value >> bit) & 0x01U) << g_wiring.data_pins[bit]);
+				}
+			}
+		}
+	}
+	
+	host_io[io_register] = levels;
+}
+
+static uint8_t pin_level(host_io_t port, uint8_t pin)
+{
+	return (HOST_HD44780_NOT_CONNECTED == pin) ? 0U : ((host_io[port] >> pin) & 0x01U);
+}
+
+/* The levels on DB0-DB7, the open pins read 0: */
+static uint8_t data_pins_read(void)
+{
+	uint8_t data = 0;
+	
+	for (uint8_t bit = 0; bit < DATA_BITS_COUNT; bit++)
+	{
+		if (HOST_HD44780_NOT_CONNECTED != g_wiring.data_pins[bit])
+		{
+			data |= (uint8_t)(pin_level(g_wiring.data_port, g_wiring.data_pins[bit]) << bit);
+		}
+	}
+	
+	return data;
+}
+
+/* The data bits a controller uses in its interface width: */
+static uint8_t data_bits_mask(uint8_t display)
+{
+	return g_controllers[display].state.eight_bit_interface ? 0xFFU : HIGH_NIBBLE_MASK;
+}
+
+/* The port pins of those data bits: */
+static uint8_t data_port_pins_mask(uint8_t display)
+{
+	uint8_t bits_mask = data_bits_mask(display);
+	uint8_t pins_mask = 0;
+	
+	for (uint8_t bit = 0; bit < DATA_BITS_COUNT; bit++)
+	{
+		if ((HOST_HD44780_NOT_CONNECTED != g_wiring.data_pins[bit]) && (bits_mask & (1U << bit)))
+		{
+			pins_mask |= (uint8_t)(1U << g_wiring.data_pins[bit]);
+		}
+	}
+	
+	return pins_mask;
+}
+
+static void violation_report(uint8_t display, uint64_t time_ns, const char* format, ...)
+{
+	va_list arguments;
+	
+	g_controllers[display].statistics.violations++;
+	if (REPORTED_VIOLATIONS_MAX > g_reported_violations)
+	{
+		g_reported_violations++;
+		va_start(arguments, format);
+		fprintf(stderr, "hd44780 %u at %llu.%03llu us: ", display, (unsigned long long)(time_ns / 1000ULL),
+		        (unsigned long long)(time_ns % 1000ULL));
+		vfprintf(stderr, format, arguments);
+		fputc('\n', stderr);
+		va_end(arguments);
+	}
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,120 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_hd44780.h
+*
+** Description:
+*  This file contains the interface of a behavioural model of HD44780 LCD controllers wired to the port registers of
+*  the host build. The model records the pin changes the driver under test makes, decodes the 8 bit and 4 bit bus
+*  transfers on the falling edges of each enable pin, keeps the DDRAM, CGRAM, address counter and mode bits of each
+*  controller, and drives the data pins with the busy flag and address counter on reads.
+*  Every transfer is checked against the minimum timings of the HD44780U datasheet (VCC 4.5 V to 5.5 V), against
+*  the execution time of the previous instruction and against the power-on reset, and each violation is reported.
+*
+*  The model is driven by the register accesses of the code under test: host_hd44780_io_listener() has to be called
+*  from the listener set by host_io_listener_set(), or set as that listener directly. A pin change is stamped with the
+*  time of the register access that made it, so the timings are as exact as the virtual clock of "host_avr.h".
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef HOST_HD44780_H_
+#define HOST_HD44780_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "host_avr.h"
+
+/*********************************************************************************************************************
+                                               << Public Constants >>
+*********************************************************************************************************************/
+#define   HOST_HD44780_MAX_DISPLAYS       (3U)
+/* A data pin left open, like DB0-DB3 in 4 bit wiring, or the RW pin tied to ground: */
+#define   HOST_HD44780_NOT_CONNECTED      (0xFFU)
+#define   HOST_HD44780_DDRAM_SIZE         (0x80U)
+#define   HOST_HD44780_CGRAM_SIZE         (0x40U)
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+/* A pin is a port, given by its PORTx register, and a pin number. The DDRx and PINx registers follow PORTx: */
+typedef struct
+{
+	host_io_t port;
+	uint8_t   pin;
+} host_hd44780_pin_t;
+
+/* The controllers share the data, RS and RW pins, and each one has its own enable pin: */
+typedef struct
+{
+	host_io_t          data_port;
+	uint8_t            data_pins[8];  /* The pins of DB0 to DB7, or HOST_HD44780_NOT_CONNECTED. */
+	host_hd44780_pin_t register_select;
+	host_hd44780_pin_t read_write;      /* Its pin can be HOST_HD44780_NOT_CONNECTED, then the LCD is never read. */
+	host_hd44780_pin_t enable[HOST_HD44780_MAX_DISPLAYS];
+	uint8_t            displays_count;
+} host_hd44780_wiring_t;
+
+typedef struct
+{
+	uint8_t ddram[HOST_HD44780_DDRAM_SIZE];
+	uint8_t cgram[HOST_HD44780_CGRAM_SIZE];
+	uint8_t address_counter;
+	uint8_t address_in_cgram;   /* The last address set was a CGRAM address. */
+	uint8_t increment;          /* Entry mode I/D. */
+	uint8_t display_shift;      /* Entry mode S. */
+	uint8_t display_on;
+	uint8_t cursor_on;
+	uint8_t blink_on;
+	uint8_t eight_bit_interface;
+	uint8_t two_lines;
+	uint8_t shift_offset;       /* How many places the display is shifted left, 0 to 39. */
+} host_hd44780_state_t;
+
+typedef struct
+{
+	uint32_t instructions;      /* Instructions executed. */
+	uint32_t data_writes;       /* Characters and CGRAM rows written. */
+	uint32_t busy_flag_reads;   /* Reads of the busy flag and address counter. */
+	uint32_t enable_pulses;
+	uint32_t violations;        /* Timing violations and transfers the controller ignored. */
+} host_hd44780_statistics_t;
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+extern void host_hd44780_power_on(const host_hd44780_wiring_t* wiring);
+
+extern void host_hd44780_io_listener(host_io_t io_register);
+
+extern void host_hd44780_state_get(uint8_t display, host_hd44780_state_t* state);
+
+extern void host_hd44780_line_get(uint8_t display, uint8_t line, uint8_t columns, char* text);
+
+extern void host_hd44780_statistics_get(uint8_t display, host_hd44780_statistics_t* statistics);
+
+extern void host_hd44780_statistics_clear(void);
+
+
+#endif /* HOST_HD44780_H_ */
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,537 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_twi.c
+*
+** Description:
+*  This file contains the implementation of the TWI model. It keeps the bus action in progress, with the TWCR and
+*  TWDR values it was started with and the time it ends, and the state of the bus: whether the master holds it, and
+*  which slave it addressed in which direction.
+*  The bus time of an action is counted in SCL periods of the bit rate in TWBR and TWSR: one for a START or a STOP,
+*  and nine for a byte with its acknowledge bit.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <avr/io.h>
+#include "host_avr.h"
+#include "host_twi.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   GLOBAL_INTERRUPT_ENABLE      (0x80U)
+#define   MAX_RUN_STEPS                (10000U)
+
+#define   SCL_FIXED_CLOCK_CYCLES       (16ULL)
+#define   BYTE_SCL_PERIODS             (9ULL)     /* 8 data bits and the acknowledge bit. */
+#define   NANOSECONDS_PER_SECOND       (1000000000ULL)
+
+/* The status codes of the master modes, in the upper 5 bits of TWSR: */
+#define   STATUS_PRESCALER_MASK        (0x07U)
+#define   START_SENT                   (0x08U)
+#define   REPEATED_START_SENT          (0x10U)
+#define   ADDRESS_WRITE_ACK            (0x18U)
+#define   ADDRESS_WRITE_NACK           (0x20U)
+#define   DATA_SENT_ACK                (0x28U)
+#define   DATA_SENT_NACK               (0x30U)
+#define   ADDRESS_READ_ACK             (0x40U)
+#define   ADDRESS_READ_NACK            (0x48U)
+#define   DATA_RECEIVED_ACK            (0x50U)
+#define   DATA_RECEIVED_NACK           (0x58U)
+
+#define   READ_DIRECTION_BIT           (0x01U)
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+/* What the next byte on the bus is: */
+typedef enum
+{
+	PHASE_NONE,       /* No byte can be sent, after a refused address or the last byte read. */
+	PHASE_ADDRESS,
+	PHASE_WRITE,
+	PHASE_READ
+} phase_t;
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static host_twi_slave_t* g_slaves[HOST_TWI_MAX_SLAVES];
+static uint8_t g_slaves_count;
+
+static uint8_t g_bus_owned;
+static phase_t g_phase;
+static host_twi_slave_t* g_slave;
+
+static uint8_t g_action_pending;
+static uint8_t g_action_twcr;
+static uint8_t g_action_twdr;
+static uint64_t g_action_end_ns;
+
+/* TWINT, as the hardware sets it. The host register bit is kept at 0: */
+static uint8_t g_flag;
+static uint8_t g_in_interrupt;
+
+static char g_trace[HOST_TWI_TRACE_SIZE];
+static uint16_t g_trace_length;
+static uint16_t g_errors;
+
+/*********************************************************************************************************************
+                                         << Private Function Declarations >>
+*********************************************************************************************************************/
+static void action_check(void);
+static void action_execute(void);
+static void interrupt_check(void);
+static uint64_t scl_periods_ns(uint64_t periods);
+static host_twi_slave_t* slave_find(uint8_t address);
+static void trace_add(const char* token);
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  host_twi_power_on
+*
+** Description:
+*  This function resets the model, with a free bus, no slaves and an empty trace. Call it after host_reset().
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_twi_power_on(void)
+{
+	g_slaves_count = 0;
+	g_bus_owned = 0;
+	g_phase = PHASE_NONE;
+	g_slave = NULL;
+	g_action_pending = 0;
+	g_flag = 0;
+	g_in_interrupt = 0;
+	g_errors = 0;
+	host_twi_trace_clear();
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_twi_slave_attach
+*
+** Description:
+*  This function puts a slave on the bus and clears its counters. Up to HOST_TWI_MAX_SLAVES slaves can be attached.
+*
+** Input Parameters:
+*  - slave: host_twi_slave_t*
+*    The slave, which is used by the model until the next host_twi_power_on().
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_twi_slave_attach(host_twi_slave_t* slave)
+{
+	if (HOST_TWI_MAX_SLAVES > g_slaves_count)
+	{
+		slave->written_count = 0;
+		slave->read_count = 0;
+		slave->transfers = 0;
+		slave->transfer_bytes = 0;
+		g_slaves[g_slaves_count] = slave;
+		g_slaves_count++;
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_twi_io_listener
+*
+** Description:
+*  This function is the register access listener of the model. A bus action starts when TWINT is found set, which is
+*  before the access that follows the write, so TWDR is taken as it was when TWINT was written. The action in
+*  progress completes on the first call after its bus time, and its interrupt is raised then, or later when the I
+*  bit is set again. While TWI_vect runs, the model only takes the actions it starts.
+*
+** Input Parameters:
+*  - io_register: host_io_t
+*    The register about to be accessed, or HOST_IO_REGISTERS_COUNT during a delay.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_twi_io_listener(host_io_t io_register)
+{
+	(void)io_register;
+	
+	action_check();
+	if (g_in_interrupt)
+	{
+		return;
+	}
+	
+	if (g_action_pending && (host_time_ns() >= g_action_end_ns))
+	{
+		action_execute();
+	}
+	interrupt_check();
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_twi_step
+*
+** Description:
+*  This function completes the bus action in progress at once, without waiting for its bus time, and runs TWI_vect
+*  for it, which usually starts the next action.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 if an action was in progress, and 0 otherwise.
+*********************************************************************************************************************/
+uint8_t host_twi_step(void)
+{
+	action_check();
+	if (!g_action_pending)
+	{
+		return 0;
+	}
+	
+	action_execute();
+	interrupt_check();
+	
+	return 1;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_twi_run
+*
+** Description:
+*  This function steps the model until no bus action is in progress, as when all the queued transactions finished.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint16_t
+*    The number of actions completed, at most MAX_RUN_STEPS, which would be a driver that never stops.
+*********************************************************************************************************************/
+uint16_t host_twi_run(void)
+{
+	uint16_t steps = 0;
+	
+	while ((MAX_RUN_STEPS > steps) && host_twi_step())
+	{
+		steps++;
+	}
+	
+	return steps;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_twi_trace_get
+*
+** Description:
+*  This function returns the bus events since the trace was cleared, as described in "host_twi.h".
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - const char*
+*    The trace, ending with a null character. Events that don't fit in HOST_TWI_TRACE_SIZE are left out.
+*********************************************************************************************************************/
+const char* host_twi_trace_get(void)
+{
+	return g_trace;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_twi_trace_clear
+*
+** Description:
+*  This function empties the trace.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_twi_trace_clear(void)
+{
+	g_trace[0] = '\0';
+	g_trace_length = 0;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_twi_errors_get
+*
+** Description:
+*  This function returns the number of things the driver did that the hardware would not do as intended: an action
+*  written while another one is on the bus, a byte with no transfer to carry it, and the peripheral disabled in the
+*  middle of an action or a transfer, which drops it.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint16_t
+*    The number of errors since host_twi_power_on().
+*********************************************************************************************************************/
+uint16_t host_twi_errors_get(void)
+{
+	return g_errors;
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+static void action_check(void)
+{
+	uint8_t twcr = host_io[HOST_TWCR];
+	
+	if (!(twcr & (1U << TWEN)))
+	{
+		if (g_action_pending || g_bus_owned)
+		{
+			g_errors++;
+		}
+		g_action_pending = 0;
+		g_bus_owned = 0;
+		g_phase = PHASE_NONE;
+		g_slave = NULL;
+		g_flag = 0;
+		return;
+	}
+	
+	if (!(twcr & (1U << TWINT)))
+	{
+		return;
+	}
+	
+	/* Writing 1 clears the flag and starts the action: */
+	host_io[HOST_TWCR] = (uint8_t)(twcr & ~(1U << TWINT));
+	g_flag = 0;
+	
+	if (g_action_pending)
+	{
+		/* TWSTO is kept set until the STOP is sent, so a START can be added to it. Anything else is lost: */
+		if ((g_action_twcr & (1U << TWSTO)) && !(g_action_twcr & (1U << TWSTA)) &&
+		    (twcr & (1U << TWSTO)) && (twcr & (1U << TWSTA)))
+		{
+			g_action_twcr = twcr;
+			g_action_end_ns += scl_periods_ns(1U);
+		}
+		else
+		{
+			g_errors++;
+		}
+		return;
+	}
+	
+	g_action_pending = 1;
+	g_action_twcr = twcr;
+	g_action_twdr = host_io[HOST_TWDR];
+	if (twcr & ((1U << TWSTA) | (1U << TWSTO)))
+	{
+		g_action_end_ns = host_time_ns() + scl_periods_ns(((twcr & (1U << TWSTA)) && (twcr & (1U << TWSTO))) ? 2U : 1U);
+	}
+	else
+	{
+		g_action_end_ns = host_time_ns() + scl_periods_ns(BYTE_SCL_PERIODS);
+	}
+}
+
+static void action_execute(void)
+{
+	uint8_t twcr = g_action_twcr;
+	uint8_t status;
+	uint8_t data_byte;
+	uint8_t acknowledge;
+	char token[8];
+	
+	g_action_pending = 0;
+	
+	if (twcr & (1U << TWSTO))
+	{
+		if (g_bus_owned)
+		{
+			trace_add("P");
+			g_bus_owned = 0;
+			g_phase = PHASE_NONE;
+			g_slave = NULL;
+		}
+		/* The hardware clears TWSTO when the STOP is sent, and sets no flag: */
+		host_io[HOST_TWCR] &= (uint8_t)~(1U << TWSTO);
+		if (!(twcr & (1U << TWSTA)))
+		{
+			return;
+		}
+	}
+	
+	if (twcr & (1U << TWSTA))
+	{
+		trace_add(g_bus_owned ? "Sr" : "S");
+		status = g_bus_owned ? REPEATED_START_SENT : START_SENT;
+		g_bus_owned = 1;
+		g_phase = PHASE_ADDRESS;
+		g_slave = NULL;
+	}
+	else if (!g_bus_owned)
+	{
+		g_errors++;
+		return;
+	}
+	else
+	{
+		switch (g_phase)
+		{
+			case PHASE_ADDRESS:
+			g_slave = slave_find((uint8_t)(g_action_twdr >> 1));
+			acknowledge = (NULL != g_slave) && !g_slave->address_nack;
+			snprintf(token, sizeof(token), "%02X%c%c", g_action_twdr >> 1,
+			         (g_action_twdr & READ_DIRECTION_BIT) ? 'R' : 'W', acknowledge ? '+' : '-');
+			trace_add(token);
+			if (!acknowledge)
+			{
+				g_slave = NULL;
+				g_phase = PHASE_NONE;
+				status = (g_action_twdr & READ_DIRECTION_BIT) ? ADDRESS_READ_NACK : ADDRESS_WRITE_NACK;
+			}
+			else
+			{
+				g_slave->transfers++;
+				g_slave->transfer_bytes = 0;
+				g_phase = (g_action_twdr & READ_DIRECTION_BIT) ? PHASE_READ : PHASE_WRITE;
+				status = (g_action_twdr & READ_DIRECTION_BIT) ? ADDRESS_READ_ACK : ADDRESS_WRITE_ACK;
+			}
+			break;
+			
+			case PHASE_WRITE:
+			g_slave->transfer_bytes++;
+			if (HOST_TWI_SLAVE_BUFFER_SIZE > g_slave->written_count)
+			{
+				g_slave->written[g_slave->written_count] = g_action_twdr;
+			}
+			g_slave->written_count++;
+			if (NULL != g_slave->byte_written)
+			{
+				g_slave->byte_written(g_slave, g_action_twdr);
+			}
+			acknowledge = (g_slave->transfer_bytes != g_slave->data_nack_byte);
+			snprintf(token, sizeof(token), "%02X%c", g_action_twdr, acknowledge ? '+' : '-');
+			trace_add(token);
+			status = acknowledge ? DATA_SENT_ACK : DATA_SENT_NACK;
+			break;
+			
+			case PHASE_READ:
+			data_byte = 0xFFU;
+			if ((NULL != g_slave->read_data) && (0U != g_slave->read_length))
+			{
+				data_byte = g_slave->read_data[g_slave->read_count % g_slave->read_length];
+			}
+			g_slave->read_count++;
+			g_slave->transfer_bytes++;
+			host_io[HOST_TWDR] = data_byte;
+			acknowledge = (twcr & (1U << TWEA)) ? 1U : 0U;
+			snprintf(token, sizeof(token), "r%02X%c", data_byte, acknowledge ? '+' : '-');
+			trace_add(token);
+			if (!acknowledge)
+			{
+				g_phase = PHASE_NONE;
+			}
+			status = acknowledge ? DATA_RECEIVED_ACK : DATA_RECEIVED_NACK;
+			break;
+			
+			case PHASE_NONE:
+			default:
+			g_errors++;
+			return;
+		}
+	}
+	
+	host_io[HOST_TWSR] = (uint8_t)((host_io[HOST_TWSR] & STATUS_PRESCALER_MASK) | status);
+	g_flag = 1;
+}
+
+static void interrupt_check(void)
+{
+	if (g_flag && !g_in_interrupt && (host_io[HOST_TWCR] & (1U << TWIE)) &&
+	    (host_io[HOST_SREG] & GLOBAL_INTERRUPT_ENABLE))
+	{
+		/* The I bit is cleared while the interrupt runs, and set again by its return: */
+		g_in_interrupt = 1;
+		host_io[HOST_SREG] &= (uint8_t)~GLOBAL_INTERRUPT_ENABLE;
+		TWI_vect();
+		host_io[HOST_SREG] |= GLOBAL_INTERRUPT_ENABLE;
+		g_in_interrupt = 0;
+		action_check();
+	}
+}
+
+static uint64_t scl_periods_ns(uint64_t periods)
+{
+	uint64_t scl_cycles = SCL_FIXED_CLOCK_CYCLES +
+	                      (2ULL * host_io[HOST_TWBR] << (2U * (host_io[HOST_TWSR] & STATUS_PRESCALER_MASK & 0x03U)));
+	
+	return (periods * scl_cycles * NANOSECONDS_PER_SECOND) / host_cpu_frequency();
+}
+
+static host_twi_slave_t* slave_find(uint8_t address)
+{
+	for (uint8_t i = 0; i < g_slaves_count; i++)
+	{
+		if (address == g_slaves[i]->address)
+		{
+			return g_slaves[i];
+		}
+	}
+	
+	return NULL;
+}
+
+static void trace_add(const char* token)
+{
+	int length = snprintf(&g_trace[g_trace_length], HOST_TWI_TRACE_SIZE - g_trace_length, "%s%s",
+	                      (0U != g_trace_length) ? " " : "", token);
+	
+	if ((0 < length) && ((g_trace_length + (uint16_t)length) < HOST_TWI_TRACE_SIZE))
+	{
+		g_trace_length += (uint16_t)length;
+	}
+	else
+	{
+		g_trace[g_trace_length] = '\0';
+	}
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
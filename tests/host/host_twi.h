@@ -0,0 +1,105 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_twi.h
+*
+** Description:
+*  This file contains the interface of a model of the ATmega32 TWI in master mode, with slaves on its bus, on the
+*  registers of the host build. Each bus action the driver starts by writing TWINT (a START, a STOP, an address or a
+*  data byte) completes when its bus time is over, or at once when the test steps the model. On completion, TWSR gets
+*  the status code of the datasheet, and TWI_vect is called if TWIE and the I bit of SREG are set, with the I bit
+*  cleared while it runs. A STOP sets no flag, and a STOP written with a START sends the START right after it.
+*
+*  The model is driven by the register accesses of the code under test: host_twi_io_listener() has to be called from
+*  the listener set by host_io_listener_set(), or set as that listener directly. TWINT always reads 0 on the host
+*  registers, so that a write of 1 to it can be seen, and the interrupt of a flag left set is raised again on the next
+*  listener call.
+*
+*  Every bus event goes to a trace, one token each, separated by spaces:
+*  "S" START, "Sr" repeated start, "P" STOP, "48W+" address 0x48 for writing acknowledged, "48R-" address 0x48 for
+*  reading refused, "A5+" byte 0xA5 written and acknowledged by the slave, "rA5-" byte 0xA5 read and answered with a
+*  NACK by the master.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef HOST_TWI_H_
+#define HOST_TWI_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "host_avr.h"
+
+/*********************************************************************************************************************
+                                               << Public Constants >>
+*********************************************************************************************************************/
+#define   HOST_TWI_MAX_SLAVES          (4U)
+#define   HOST_TWI_SLAVE_BUFFER_SIZE   (64U)
+#define   HOST_TWI_TRACE_SIZE          (1024U)
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+/* A slave on the bus. The test fills in the first fields, the model counts the bytes: */
+typedef struct host_twi_slave
+{
+	uint8_t        address;          /* The 7 bit address, not shifted. */
+	uint8_t        address_nack;     /* Refuses its address, like a slave that is busy. */
+	uint16_t       data_nack_byte;   /* The written byte, from 1 after each address, that gets a NACK, or 0. */
+	const uint8_t* read_data;        /* The bytes the master reads, over and over, or NULL for 0xFF. */
+	uint16_t       read_length;
+	/* Called with each written byte, or NULL: */
+	void (*byte_written)(struct host_twi_slave* slave, uint8_t data_byte);
+	
+	uint8_t        written[HOST_TWI_SLAVE_BUFFER_SIZE];   /* The first bytes written since the slave was attached. */
+	uint16_t       written_count;
+	uint16_t       read_count;
+	uint16_t       transfers;        /* The transfers that addressed it. */
+	uint16_t       transfer_bytes;   /* The bytes of the transfer in progress. */
+} host_twi_slave_t;
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+extern void host_twi_power_on(void);
+
+extern void host_twi_slave_attach(host_twi_slave_t* slave);
+
+extern void host_twi_io_listener(host_io_t io_register);
+
+extern uint8_t host_twi_step(void);
+
+extern uint16_t host_twi_run(void);
+
+extern const char* host_twi_trace_get(void);
+
+extern void host_twi_trace_clear(void);
+
+extern uint16_t host_twi_errors_get(void);
+
+/* The interrupt service routine of the code under test: */
+extern void TWI_vect(void);
+
+
+#endif /* HOST_TWI_H_ */
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
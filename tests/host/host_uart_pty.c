@@ -0,0 +1,497 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_uart_pty.c
+*
+** Description:
+*  This file contains the implementation of the pseudo terminal UART test double. It models the parts of the atmega32
+*  USART the drivers depend on: the two byte receive buffer with the data overrun flag, the transmit buffer in front
+*  of the shift register, the UDRE, RXC and TXC flags, and the frame time set by UBRR, U2X and the frame format.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <avr/io.h>
+#include "host_avr.h"
+#include "host_uart_pty.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   RECEIVE_BUFFER_SIZE      (2U)
+#define   START_BIT_COUNT          (1U)
+#define   MINIMUM_DATA_BITS        (5U)
+#define   NINE_DATA_BITS           (9U)
+#define   CHARACTER_SIZE_MASK      (0x03U)
+#define   NORMAL_SPEED_DIVISOR     (16ULL)
+#define   DOUBLE_SPEED_DIVISOR     (8ULL)
+#define   UBRRH_MASK               (0x0FU)
+#define   NANOSECONDS_PER_SECOND   (1000000000ULL)
+#define   INTERRUPT_ENABLE_BIT     (7U)
+#define   RECEIVE_STATUS_FLAGS     ((1<<RXC) | (1<<FE) | (1<<DOR) | (1<<PE))
+#define   TRANSMIT_STATUS_FLAGS    ((1<<UDRE) | (1<<TXC))
+#define   NO_FILE                  (-1)
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+typedef struct
+{
+	uint8_t data_byte;
+	uint8_t status_flags;   /* FE, DOR and PE of this byte, as they read in UCSRA. */
+} received_byte_t;
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static int g_master_file = NO_FILE;
+static int g_slave_file = NO_FILE;  /* Kept open, so reading the master doesn't fail before a program opens the slave. */
+static char g_slave_name[64];
+
+static received_byte_t g_receive_buffer[RECEIVE_BUFFER_SIZE];
+static uint8_t g_receive_count;
+static uint8_t g_receive_shift_register;
+static uint8_t g_receive_shift_register_full;
+static uint64_t g_receive_complete_time;   /* When the byte in the shift register has been received. */
+static uint64_t g_receive_line_check_time; /* The terminal is read at most once per frame while the line is idle. */
+static uint8_t g_receive_line_busy;        /* The last read found a byte, so the next byte follows without a gap. */
+
+static uint8_t g_transmit_buffer;
+static uint8_t g_transmit_buffer_full;
+static uint64_t g_transmit_buffer_time;
+static uint8_t g_transmit_shift_register;
+static uint8_t g_transmit_shift_register_full;
+static uint64_t g_transmit_complete_time;
+
+static uint8_t g_udr_access_pending;
+static uint8_t g_in_interrupt;
+
+static host_uart_pty_statistics_t g_statistics;
+static host_uart_pty_receive_observer_t g_receive_observer;
+
+/*********************************************************************************************************************
+                                                << Interrupt Vectors >>
+*********************************************************************************************************************/
+extern void USART_RXC_vect(void);
+extern void USART_UDRE_vect(void);
+
+/*********************************************************************************************************************
+                                         << Private Function Declarations >>
+*********************************************************************************************************************/
+static void udr_access_resolve(void);
+static void receiver_update(uint64_t now);
+static void transmitter_update(uint64_t now);
+static void status_flags_update(void);
+static void interrupts_run(void);
+static void interrupt_run(void (*vector)(void));
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  host_uart_pty_open
+*
+** Description:
+*  This function creates the pseudo terminal, sets it to raw mode and resets the UART model. Call it after
+*  host_reset().
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - const char*
+*    The name of the terminal the other side opens, like "/dev/pts/3", or NULL if it couldn't be created.
+*********************************************************************************************************************/
+const char* host_uart_pty_open(void)
+{
+	struct termios terminal_settings;
+	const char* slave_name;
+	
+	host_uart_pty_close();
+	
+	g_master_file = posix_openpt(O_RDWR | O_NOCTTY);
+	if ((NO_FILE == g_master_file) || (0 != grantpt(g_master_file)) || (0 != unlockpt(g_master_file)) ||
+	    (NULL == (slave_name = ptsname(g_master_file))))
+	{
+		host_uart_pty_close();
+		return NULL;
+	}
+	
+	strncpy(g_slave_name, slave_name, sizeof(g_slave_name) - 1U);
+	g_slave_file = open(g_slave_name, O_RDWR | O_NOCTTY);
+	if ((NO_FILE == g_slave_file) || (0 != tcgetattr(g_slave_file, &terminal_settings)))
+	{
+		host_uart_pty_close();
+		return NULL;
+	}
+	
+	/* No echo and no line editing, every byte passes unchanged in both directions: */
+	cfmakeraw(&terminal_settings);
+	(void)tcsetattr(g_slave_file, TCSANOW, &terminal_settings);
+	(void)fcntl(g_master_file, F_SETFL, fcntl(g_master_file, F_GETFL) | O_NONBLOCK);
+	
+	memset(g_receive_buffer, 0, sizeof(g_receive_buffer));
+	g_receive_count = 0;
+	g_receive_shift_register_full = 0;
+	g_receive_complete_time = 0;
+	g_receive_line_check_time = 0;
+	g_receive_line_busy = 0;
+	g_transmit_buffer_full = 0;
+	g_transmit_shift_register_full = 0;
+	g_transmit_complete_time = 0;
+	g_udr_access_pending = 0;
+	g_in_interrupt = 0;
+	g_receive_observer = NULL;
+	memset(&g_statistics, 0, sizeof(g_statistics));
+	
+	host_io[HOST_UCSRA] |= (1<<UDRE);
+	
+	return g_slave_name;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_uart_pty_close
+*
+** Description:
+*  This function closes the pseudo terminal.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_uart_pty_close(void)
+{
+	if (NO_FILE != g_slave_file)
+	{
+		(void)close(g_slave_file);
+		g_slave_file = NO_FILE;
+	}
+	
+	if (NO_FILE != g_master_file)
+	{
+		(void)close(g_master_file);
+		g_master_file = NO_FILE;
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_uart_pty_io_listener
+*
+** Description:
+*  This function moves the UART model to the current virtual time and runs the UART interrupts that are due. It has
+*  the signature of host_io_listener_t.
+*
+** Input Parameters:
+*  - io_register: host_io_t
+*    The register about to be accessed, or HOST_IO_REGISTERS_COUNT during a delay.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_uart_pty_io_listener(host_io_t io_register)
+{
+	uint64_t now = host_time_ns();
+	
+	if (NO_FILE == g_master_file)
+	{
+		return;
+	}
+	
+	udr_access_resolve();
+	receiver_update(now);
+	transmitter_update(now);
+	status_flags_update();
+	
+	/* The interrupt runs before the access that was about to happen: */
+	interrupts_run();
+	
+	if (HOST_UDR == io_register)
+	{
+		/* A read returns the byte at the top of the receive buffer: */
+		host_udr = HOST_UDR_UNWRITTEN | ((0 != g_receive_count) ? g_receive_buffer[0].data_byte : 0U);
+		g_udr_access_pending = 1;
+	}
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_uart_pty_receive_observer_set
+*
+** Description:
+*  This function sets the function called for every received byte, or removes it when NULL is passed. A test uses it
+*  to stamp the bytes for latency measurements.
+*
+** Input Parameters:
+*  - observer: host_uart_pty_receive_observer_t
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_uart_pty_receive_observer_set(host_uart_pty_receive_observer_t observer)
+{
+	g_receive_observer = observer;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_uart_pty_statistics_get
+*
+** Description:
+*  This function copies the counters of the UART model since host_uart_pty_open().
+*
+** Input Parameters:
+*  - statistics: host_uart_pty_statistics_t*
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+void host_uart_pty_statistics_get(host_uart_pty_statistics_t* statistics)
+{
+	*statistics = g_statistics;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  host_uart_pty_frame_time_ns
+*
+** Description:
+*  This function returns the time of one frame, from the start bit to the end of the stop bits, as set by the UART
+*  registers.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint64_t
+*********************************************************************************************************************/
+uint64_t host_uart_pty_frame_time_ns(void)
+{
+	uint8_t ucsrb = host_io[HOST_UCSRB];
+	uint8_t ucsrc = host_io[HOST_UCSRC];
+	uint64_t baud_rate_register = ((uint64_t)(host_io[HOST_UBRRH] & UBRRH_MASK) << 8) | host_io[HOST_UBRRL];
+	uint64_t divisor = (host_io[HOST_UCSRA] & (1<<U2X)) ? DOUBLE_SPEED_DIVISOR : NORMAL_SPEED_DIVISOR;
+	uint64_t frame_bits = START_BIT_COUNT;
+	
+	frame_bits += (ucsrb & (1<<UCSZ2)) ? NINE_DATA_BITS : (MINIMUM_DATA_BITS + ((ucsrc >> UCSZ0) & CHARACTER_SIZE_MASK));
+	frame_bits += (ucsrc & (1<<UPM1)) ? 1U : 0U;
+	frame_bits += (ucsrc & (1<<USBS)) ? 2U : 1U;
+	
+	return (frame_bits * divisor * (baud_rate_register + 1U) * NANOSECONDS_PER_SECOND) / host_cpu_frequency();
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+/* The access to UDR seen last time was a write if the driver replaced the high byte, and a read otherwise: */
+static void udr_access_resolve(void)
+{
+	if (0 == g_udr_access_pending)
+	{
+		return;
+	}
+	
+	g_udr_access_pending = 0;
+	
+	if (HOST_UDR_UNWRITTEN != (host_udr & HOST_UDR_UNWRITTEN))
+	{
+		if (!(host_io[HOST_UCSRB] & (1<<TXEN)) || g_transmit_buffer_full)
+		{
+			g_statistics.dropped_writes++;
+		}
+		else
+		{
+			g_transmit_buffer = (uint8_t)host_udr;
+			g_transmit_buffer_full = 1;
+			g_transmit_buffer_time = host_time_ns();
+			host_io[HOST_UCSRA] &= ~(1<<TXC);
+		}
+	}
+	else if (0 != g_receive_count)
+	{
+		g_receive_buffer[0] = g_receive_buffer[1];
+		g_receive_count--;
+	}
+	
+	host_udr = HOST_UDR_UNWRITTEN;
+}
+
+static void receiver_update(uint64_t now)
+{
+	uint8_t data_byte;
+	
+	if (!(host_io[HOST_UCSRB] & (1<<RXEN)))
+	{
+		return;
+	}
+	
+	for (;;)
+	{
+		if (g_receive_shift_register_full)
+		{
+			if (now < g_receive_complete_time)
+			{
+				return;
+			}
+			
+			g_receive_shift_register_full = 0;
+			
+			if (RECEIVE_BUFFER_SIZE == g_receive_count)
+			{
+				/* The new byte is lost, and the byte before it is flagged: */
+				g_receive_buffer[RECEIVE_BUFFER_SIZE - 1U].status_flags |= (1<<DOR);
+				g_statistics.data_overruns++;
+			}
+			else
+			{
+				g_receive_buffer[g_receive_count].data_byte = g_receive_shift_register;
+				g_receive_buffer[g_receive_count].status_flags = 0;
+				g_receive_count++;
+				g_statistics.received_bytes++;
+				
+				if (NULL != g_receive_observer)
+				{
+					g_receive_observer(g_receive_shift_register, g_receive_complete_time);
+				}
+			}
+		}
+		
+		if (!g_receive_line_busy && (now < g_receive_line_check_time))
+		{
+			return;
+		}
+		
+		if (1 != read(g_master_file, &data_byte, 1))
+		{
+			g_receive_line_busy = 0;
+			g_receive_line_check_time = now + host_uart_pty_frame_time_ns();
+			return;
+		}
+		
+		/* A byte found on an idle line starts now, the bytes waiting behind it follow without gaps: */
+		g_receive_shift_register = data_byte;
+		g_receive_shift_register_full = 1;
+		g_receive_complete_time = (g_receive_line_busy ? g_receive_complete_time : now) + host_uart_pty_frame_time_ns();
+		g_receive_line_busy = 1;
+	}
+}
+
+static void transmitter_update(uint64_t now)
+{
+	uint64_t start_time;
+	
+	for (;;)
+	{
+		if (g_transmit_shift_register_full)
+		{
+			if (now < g_transmit_complete_time)
+			{
+				return;
+			}
+			
+			(void)write(g_master_file, &g_transmit_shift_register, 1);
+			g_transmit_shift_register_full = 0;
+			g_statistics.transmitted_bytes++;
+			
+			if (!g_transmit_buffer_full)
+			{
+				host_io[HOST_UCSRA] |= (1<<TXC);
+			}
+		}
+		
+		if (!g_transmit_buffer_full)
+		{
+			return;
+		}
+		
+		/* The buffer moves to the shift register as soon as the shift register is free: */
+		start_time = (g_transmit_buffer_time > g_transmit_complete_time) ? g_transmit_buffer_time :
+		             g_transmit_complete_time;
+		g_transmit_shift_register = g_transmit_buffer;
+		g_transmit_shift_register_full = 1;
+		g_transmit_buffer_full = 0;
+		g_transmit_complete_time = start_time + host_uart_pty_frame_time_ns();
+	}
+}
+
+static void status_flags_update(void)
+{
+	uint8_t status_flags = host_io[HOST_UCSRA] & ~(RECEIVE_STATUS_FLAGS | (1<<UDRE));
+	
+	if (0 != g_receive_count)
+	{
+		status_flags |= (1<<RXC) | g_receive_buffer[0].status_flags;
+	}
+	
+	if (!g_transmit_buffer_full)
+	{
+		status_flags |= (1<<UDRE);
+	}
+	
+	host_io[HOST_UCSRA] = status_flags;
+}
+
+static void interrupts_run(void)
+{
+	uint8_t control = host_io[HOST_UCSRB];
+	uint8_t status = host_io[HOST_UCSRA];
+	
+	if (g_in_interrupt || !(host_io[HOST_SREG] & (1<<INTERRUPT_ENABLE_BIT)))
+	{
+		return;
+	}
+	
+	if ((control & (1<<RXCIE)) && (status & (1<<RXC)))
+	{
+		interrupt_run(&USART_RXC_vect);
+	}
+	else if ((control & (1<<UDRIE)) && (status & (1<<UDRE)))
+	{
+		interrupt_run(&USART_UDRE_vect);
+	}
+}
+
+static void interrupt_run(void (*vector)(void))
+{
+	/* The hardware clears the I bit on entry and sets it again on return: */
+	g_in_interrupt = 1;
+	host_io[HOST_SREG] &= ~(1<<INTERRUPT_ENABLE_BIT);
+	vector();
+	host_io[HOST_SREG] |= (1<<INTERRUPT_ENABLE_BIT);
+	g_in_interrupt = 0;
+	
+	/* The last register access of the interrupt takes effect before the interrupted code goes on: */
+	udr_access_resolve();
+	status_flags_update();
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,77 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  host_uart_pty.h
+*
+** Description:
+*  This file contains the interface of a UART test double that connects the UART registers of the host build to a
+*  Linux pseudo terminal. Bytes written to the terminal arrive in UDR at the configured baud rate and raise the
+*  receive complete interrupt, and bytes the driver writes to UDR come out of the terminal at the same rate. Any
+*  program can drive the terminal, like a test, a script or "cat file > /dev/pts/N".
+*
+*  The double is driven by the register accesses of the code under test: host_uart_pty_io_listener() has to be called
+*  from the listener set by host_io_listener_set(), or set as that listener directly. The interrupts run from there,
+*  between two register accesses, when the I bit of SREG is set.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef HOST_UART_PTY_H_
+#define HOST_UART_PTY_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include "host_avr.h"
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+typedef struct
+{
+	uint32_t received_bytes;    /* Bytes moved from the terminal into the receive buffer. */
+	uint32_t data_overruns;     /* Bytes lost because the two byte receive buffer was full. */
+	uint32_t transmitted_bytes; /* Bytes written out to the terminal. */
+	uint32_t dropped_writes;    /* Writes to UDR while UDRE was clear, which the hardware ignores. */
+} host_uart_pty_statistics_t;
+
+/* Called when a byte is moved into the receive buffer, with the time its stop bit ended: */
+typedef void (*host_uart_pty_receive_observer_t)(uint8_t data_byte, uint64_t time_ns);
+
+/*********************************************************************************************************************
+                                   << Public Function Declarations (Programming Interfaces) >>
+*********************************************************************************************************************/
+extern const char* host_uart_pty_open(void);
+
+extern void host_uart_pty_close(void);
+
+extern void host_uart_pty_io_listener(host_io_t io_register);
+
+extern void host_uart_pty_receive_observer_set(host_uart_pty_receive_observer_t observer);
+
+extern void host_uart_pty_statistics_get(host_uart_pty_statistics_t* statistics);
+
+extern uint64_t host_uart_pty_frame_time_ns(void);
+
+
+#endif /* HOST_UART_PTY_H_ */
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,40 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  util/delay.h
+*
+** Description:
+*  Host stand-in for <util/delay.h>. The delays advance the virtual clock of "host_avr.h" instead of waiting.
+*********************************************************************************************************************/
+
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+#include "host_avr.h"
+
+static inline void _delay_us(double delay_us)
+{
+	host_delay_ns((uint64_t)(delay_us * 1000.0));
+}
+
+static inline void _delay_ms(double delay_ms)
+{
+	host_delay_ns((uint64_t)(delay_ms * 1000000.0));
+}
+
+#endif /* HOST_UTIL_DELAY_H_ */
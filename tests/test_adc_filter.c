@@ -0,0 +1,343 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  test_adc_filter.c
+*
+** Description:
+*  This file checks the ADC filters on the host against plain reference computations: the step response of the
+*  exponential moving average at every shift, the boxcar average at every length, the spike rejection of the medians
+*  and the priming on the first sample. It also runs a filter on the fixed-rate sampling of the ADC driver, against
+*  the ADC model, to check that the buffer gets the filtered samples.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "host_avr.h"
+#include "host_adc.h"
+#include "adc.h"
+#include "adc_filter.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   FULL_SCALE          (1023U)
+#define   OVERSAMPLED_SCALE   (8191U)   /* The largest result of the oversampling, 13 bits. */
+#define   STEP_SAMPLES        (4096U)
+#define   RANDOM_SAMPLES      (2000U)
+#define   SPIKE_LEVEL         (500U)
+#define   SAMPLE_RATE         (1000UL)
+#define   SAMPLING_SAMPLES    (12U)
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static uint16_t g_random_samples[RANDOM_SAMPLES];
+static const uint16_t* g_conversion_samples;
+static uint8_t g_conversion_index;
+static unsigned long g_failures;
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+static void check(int condition, const char* description)
+{
+	if (!condition)
+	{
+		printf("FAIL: %s\n", description);
+		g_failures++;
+	}
+}
+
+static uint16_t median_get(const uint16_t* window, uint8_t length)
+{
+	uint16_t sorted[ADC_FILTER_WINDOW_SIZE];
+	uint16_t value;
+	
+	for (uint8_t i = 0; i < length; i++)
+	{
+		sorted[i] = window[i];
+	}
+	for (uint8_t i = 0; i < length; i++)
+	{
+		for (uint8_t j = i + 1U; j < length; j++)
+		{
+			if (sorted[j] < sorted[i])
+			{
+				value = sorted[i];
+				sorted[i] = sorted[j];
+				sorted[j] = value;
+			}
+		}
+	}
+	
+	return sorted[length / 2U];
+}
+
+/* The output follows the ideal exponential 1 - (1 - 2^-shift)^n within one step, and settles on the input: */
+static void ema_step_test(uint8_t shift, uint16_t from, uint16_t to)
+{
+	adc_filter_t filter;
+	double ideal;
+	double weight = 1.0 - ldexp(1.0, -(int)shift);
+	uint16_t output;
+	uint16_t previous = from;
+	uint8_t within_step = 1;
+	uint8_t monotonic = 1;
+	char description[80];
+	
+	check(1U == adc_filter_init(&filter, ADC_FILTER_EMA, shift), "the EMA shifts up to the maximum are accepted");
+	check(from == adc_filter_update(&filter, from), "the EMA starts at the first sample");
+	
+	for (uint16_t n = 1; n <= STEP_SAMPLES; n++)
+	{
+		output = adc_filter_update(&filter, to);
+		ideal = (double)to + (((double)from - (double)to) * pow(weight, (double)n));
+		if (fabs((double)output - ideal) > 1.0)
+		{
+			within_step = 0;
+		}
+		if (((to > from) && (output < previous)) || ((to < from) && (output > previous)))
+		{
+			monotonic = 0;
+		}
+		previous = output;
+	}
+	
+	snprintf(description, sizeof(description), "the EMA of shift %u follows the ideal step response", shift);
+	check(within_step, description);
+	snprintf(description, sizeof(description), "the EMA of shift %u moves one way to the step", shift);
+	check(monotonic, description);
+	snprintf(description, sizeof(description), "the EMA of shift %u settles on the input", shift);
+	check(to == previous, description);
+}
+
+static void ema_test(void)
+{
+	adc_filter_t filter;
+	uint8_t passes_input = 1;
+	
+	for (uint8_t shift = 0; shift <= ADC_FILTER_EMA_MAX_SHIFT; shift++)
+	{
+		ema_step_test(shift, 0, FULL_SCALE);
+		ema_step_test(shift, FULL_SCALE, 0);
+	}
+	/* The largest shift with the largest oversampled results, where the sum needs more than 16 bits: */
+	ema_step_test(ADC_FILTER_EMA_MAX_SHIFT, 0, OVERSAMPLED_SCALE);
+	
+	/* A shift of 0 gives the whole weight to the new sample: */
+	(void)adc_filter_init(&filter, ADC_FILTER_EMA, 0);
+	for (uint16_t i = 0; i < RANDOM_SAMPLES; i++)
+	{
+		if (g_random_samples[i] != adc_filter_update(&filter, g_random_samples[i]))
+		{
+			passes_input = 0;
+		}
+	}
+	check(passes_input, "the EMA of shift 0 passes the input");
+	check(0U == adc_filter_init(&filter, ADC_FILTER_EMA, ADC_FILTER_EMA_MAX_SHIFT + 1U),
+	      "an EMA shift above the maximum is rejected");
+}
+
+static void boxcar_test(void)
+{
+	adc_filter_t filter;
+	uint32_t sum;
+	uint16_t length;
+	int32_t oldest;
+	uint8_t average_right;
+	char description[80];
+	
+	for (uint8_t shift = 0; shift <= ADC_FILTER_BOXCAR_MAX_SHIFT; shift++)
+	{
+		length = (uint16_t)(1U << shift);
+		average_right = 1;
+		check(1U == adc_filter_init(&filter, ADC_FILTER_BOXCAR, shift), "the boxcar lengths are accepted");
+		
+		for (uint16_t i = 0; i < RANDOM_SAMPLES; i++)
+		{
+			/* The window before the first sample is filled with the first sample: */
+			sum = 0;
+			for (uint16_t j = 0; j < length; j++)
+			{
+				oldest = (int32_t)i - (int32_t)j;
+				sum += g_random_samples[(0 > oldest) ? 0 : oldest];
+			}
+			if ((uint16_t)(sum >> shift) != adc_filter_update(&filter, g_random_samples[i]))
+			{
+				average_right = 0;
+			}
+		}
+		snprintf(description, sizeof(description), "the boxcar of %u samples is the average of the last ones",
+		         length);
+		check(average_right, description);
+	}
+	check(0U == adc_filter_init(&filter, ADC_FILTER_BOXCAR, ADC_FILTER_BOXCAR_MAX_SHIFT + 1U),
+	      "a boxcar longer than the window is rejected");
+}
+
+static void median_test(adc_filter_type_t type, uint8_t length, uint8_t spike_length)
+{
+	adc_filter_t filter;
+	uint16_t window[ADC_FILTER_WINDOW_SIZE];
+	uint16_t output;
+	uint8_t median_right = 1;
+	uint8_t spike_rejected = 1;
+	int32_t oldest;
+	char description[80];
+	
+	/* Against the median of the last samples, with the window filled with the first sample at the start: */
+	(void)adc_filter_init(&filter, type, 0);
+	for (uint16_t i = 0; i < RANDOM_SAMPLES; i++)
+	{
+		for (uint8_t j = 0; j < length; j++)
+		{
+			oldest = (int32_t)i - (int32_t)j;
+			window[j] = g_random_samples[(0 > oldest) ? 0 : oldest];
+		}
+		if (median_get(window, length) != adc_filter_update(&filter, g_random_samples[i]))
+		{
+			median_right = 0;
+		}
+	}
+	snprintf(description, sizeof(description), "the median of %u is the median of the last samples", length);
+	check(median_right, description);
+	
+	/* A flat input with spikes up and down, each as long as the filter can remove, apart: */
+	(void)adc_filter_init(&filter, type, 0);
+	(void)adc_filter_update(&filter, SPIKE_LEVEL);
+	for (uint16_t i = 0; i < (10U * length); i++)
+	{
+		for (uint8_t j = 0; j < (2U * spike_length); j++)
+		{
+			output = adc_filter_update(&filter, ((j < spike_length) && (i & 1U)) ? FULL_SCALE :
+			                                    ((j < spike_length) ? 0U : SPIKE_LEVEL));
+			if (SPIKE_LEVEL != output)
+			{
+				spike_rejected = 0;
+			}
+		}
+	}
+	snprintf(description, sizeof(description), "the median of %u removes spikes as long as %u samples", length,
+	         spike_length);
+	check(spike_rejected, description);
+}
+
+static void priming_test(void)
+{
+	adc_filter_t filter;
+	static const adc_filter_type_t types[] = {ADC_FILTER_NONE, ADC_FILTER_EMA, ADC_FILTER_BOXCAR,
+	                                          ADC_FILTER_MEDIAN_3, ADC_FILTER_MEDIAN_5};
+	uint8_t primed = 1;
+	
+	/* The first output is the first sample, and a second init starts over from the next sample: */
+	for (uint8_t i = 0; i < (sizeof(types) / sizeof(types[0])); i++)
+	{
+		(void)adc_filter_init(&filter, types[i], 3);
+		if ((FULL_SCALE != adc_filter_update(&filter, FULL_SCALE)) || (FULL_SCALE != adc_filter_update(&filter, FULL_SCALE)))
+		{
+			primed = 0;
+		}
+		(void)adc_filter_init(&filter, types[i], 3);
+		if (7U != adc_filter_update(&filter, 7U))
+		{
+			primed = 0;
+		}
+	}
+	check(primed, "every filter starts at the first sample");
+	check(0U == adc_filter_init(&filter, (adc_filter_type_t)(ADC_FILTER_MEDIAN_5 + 1U), 0),
+	      "an unknown filter type is rejected");
+}
+
+static uint16_t sampling_conversion(uint8_t admux)
+{
+	(void)admux;
+	
+	return g_conversion_samples[g_conversion_index++ % SAMPLING_SAMPLES];
+}
+
+/* The samples of the fixed-rate sampling go through the filter in the ADC interrupt: */
+static void sampling_filter_test(void)
+{
+	static const uint16_t spiky_input[SAMPLING_SAMPLES] = {300, 300, 1023, 300, 300, 0, 300, 300, 300, 1023, 300, 300};
+	adc_filter_t filter;
+	uint16_t sample;
+	uint8_t samples_count = 0;
+	uint8_t spikes_removed = 1;
+	
+	host_reset(HOST_DEFAULT_CPU_FREQUENCY);
+	host_adc_power_on(sampling_conversion);
+	host_io_listener_set(host_adc_io_listener);
+	g_conversion_samples = spiky_input;
+	g_conversion_index = 0;
+	
+	adc_enable();
+	adc_set_clock_prescalar(ADC_PRESCALAR_64);
+	(void)adc_filter_init(&filter, ADC_FILTER_MEDIAN_3, 0);
+	check(1U == adc_sampling_start(ADC_CHANNEL_1, SAMPLE_RATE, HOST_DEFAULT_CPU_FREQUENCY), "the sampling starts");
+	adc_sampling_filter_set(&filter);
+	check((((1U << ADTS1) | (1U << ADTS0)) == (SFIOR & ((1U << ADTS2) | (1U << ADTS1) | (1U << ADTS0)))) &&
+	      (ADCSRA & (1U << ADATE)), "the compare match of timer0 is the trigger source");
+	
+	/* Each compare match of timer0 triggers a conversion: */
+	for (uint8_t i = 0; i < SAMPLING_SAMPLES; i++)
+	{
+		check(1U == host_adc_trigger(), "the timer triggers a conversion");
+		(void)host_adc_conversion_complete();
+	}
+	while (adc_sample_read(&sample))
+	{
+		spikes_removed &= (300U == sample);
+		samples_count++;
+	}
+	check(SAMPLING_SAMPLES == samples_count, "every sample is kept");
+	check(spikes_removed, "the buffer gets the filtered samples");
+	
+	adc_sampling_stop();
+}
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(void)
+{
+	srand(1);
+	for (uint16_t i = 0; i < RANDOM_SAMPLES; i++)
+	{
+		g_random_samples[i] = (uint16_t)(rand() % (FULL_SCALE + 1U));
+	}
+	
+	ema_test();
+	boxcar_test();
+	median_test(ADC_FILTER_MEDIAN_3, 3, 1);
+	median_test(ADC_FILTER_MEDIAN_5, 5, 2);
+	priming_test();
+	sampling_filter_test();
+	
+	printf("test_adc_filter: %lu failures\n", g_failures);
+	
+	return (0 == g_failures) ? 0 : 1;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
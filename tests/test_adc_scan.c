@@ -0,0 +1,517 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  test_adc_scan.c
+*
+** Description:
+*  This file runs the ADC scan engine against the ADC model, with ADC_vect called on each conversion complete. It
+*  checks that each conversion is started with the ADMUX value of its list entry, that the results of a scan only
+*  show once the scan is complete, that a new list never shows the results of the last one, that a paced scan waits
+*  for the compare match of timer0 between scans and has no trigger enabled in the middle of one, and that a snapshot
+*  is never torn by scans completing during the copy. For the last check, a burst of interrupts, enough to complete a
+*  scan and refill the buffer being copied, is injected after every single instruction of adc_scan_snapshot_get()
+*  in turn, with the trap flag of x86 processors.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <avr/io.h>
+#include "host_avr.h"
+#include "host_adc.h"
+#include "adc.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   MAX_CONVERSIONS          (4096U)
+#define   RESULT_MASK              (0x03FFU)
+#define   MUX_MASK                 (0x1FU)
+#define   SCANS_COUNT              (3U)
+#define   SCAN_RATE                (100UL)
+#define   TIMER0_CLOCK_BITS        ((1U << CS02) | (1U << CS01) | (1U << CS00))
+#define   TRAP_FLAG                (0x100ULL)
+#define   MAX_TRACED_INSTRUCTIONS  (100000L)
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+typedef struct
+{
+	const adc_channel_t* channels;
+	const uint8_t*       extra_bits;
+	uint8_t              channels_count;
+} scan_list_t;
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static const adc_channel_t g_oversampled_channels[] = {ADC_CHANNEL_0, ADC_CHANNEL_3, ADC_CHANNEL_5};
+static const uint8_t g_oversampled_extra_bits[] = {1, 0, 2};
+static const scan_list_t g_oversampled_list = {g_oversampled_channels, g_oversampled_extra_bits, 3};
+
+static const adc_channel_t g_plain_channels[] = {ADC_CHANNEL_7, ADC_DIFFERENTIAL_1_0_X10, ADC_CHANNEL_2,
+                                                 ADC_BANDGAP_1_22V};
+static const scan_list_t g_plain_list = {g_plain_channels, NULL, 4};
+
+/* The ADMUX value and the result of every conversion, in the order they started: */
+static uint8_t g_admux_log[MAX_CONVERSIONS];
+static uint16_t g_result_log[MAX_CONVERSIONS];
+static uint16_t g_conversions;
+
+static volatile long g_instructions_left;
+static volatile uint16_t g_interrupts_left;
+static volatile uint8_t g_interrupt_injected;
+static volatile uint8_t g_tracing_stopped;
+
+static unsigned long g_failures;
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+static void check(int condition, const char* description)
+{
+	if (!condition)
+	{
+		printf("FAIL: %s\n", description);
+		g_failures++;
+	}
+}
+
+/* Every conversion gives a new result, so the results of different scans never match: */
+static uint16_t conversion(uint8_t admux)
+{
+	uint16_t result = (uint16_t)((g_conversions * 7U + 3U) & RESULT_MASK);
+	
+	if (MAX_CONVERSIONS > g_conversions)
+	{
+		g_admux_log[g_conversions] = admux;
+		g_result_log[g_conversions] = result;
+	}
+	g_conversions++;
+	
+	return result;
+}
+
+static uint8_t extra_bits_get(const scan_list_t* list, uint8_t entry)
+{
+	return (NULL != list->extra_bits) ? list->extra_bits[entry] : 0U;
+}
+
+static uint16_t scan_conversions_count(const scan_list_t* list)
+{
+	uint16_t count = 0;
+	
+	for (uint8_t entry = 0; entry < list->channels_count; entry++)
+	{
+		count += (uint16_t)(1U << (2U * extra_bits_get(list, entry)));
+	}
+	
+	return count;
+}
+
+/* The results of scan number "scan" (from 1) of the list, from the conversions logged since it started: */
+static void scan_expected_get(const scan_list_t* list, uint16_t first_conversion, uint8_t scan, uint16_t* results)
+{
+	uint16_t conversion_index = first_conversion + (uint16_t)((scan - 1U) * scan_conversions_count(list));
+	uint32_t sum;
+	
+	for (uint8_t entry = 0; entry < list->channels_count; entry++)
+	{
+		sum = 0;
+		for (uint16_t i = 0; i < (1U << (2U * extra_bits_get(list, entry))); i++)
+		{
+			sum += g_result_log[conversion_index++];
+		}
+		results[entry] = (uint16_t)(sum >> extra_bits_get(list, entry));
+	}
+}
+
+static uint16_t scan_start(const scan_list_t* list)
+{
+	uint16_t first_conversion;
+	
+	/* A conversion of the last list may have started without being logged yet: */
+	(void)host_adc_conversion_running();
+	first_conversion = g_conversions;
+	
+	check(1U == adc_scan_oversampled_start(list->channels, list->extra_bits, list->channels_count),
+	      "the scan starts");
+	
+	return first_conversion;
+}
+
+static void setup(void)
+{
+	host_reset(HOST_DEFAULT_CPU_FREQUENCY);
+	host_adc_power_on(conversion);
+	host_io_listener_set(host_adc_io_listener);
+	g_conversions = 0;
+	
+	adc_enable();
+	adc_reference_voltage(ADC_AVCC_AREF);
+	adc_set_clock_prescalar(ADC_PRESCALAR_64);
+	/* A left adjusted result would break the oversampling sums, the scan has to clear ADLAR: */
+	ADMUX |= (1U << ADLAR);
+}
+
+static void preload_order_test(void)
+{
+	const scan_list_t* list = &g_oversampled_list;
+	uint16_t first_conversion;
+	uint16_t conversion_index;
+	uint8_t order_right = 1;
+	
+	setup();
+	first_conversion = scan_start(list);
+	for (uint16_t i = 0; i < (SCANS_COUNT * scan_conversions_count(list)); i++)
+	{
+		check(1U == host_adc_conversion_complete(), "the scan keeps a conversion running");
+	}
+	
+	/* Each entry is converted 4^n times in a row, with its own channel, the same reference and ADLAR cleared: */
+	conversion_index = first_conversion;
+	for (uint8_t scan = 0; scan < SCANS_COUNT; scan++)
+	{
+		for (uint8_t entry = 0; entry < list->channels_count; entry++)
+		{
+			for (uint16_t i = 0; i < (1U << (2U * extra_bits_get(list, entry))); i++)
+			{
+				if (g_admux_log[conversion_index++] != ((1U << REFS0) | list->channels[entry]))
+				{
+					order_right = 0;
+				}
+			}
+		}
+	}
+	check(order_right, "each conversion starts with the ADMUX value of its list entry");
+	check(host_adc_conversion_running() &&
+	      ((first_conversion + (SCANS_COUNT * scan_conversions_count(list)) + 1U) == g_conversions),
+	      "the next conversion starts as soon as one completes");
+	
+	adc_scan_stop();
+	check(!host_adc_conversion_running() && !(ADCSRA & (1U << ADIE)), "the stop leaves no conversion running");
+}
+
+static void buffer_swap_test(void)
+{
+	const scan_list_t* list = &g_plain_list;
+	uint16_t first_conversion;
+	uint16_t results[ADC_SCAN_MAX_CHANNELS];
+	uint16_t expected[ADC_SCAN_MAX_CHANNELS];
+	uint8_t scan_count;
+	uint8_t snapshots_right = 1;
+	
+	setup();
+	first_conversion = scan_start(list);
+	for (uint16_t i = 1; i <= (SCANS_COUNT * scan_conversions_count(list)); i++)
+	{
+		check(1U == host_adc_conversion_complete(), "the scan keeps a conversion running");
+		
+		/* The snapshot is the last complete scan, and the scan being converted never shows: */
+		scan_count = adc_scan_snapshot_get(results);
+		if (scan_count != (i / scan_conversions_count(list)))
+		{
+			snapshots_right = 0;
+		}
+		else if (0U != scan_count)
+		{
+			scan_expected_get(list, first_conversion, scan_count, expected);
+			if (0 != memcmp(results, expected, list->channels_count * sizeof(uint16_t)))
+			{
+				snapshots_right = 0;
+			}
+		}
+		else
+		{
+			for (uint8_t entry = 0; entry < list->channels_count; entry++)
+			{
+				if (0U != results[entry])
+				{
+					snapshots_right = 0;
+				}
+			}
+		}
+	}
+	check(snapshots_right, "each snapshot is the last complete scan");
+	adc_scan_stop();
+}
+
+static void restart_test(void)
+{
+	uint16_t first_conversion;
+	uint16_t results[ADC_SCAN_MAX_CHANNELS];
+	uint16_t expected[ADC_SCAN_MAX_CHANNELS];
+	uint8_t scan_count;
+	
+	setup();
+	(void)scan_start(&g_plain_list);
+	for (uint16_t i = 0; i < (SCANS_COUNT * scan_conversions_count(&g_plain_list)); i++)
+	{
+		(void)host_adc_conversion_complete();
+	}
+	
+	/* Until the first scan of the new list completes, there are no results, not the ones of the last list: */
+	first_conversion = scan_start(&g_oversampled_list);
+	for (uint16_t i = 1; i < scan_conversions_count(&g_oversampled_list); i++)
+	{
+		(void)host_adc_conversion_complete();
+	}
+	scan_count = adc_scan_snapshot_get(results);
+	check((0U == scan_count) && (0U == results[0]) && (0U == results[1]) && (0U == results[2]),
+	      "a new list starts with no results");
+	
+	(void)host_adc_conversion_complete();
+	scan_count = adc_scan_snapshot_get(results);
+	scan_expected_get(&g_oversampled_list, first_conversion, 1, expected);
+	check((1U == scan_count) && (0 == memcmp(results, expected, 3U * sizeof(uint16_t))),
+	      "the first scan of a new list is counted from 1");
+	adc_scan_stop();
+}
+
+/* The number of scans per second that timer0 gives, from its registers: */
+static uint32_t timer0_scan_rate_get(void)
+{
+	static const uint16_t prescalars[] = {0U, 1U, 8U, 64U, 256U, 1024U};
+	uint8_t clock_bits = TCCR0 & TIMER0_CLOCK_BITS;
+	
+	if ((0U == clock_bits) || (5U < clock_bits))
+	{
+		return 0;
+	}
+	return HOST_DEFAULT_CPU_FREQUENCY / ((uint32_t)prescalars[clock_bits] * (OCR0 + 1UL));
+}
+
+static void paced_scan_test(void)
+{
+	const scan_list_t* list = &g_oversampled_list;
+	uint16_t first_conversion;
+	uint16_t conversion_index;
+	uint16_t results[ADC_SCAN_MAX_CHANNELS];
+	uint16_t expected[ADC_SCAN_MAX_CHANNELS];
+	uint32_t rate;
+	uint8_t order_right = 1;
+	uint8_t trigger_off = 1;
+	uint8_t snapshots_right = 1;
+	
+	setup();
+	check(0U == adc_scan_rate_set(SCAN_RATE, HOST_DEFAULT_CPU_FREQUENCY), "no scan, no rate");
+	(void)scan_start(list);
+	check(0U == adc_scan_rate_set(HOST_DEFAULT_CPU_FREQUENCY / 64U, HOST_DEFAULT_CPU_FREQUENCY),
+	      "a rate too high for the conversions of the list is refused");
+	check(0U == adc_scan_rate_set(1U, HOST_DEFAULT_CPU_FREQUENCY), "a rate too low for timer0 is refused");
+	check(!(TCCR0 & TIMER0_CLOCK_BITS), "a refused rate leaves timer0 off");
+	
+	/* The scan starts over, and waits for the compare match: */
+	check(1U == adc_scan_rate_set(SCAN_RATE, HOST_DEFAULT_CPU_FREQUENCY), "the scan rate is set");
+	rate = timer0_scan_rate_get();
+	check((rate >= (SCAN_RATE - 1U)) && (rate <= (SCAN_RATE + 1U)) && (TCCR0 & (1U << WGM01)) &&
+	      !(TCCR0 & (1U << WGM00)), "timer0 runs in CTC mode at the scan rate");
+	check(!host_adc_conversion_running() && (ADCSRA & (1U << ADATE)) &&
+	      (((1U << ADTS1) | (1U << ADTS0)) == (SFIOR & ((1U << ADTS2) | (1U << ADTS1) | (1U << ADTS0)))),
+	      "the scan waits for the compare match of timer0");
+	
+	first_conversion = g_conversions;
+	for (uint8_t scan = 1; scan <= SCANS_COUNT; scan++)
+	{
+		check(1U == host_adc_trigger(), "the compare match starts the scan");
+		for (uint16_t i = 1; i < scan_conversions_count(list); i++)
+		{
+			check(1U == host_adc_conversion_complete(), "the conversions of a scan follow each other");
+			if (ADCSRA & (1U << ADATE))
+			{
+				trigger_off = 0;
+			}
+		}
+		check(1U == host_adc_conversion_complete(), "the last conversion of the scan completes");
+		check(!host_adc_conversion_running() && (ADCSRA & (1U << ADATE)), "the next scan waits for timer0");
+		
+		if (scan != adc_scan_snapshot_get(results))
+		{
+			snapshots_right = 0;
+		}
+		scan_expected_get(list, first_conversion, scan, expected);
+		if (0 != memcmp(results, expected, list->channels_count * sizeof(uint16_t)))
+		{
+			snapshots_right = 0;
+		}
+	}
+	check(trigger_off, "the trigger is off in the middle of a scan");
+	check(snapshots_right, "each paced scan gives a snapshot");
+	
+	conversion_index = first_conversion;
+	for (uint8_t scan = 0; scan < SCANS_COUNT; scan++)
+	{
+		for (uint8_t entry = 0; entry < list->channels_count; entry++)
+		{
+			for (uint16_t i = 0; i < (1U << (2U * extra_bits_get(list, entry))); i++)
+			{
+				if (g_admux_log[conversion_index++] != ((1U << REFS0) | list->channels[entry]))
+				{
+					order_right = 0;
+				}
+			}
+		}
+	}
+	check(order_right && ((first_conversion + (SCANS_COUNT * scan_conversions_count(list))) == g_conversions),
+	      "each paced scan converts the list once, in order");
+	
+	/* Back to free running, then stopped: */
+	check(1U == adc_scan_rate_set(0U, HOST_DEFAULT_CPU_FREQUENCY), "the scan can be free running again");
+	check(!(TCCR0 & TIMER0_CLOCK_BITS) && !(ADCSRA & (1U << ADATE)) && host_adc_conversion_running(),
+	      "a free running scan starts its own conversions");
+	check(1U == adc_scan_rate_set(SCAN_RATE, HOST_DEFAULT_CPU_FREQUENCY), "the scan rate is set again");
+	adc_scan_stop();
+	check(!(TCCR0 & TIMER0_CLOCK_BITS) && !(ADCSRA & (1U << ADATE)) && !host_adc_conversion_running(),
+	      "the stop of a paced scan stops timer0");
+}
+
+#if defined(__x86_64__)
+/* Runs after each instruction while the trap flag is set, and completes a conversion after each instruction from the
+   chosen one on, until the burst is over: */
+static void trap_handler(int signal_number, siginfo_t* information, void* context)
+{
+	ucontext_t* user_context = (ucontext_t*)context;
+	
+	(void)signal_number;
+	(void)information;
+	
+	if ((0L >= g_instructions_left) && (0U != g_interrupts_left))
+	{
+		(void)host_adc_conversion_complete();
+		g_interrupts_left--;
+		g_interrupt_injected = 1;
+	}
+	g_instructions_left--;
+	
+	if (g_tracing_stopped || (-MAX_TRACED_INSTRUCTIONS > g_instructions_left))
+	{
+		user_context->uc_mcontext.gregs[REG_EFL] &= ~TRAP_FLAG;
+	}
+}
+
+/* Calls adc_scan_snapshot_get() with a burst of interrupts starting after the given number of instructions: */
+static uint8_t interrupted_snapshot_get(long instructions, uint16_t interrupts, uint16_t* results)
+{
+	uint8_t scan_count;
+	
+	g_instructions_left = instructions;
+	g_interrupts_left = interrupts;
+	g_interrupt_injected = 0;
+	g_tracing_stopped = 0;
+	
+	/* The flags are pushed below the red zone, which the compiler may be using: */
+	__asm__ volatile ("sub $128, %%rsp\n\tpushfq\n\torq $0x100, (%%rsp)\n\tpopfq\n\tadd $128, %%rsp" ::: "memory", "cc");
+	scan_count = adc_scan_snapshot_get(results);
+	g_tracing_stopped = 1;
+	__asm__ volatile ("nop" ::: "memory");
+	
+	return scan_count;
+}
+
+static void coherence_test(void)
+{
+	const scan_list_t* list = &g_plain_list;
+	struct sigaction action;
+	uint16_t first_conversion;
+	uint16_t results[ADC_SCAN_MAX_CHANNELS];
+	uint16_t expected[ADC_SCAN_MAX_CHANNELS];
+	uint8_t scan_count;
+	uint8_t snapshots_right = 1;
+	uint8_t old_snapshots = 0;
+	uint8_t new_snapshots = 0;
+	long instructions;
+	
+	memset(&action, 0, sizeof(action));
+	action.sa_sigaction = trap_handler;
+	action.sa_flags = SA_SIGINFO;
+	sigaction(SIGTRAP, &action, NULL);
+	
+	for (instructions = 0; instructions < MAX_TRACED_INSTRUCTIONS; instructions++)
+	{
+		/* The first scan is complete, and the conversion that completes the second one is running: */
+		setup();
+		first_conversion = scan_start(list);
+		for (uint16_t i = 1; i < (2U * scan_conversions_count(list)); i++)
+		{
+			(void)host_adc_conversion_complete();
+		}
+		
+		/* The burst completes the second scan and the whole third one, which is written in the buffer of the first: */
+		memset(results, 0xFF, sizeof(results));
+		scan_count = interrupted_snapshot_get(instructions, scan_conversions_count(list) + 1U, results);
+		if (!g_interrupt_injected)
+		{
+			/* The snapshot returned before the chosen instruction, every instruction of it was tried: */
+			break;
+		}
+		
+		if ((1U > scan_count) || (3U < scan_count))
+		{
+			snapshots_right = 0;
+		}
+		else
+		{
+			old_snapshots |= (1U == scan_count);
+			new_snapshots |= (1U != scan_count);
+			scan_expected_get(list, first_conversion, scan_count, expected);
+			if (0 != memcmp(results, expected, list->channels_count * sizeof(uint16_t)))
+			{
+				printf("  interrupts after %ld instructions: scan %u torn\n", instructions, scan_count);
+				snapshots_right = 0;
+			}
+		}
+		adc_scan_stop();
+	}
+	
+	signal(SIGTRAP, SIG_DFL);
+	printf("  snapshot interrupted after each of its %ld instructions\n", instructions);
+	check(MAX_TRACED_INSTRUCTIONS > instructions, "the snapshot returns");
+	check(old_snapshots && new_snapshots, "the interrupts land both before and after the snapshot is taken");
+	check(snapshots_right, "scans completing during the snapshot never tear it");
+}
+#endif
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(void)
+{
+	preload_order_test();
+	buffer_swap_test();
+	restart_test();
+	paced_scan_test();
+	#if defined(__x86_64__)
+	coherence_test();
+	#else
+	printf("  the snapshot coherence test needs an x86-64 host, skipped\n");
+	#endif
+	
+	printf("test_adc_scan: %lu failures\n", g_failures);
+	
+	return (0 == g_failures) ? 0 : 1;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
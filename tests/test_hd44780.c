@@ -0,0 +1,486 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  test_hd44780.c
+*
+** Description:
+*  This file runs the LCD driver against the HD44780 controller model, in the configuration of the "lcd_config.h" it
+*  is built with. It checks what the controllers show and hold after each operation, that no transfer breaks a
+*  datasheet timing, and prints the bus time and the transfers of each operation, so a change to the driver can be
+*  measured on Linux.
+*  With the I2C expander backend, the TWI model carries the expander bytes, which a PCF8574 model puts on a port
+*  register of the host, wired to the LCD model as the backpack is. The operations then also wait for the bus, and
+*  print the expander bytes and the I2C transactions that carried them.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "lcd_config.h"
+#include <util/delay.h>
+#include <avr/interrupt.h>
+#include "gpio_atmega32.h"
+#include "twi_atmega32.h"
+#include "host_avr.h"
+#include "host_hd44780.h"
+#include "host_twi.h"
+#include "lcd.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+/* The option values lcd.c gives to the settings of "lcd_config.h": */
+#define   LCD_4BIT_OPERATION          (0)
+#define   LCD_8BIT_OPERATION          (1)
+#define   LCD_FIXED_DELAYS            (0)
+#define   LCD_BUSY_FLAG_POLLING       (1)
+#define   LCD_GPIO_DRIVER_BACKEND        (0)
+#define   LCD_DIRECT_REGISTERS_BACKEND   (1)
+#define   LCD_PCF8574_BACKEND            (2)
+
+#define   HOST_PORT(gpio_port)        ((host_io_t)(HOST_PORTA + (3U * (gpio_port))))
+#define   SET_CGRAM_ADDRESS_COMMAND   (0x40U)
+#define   SET_DDRAM_ADDRESS_COMMAND   (0x80U)
+#define   CLEAR_DISPLAY_COMMAND       (0x01U)
+#define   GLYPH_ROWS                  (8U)
+#define   ALTERNATE_CHARACTERS        (LCD_COLUMNS - 1U)
+#define   STRING_CHARACTERS           (13U)
+
+#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+/* The PCF8574 outputs, on a port of the host: P0=RS, P1=RW, P2=EN, P3=backlight and P4-P7=D4-D7. They are all high
+   at power on: */
+#define   EXPANDER_PORT               (HOST_PORTB)
+#define   EXPANDER_DIRECTION          (HOST_DDRB)
+#define   EXPANDER_RS                 (0U)
+#define   EXPANDER_RW                 (1U)
+#define   EXPANDER_EN                 (2U)
+#define   EXPANDER_POWER_ON_OUTPUTS   (0xFFU)
+#define   EXPANDER_BYTES_PER_NIBBLE   (2U)
+#define   SENSOR_ADDRESS              (0x48U)
+#define   SHARED_SCL_FREQUENCY        (200000UL)  /* Not LCD_I2C_SCL_FREQ, and in reach of TWBR at 12 MHz. */
+#define   BUS_WAIT_STEP_NS            (1000ULL)
+#define   ENABLE_PORT                 EXPANDER_PORT
+#define   ENABLE_PIN                  EXPANDER_EN
+#else
+#define   ENABLE_PORT                 HOST_PORT(LCD_EN_CNTRL_PORT)
+#define   ENABLE_PIN                  LCD_EN
+#endif
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static const uint8_t g_glyph[GLYPH_ROWS] = {0x00, 0x0A, 0x1F, 0x1F, 0x0E, 0x04, 0x00, 0x00};
+static lcd_std_error_type_t g_init_error;
+static unsigned long g_failures;
+
+#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+static host_twi_slave_t g_expander;
+static host_twi_slave_t g_sensor;
+static const uint8_t g_sensor_data[] = {0x19, 0x80};
+
+/* The expander bytes and the I2C transactions of the last operation: */
+static uint16_t g_expander_bytes;
+static uint16_t g_expander_transactions;
+#endif
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+static void check(int condition, const char* description)
+{
+	if (!condition)
+	{
+		printf("FAIL: %s\n", description);
+		g_failures++;
+	}
+}
+
+static void line_check(uint8_t display, uint8_t line, const char* expected, const char* description)
+{
+	char text[LCD_COLUMNS + 1U];
+	char padded[LCD_COLUMNS + 1U];
+	
+	snprintf(padded, sizeof(padded), "%-*s", (int)LCD_COLUMNS, expected);
+	host_hd44780_line_get(display, line, LCD_COLUMNS, text);
+	if (0 != strcmp(text, padded))
+	{
+		printf("display %u line %u: \"%s\", expected \"%s\"\n", display, line, text, padded);
+	}
+	check(0 == strcmp(text, padded), description);
+}
+
+#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+/* The PCF8574 sets its outputs to each byte written to it: */
+static void expander_byte_written(host_twi_slave_t* slave, uint8_t data_byte)
+{
+	(void)slave;
+	host_io[EXPANDER_PORT] = data_byte;
+}
+
+/* The TWI model goes first, so the LCD model sees the expander outputs at the time of the byte that set them: */
+static void models_io_listener(host_io_t io_register)
+{
+	host_twi_io_listener(io_register);
+	host_hd44780_io_listener(io_register);
+}
+
+static void bus_idle_wait(void)
+{
+	while (!twi_bus_is_idle())
+	{
+		host_delay_ns(BUS_WAIT_STEP_NS);
+	}
+}
+#endif
+
+static void wiring_get(host_hd44780_wiring_t* wiring, uint8_t read_write_connected)
+{
+	memset(wiring, 0, sizeof(*wiring));
+	memset(wiring->data_pins, HOST_HD44780_NOT_CONNECTED, sizeof(wiring->data_pins));
+	
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	wiring->data_port = EXPANDER_PORT;
+	for (uint8_t pin = 4; pin < 8U; pin++)
+	{
+		wiring->data_pins[pin] = pin;
+	}
+	wiring->register_select.port = EXPANDER_PORT;
+	wiring->register_select.pin = EXPANDER_RS;
+	wiring->read_write.port = EXPANDER_PORT;
+	wiring->read_write.pin = read_write_connected ? EXPANDER_RW : HOST_HD44780_NOT_CONNECTED;
+	wiring->enable[0].port = EXPANDER_PORT;
+	wiring->enable[0].pin = EXPANDER_EN;
+	wiring->displays_count = 1;
+	
+	#else
+	wiring->data_port = HOST_PORT(LCD_DATA_PORT);
+	#if (LCD_8BIT_OPERATION == LCD_MODE)
+	wiring->data_pins[0] = LCD_D0;
+	wiring->data_pins[1] = LCD_D1;
+	wiring->data_pins[2] = LCD_D2;
+	wiring->data_pins[3] = LCD_D3;
+	#endif
+	wiring->data_pins[4] = LCD_D4;
+	wiring->data_pins[5] = LCD_D5;
+	wiring->data_pins[6] = LCD_D6;
+	wiring->data_pins[7] = LCD_D7;
+	
+	wiring->register_select.port = HOST_PORT(LCD_RS_CNTRL_PORT);
+	wiring->register_select.pin = LCD_RS;
+	wiring->read_write.port = HOST_PORT(LCD_RW_CNTRL_PORT);
+	wiring->read_write.pin = read_write_connected ? LCD_RW : HOST_HD44780_NOT_CONNECTED;
+	wiring->enable[0].port = HOST_PORT(LCD_EN_CNTRL_PORT);
+	wiring->enable[0].pin = LCD_EN;
+	wiring->enable[1].port = HOST_PORT(LCD_EN2_CNTRL_PORT);
+	wiring->enable[1].pin = LCD_EN2;
+	wiring->enable[2].port = HOST_PORT(LCD_EN3_CNTRL_PORT);
+	wiring->enable[2].pin = LCD_EN3;
+	wiring->displays_count = LCD_DISPLAY_COUNT;
+	#endif
+}
+
+/* Powers the models on, with the I2C expander and a sensor on the bus in its configuration: */
+static void models_power_on(uint8_t read_write_connected)
+{
+	host_hd44780_wiring_t wiring;
+	
+	host_reset(HOST_DEFAULT_CPU_FREQUENCY);
+	wiring_get(&wiring, read_write_connected);
+	
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	host_io[EXPANDER_PORT] = EXPANDER_POWER_ON_OUTPUTS;
+	host_io[EXPANDER_DIRECTION] = 0xFFU;
+	host_hd44780_power_on(&wiring);
+	host_twi_power_on();
+	memset(&g_expander, 0, sizeof(g_expander));
+	g_expander.address = LCD_I2C_ADDRESS;
+	g_expander.byte_written = expander_byte_written;
+	host_twi_slave_attach(&g_expander);
+	memset(&g_sensor, 0, sizeof(g_sensor));
+	g_sensor.address = SENSOR_ADDRESS;
+	g_sensor.read_data = g_sensor_data;
+	g_sensor.read_length = sizeof(g_sensor_data);
+	host_twi_slave_attach(&g_sensor);
+	host_io_listener_set(models_io_listener);
+	/* The TWI driver needs the interrupts: */
+	sei();
+	
+	#else
+	host_hd44780_power_on(&wiring);
+	host_io_listener_set(host_hd44780_io_listener);
+	#endif
+}
+
+/* Runs an operation, checks that it breaks no timing unless told otherwise, and prints its bus time and transfers: */
+static void operation_measure(const char* name, void (*operation)(void), uint8_t violations_allowed)
+{
+	host_hd44780_statistics_t statistics;
+	host_hd44780_statistics_t total = {0};
+	uint64_t start_ns;
+	uint64_t bus_time_ns;
+	
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	uint16_t expander_bytes = g_expander.written_count;
+	uint16_t expander_transactions = g_expander.transfers;
+	#endif
+	
+	host_hd44780_statistics_clear();
+	start_ns = host_time_ns();
+	operation();
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	/* The functions return before the expander bytes are on the bus: */
+	bus_idle_wait();
+	#endif
+	bus_time_ns = host_time_ns() - start_ns;
+	
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		host_hd44780_statistics_get(display, &statistics);
+		total.instructions += statistics.instructions;
+		total.data_writes += statistics.data_writes;
+		total.busy_flag_reads += statistics.busy_flag_reads;
+		total.violations += statistics.violations;
+	}
+	
+	printf("  %-34s %8llu.%03llu us %4u instructions %4u data writes %5u busy flag reads\n", name,
+	       (unsigned long long)(bus_time_ns / 1000ULL), (unsigned long long)(bus_time_ns % 1000ULL),
+	       (unsigned)total.instructions, (unsigned)total.data_writes, (unsigned)total.busy_flag_reads);
+	check(violations_allowed || (0U == total.violations), name);
+	
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	g_expander_bytes = g_expander.written_count - expander_bytes;
+	g_expander_transactions = g_expander.transfers - expander_transactions;
+	printf("  %-34s %4u expander bytes in %3u I2C transactions\n", "", (unsigned)g_expander_bytes,
+	       (unsigned)g_expander_transactions);
+	#endif
+	
+	#if (LCD_FIXED_DELAYS == LCD_WAIT_MODE)
+	check(0U == total.busy_flag_reads, "the fixed delays never read the busy flag");
+	#endif
+}
+
+static void init_operation(void)
+{
+	g_init_error = lcd_init();
+}
+
+static void string_operation(void)
+{
+	lcd_string_write("Hello, world!");
+}
+
+static void second_line_operation(void)
+{
+	(void)lcd_gotoxy(0, 1);
+	lcd_string_write("0123456789ABCDEF");
+}
+
+static void glyph_operation(void)
+{
+	(void)lcd_command_send(SET_CGRAM_ADDRESS_COMMAND);
+	for (uint8_t row = 0; row < GLYPH_ROWS; row++)
+	{
+		lcd_character_write(g_glyph[row]);
+	}
+	(void)lcd_command_send(SET_DDRAM_ADDRESS_COMMAND);
+	lcd_character_write(0);
+}
+
+static void clear_operation(void)
+{
+	(void)lcd_command_send(CLEAR_DISPLAY_COMMAND);
+	lcd_string_write("Cleared");
+}
+
+#if (1U < LCD_DISPLAY_COUNT)
+/* Each display finishes its instruction while the other one is written, as far as the transfers take: */
+static void alternate_operation(void)
+{
+	for (uint8_t i = 0; i < ALTERNATE_CHARACTERS; i++)
+	{
+		for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+		{
+			(void)lcd_display_select(display);
+			lcd_character_write('a' + display);
+		}
+	}
+	(void)lcd_display_select(0);
+}
+
+static void alternate_clear_operation(void)
+{
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		(void)lcd_display_select(display);
+		(void)lcd_command_send(CLEAR_DISPLAY_COMMAND);
+	}
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		(void)lcd_display_select(display);
+		lcd_character_write('0' + display);
+	}
+	(void)lcd_display_select(0);
+}
+#endif
+
+static void driver_test(uint8_t read_write_connected)
+{
+	host_hd44780_state_t state;
+	lcd_init_trace_t init_trace;
+	
+	if (!read_write_connected)
+	{
+		/* The LCD is written by each poll, which the model reports, until the driver gives up on the busy flag: */
+		printf("  the busy flag polls of lcd_init() are writes with RW tied to ground:\n");
+		fflush(stdout);
+	}
+	operation_measure("lcd_init()", init_operation, !read_write_connected);
+	check(LCD_OK == g_init_error, "lcd_init() succeeds");
+	for (uint8_t display = 0; display < LCD_DISPLAY_COUNT; display++)
+	{
+		host_hd44780_state_get(display, &state);
+		check(state.display_on && state.cursor_on && state.increment && state.two_lines && !state.display_shift,
+		      "lcd_init() turns the display on with the cursor moving right");
+		check((LCD_8BIT_OPERATION == LCD_MODE) == state.eight_bit_interface,
+		      "lcd_init() sets the interface width");
+		check(0U == state.address_counter, "lcd_init() clears the display");
+		line_check(display, 0, "", "lcd_init() clears the display");
+	}
+	(void)lcd_init_trace_get(&init_trace);
+	check(((LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE) && read_write_connected) == init_trace.busy_flag_usable,
+	      "the busy flag is used after lcd_init() when it can be read");
+	
+	operation_measure("lcd_string_write(13 characters)", string_operation, 0);
+	line_check(0, 0, "Hello, world!", "the string is on the first line");
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	/* Each character is both nibbles with their enable pulses, after one byte that selects the data register, and the
+	   ones written while a transaction is on the bus are sent together by the next one: */
+	check(((2U * EXPANDER_BYTES_PER_NIBBLE * STRING_CHARACTERS) + 1U) == g_expander_bytes,
+	      "each character is 4 expander bytes, after the one selecting the data register");
+	check((1U < g_expander_transactions) && (STRING_CHARACTERS > g_expander_transactions),
+	      "the characters written during a transaction are batched in the other buffer");
+	#endif
+	
+	operation_measure("lcd_gotoxy() + 16 characters", second_line_operation, 0);
+	line_check(0, 1, "0123456789ABCDEF", "the string is on the second line");
+	
+	operation_measure("CGRAM glyph upload + 1 character", glyph_operation, 0);
+	host_hd44780_state_get(0, &state);
+	check(0 == memcmp(state.cgram, g_glyph, GLYPH_ROWS), "the glyph is in CGRAM character 0");
+	check(0x00U == state.ddram[0], "the glyph is shown at the first character");
+	
+	operation_measure("clear + 7 characters", clear_operation, 0);
+	line_check(0, 0, "Cleared", "the display is cleared before the string");
+	line_check(0, 1, "", "the display is cleared before the string");
+	
+	#if (1U < LCD_DISPLAY_COUNT)
+	operation_measure("clear each display + 1 character", alternate_clear_operation, 0);
+	operation_measure("15 characters to each display", alternate_operation, 0);
+	line_check(0, 0, "0aaaaaaaaaaaaaaa", "the characters of display 0 stay on display 0");
+	line_check(1, 0, "1bbbbbbbbbbbbbbb", "the characters of display 1 stay on display 1");
+	#endif
+}
+
+/* The model has to catch a transfer that comes too early. The enable pin is pulsed by hand right after a clear
+   display command, which leaves the controller busy for 1.52 ms: */
+static void model_test(void)
+{
+	host_hd44780_statistics_t statistics;
+	
+	printf("  a write while busy, which the model has to report:\n");
+	fflush(stdout);
+	(void)lcd_command_send(CLEAR_DISPLAY_COMMAND);
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	/* The pulse by hand can't share the expander outputs with the bytes of the command still on the bus: */
+	bus_idle_wait();
+	#endif
+	host_hd44780_statistics_clear();
+	HOST_IO(ENABLE_PORT) |= (uint8_t)(1U << ENABLE_PIN);
+	_delay_us(1);
+	HOST_IO(ENABLE_PORT) &= (uint8_t)~(1U << ENABLE_PIN);
+	(void)HOST_IO(ENABLE_PORT);
+	
+	host_hd44780_statistics_get(0, &statistics);
+	check(1U == statistics.violations, "a write while the controller is busy is flagged");
+}
+
+#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+/* The application starts the TWI driver for its other slaves, and has a transaction on the bus when lcd_init() is
+   called, which has to keep it, with the bit rate of the application: */
+static void twi_sharing_test(void)
+{
+	static const uint8_t sensor_register = 0x00U;
+	static uint8_t sensor_value[2];
+	static twi_transaction_t sensor_read = {SENSOR_ADDRESS, &sensor_register, 1, sensor_value, 2, NULL,
+	                                        TWI_TRANSACTION_DONE};
+	uint8_t bit_rate;
+	
+	models_power_on(1);
+	check(TWI_E_OK == twi_master_init(SHARED_SCL_FREQUENCY, HOST_DEFAULT_CPU_FREQUENCY), "the application starts TWI");
+	bit_rate = TWBR;
+	check(TWI_E_OK == twi_transaction_submit(&sensor_read), "the application reads its sensor");
+	
+	check(LCD_OK == lcd_init(), "lcd_init() works with the TWI driver started by the application");
+	lcd_string_write("Shared bus");
+	bus_idle_wait();
+	check((TWI_TRANSACTION_DONE == sensor_read.status) && (0 == memcmp(sensor_value, g_sensor_data, 2U)),
+	      "lcd_init() keeps the transactions of the other slaves");
+	check((bit_rate == TWBR) && (0U == host_twi_errors_get()), "lcd_init() keeps the TWI driver of the application");
+	line_check(0, 0, "Shared bus", "the LCD works on the shared bus");
+}
+#endif
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(void)
+{
+	/* With the busy flag polling, the driver is also run with the RW pin tied to ground, which it has to notice and
+	   switch to the fixed delays: */
+	for (uint8_t read_write_connected = 1; read_write_connected <= 1; read_write_connected--)
+	{
+		models_power_on(read_write_connected);
+		
+		printf("test_hd44780 (%s, %s, %u display%s%s%s):\n", (LCD_8BIT_OPERATION == LCD_MODE) ? "8 bit" : "4 bit",
+		       (LCD_BUSY_FLAG_POLLING == LCD_WAIT_MODE) ? "busy flag" : "fixed delays", (unsigned)LCD_DISPLAY_COUNT,
+		       (1U == LCD_DISPLAY_COUNT) ? "" : "s",
+		       (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND) ? ", I2C expander" : "",
+		       read_write_connected ? "" : ", RW tied to ground");
+		driver_test(read_write_connected);
+		model_test();
+		
+		if (LCD_BUSY_FLAG_POLLING != LCD_WAIT_MODE)
+		{
+			break;
+		}
+	}
+	#if (LCD_PCF8574_BACKEND == LCD_PIN_BACKEND)
+	twi_sharing_test();
+	#endif
+	
+	printf("test_hd44780: %lu failures\n", g_failures);
+	
+	return (0 == g_failures) ? 0 : 1;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
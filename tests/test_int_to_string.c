@@ -0,0 +1,156 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  test_int_to_string.c
+*
+** Description:
+*  This file checks lcd_int_to_string() against snprintf() on the host. By default it checks every 16-bit number and
+*  a spread of 32-bit numbers around each power of ten with every digit count. Passing "full" also checks all the
+*  2^32 numbers with LCD_INT_DIGITS_AUTO, which takes about ten minutes.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "lcd.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   MAX_DIGITS              (10U)
+#define   STRING_SIZE             (MAX_DIGITS + 1U)
+#define   REFERENCE_SIZE          (32U)
+#define   BOUNDARY_DISTANCE       (1000UL)
+#define   SWEEP_STEP              (65521UL)   /* Prime, so the sweep hits every residue of the low digits. */
+#define   MAX_REPORTED_FAILURES   (10UL)
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static unsigned long g_checks;
+static unsigned long g_failures;
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+static void number_check(uint32_t number, uint8_t number_of_digits)
+{
+	char result[STRING_SIZE + 1U];
+	char reference[REFERENCE_SIZE];
+	int reference_length;
+	const char* expected;
+	
+	memset(result, 'x', sizeof(result));
+	lcd_int_to_string(number, number_of_digits, result);
+	
+	if (LCD_INT_DIGITS_AUTO == number_of_digits)
+	{
+		expected = reference;
+		snprintf(reference, sizeof(reference), "%lu", (unsigned long)number);
+	}
+	else
+	{
+		/* Zero padded to the digit count, then only the last number_of_digits digits are kept: */
+		reference_length = snprintf(reference, sizeof(reference), "%0*lu", (int)number_of_digits,
+		                            (unsigned long)number);
+		expected = &reference[reference_length - number_of_digits];
+	}
+	
+	g_checks++;
+	
+	if (0 != strcmp(result, expected))
+	{
+		if (g_failures < MAX_REPORTED_FAILURES)
+		{
+			printf("FAIL: lcd_int_to_string(%lu, %u) = \"%.*s\", expected \"%s\"\n", (unsigned long)number,
+			       number_of_digits, (int)STRING_SIZE, result, expected);
+		}
+		
+		g_failures++;
+	}
+}
+
+static void number_check_all_widths(uint32_t number)
+{
+	for (uint8_t number_of_digits = LCD_INT_DIGITS_AUTO; number_of_digits <= MAX_DIGITS; number_of_digits++)
+	{
+		number_check(number, number_of_digits);
+	}
+}
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(int argc, char* argv[])
+{
+	uint32_t power_of_ten = 10UL;
+	
+	/* Every 16-bit number, which covers the whole 16-bit path: */
+	for (uint32_t number = 0; number <= UINT16_MAX; number++)
+	{
+		number_check_all_widths(number);
+	}
+	
+	/* Both sides of every power of ten, where the digit count and the 32-bit to 16-bit switch change: */
+	for (uint8_t i = 1; i < MAX_DIGITS; i++)
+	{
+		uint32_t first_number = (power_of_ten > BOUNDARY_DISTANCE) ? (power_of_ten - BOUNDARY_DISTANCE) : 0;
+		
+		for (uint32_t number = first_number; number != power_of_ten + BOUNDARY_DISTANCE; number++)
+		{
+			number_check_all_widths(number);
+		}
+		
+		power_of_ten *= 10UL;
+	}
+	
+	for (uint32_t number = UINT32_MAX - BOUNDARY_DISTANCE; number != 0; number++)
+	{
+		number_check_all_widths(number);
+	}
+	
+	number_check_all_widths(UINT32_MAX);
+	
+	/* A sweep across the whole 32-bit range: */
+	for (uint64_t number = 0; number <= UINT32_MAX; number += SWEEP_STEP)
+	{
+		number_check_all_widths((uint32_t)number);
+	}
+	
+	if ((argc > 1) && (0 == strcmp(argv[1], "full")))
+	{
+		uint32_t number = 0;
+		
+		do
+		{
+			number_check(number, LCD_INT_DIGITS_AUTO);
+			number++;
+		} while (0 != number);
+	}
+	
+	printf("test_int_to_string: %lu checks, %lu failures\n", g_checks, g_failures);
+	
+	return (0 == g_failures) ? 0 : 1;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,160 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  test_lcd_glyph.c
+*
+** Description:
+*  This file checks the least recently used slot choice of the CGRAM glyph manager on the host, including glyphs left
+*  idle for more frames than a frame counter of 8 bits can count.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <avr/pgmspace.h>
+#include "host_avr.h"
+#include "lcd.h"
+#include "lcd_glyph.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   TEST_GLYPHS_COUNT   (LCD_GLYPH_SLOTS_COUNT + 2U)
+#define   WRAP_FRAMES         (256U)
+#define   SHORT_IDLE_FRAMES   (100U)
+#define   LONG_IDLE_FRAMES    (1000U)
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static const uint8_t g_test_glyphs[TEST_GLYPHS_COUNT][LCD_GLYPH_ROWS] PROGMEM = {{0}};
+static unsigned long g_failures;
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+static void check(int condition, const char* description)
+{
+	if (!condition)
+	{
+		printf("FAIL: %s\n", description);
+		g_failures++;
+	}
+}
+
+static void frames_flush(uint16_t frames_count)
+{
+	for (uint16_t frame = 0; frame < frames_count; frame++)
+	{
+		lcd_glyph_flush();
+	}
+}
+
+/* Fills all the slots, glyph i in slot i, and ends the frame: */
+static void slots_fill(void)
+{
+	uint8_t character_code;
+	
+	lcd_glyph_reset();
+	for (uint8_t i = 0; i < LCD_GLYPH_SLOTS_COUNT; i++)
+	{
+		check((LCD_OK == lcd_glyph_acquire(g_test_glyphs[i], &character_code)) && (i == character_code),
+		      "a free slot is given to a new glyph");
+	}
+	lcd_glyph_flush();
+}
+
+static void full_frame_test(void)
+{
+	uint8_t character_code;
+	
+	lcd_glyph_reset();
+	for (uint8_t i = 0; i < LCD_GLYPH_SLOTS_COUNT; i++)
+	{
+		(void)lcd_glyph_acquire(g_test_glyphs[i], &character_code);
+	}
+	
+	check(LCD_NOT_OK == lcd_glyph_acquire(g_test_glyphs[LCD_GLYPH_SLOTS_COUNT], &character_code),
+	      "glyphs of the current frame are never evicted");
+}
+
+static void wrap_test(void)
+{
+	uint8_t character_code;
+	
+	/* After 256 frames an 8-bit frame counter reads the same again, and the idle glyphs looked just used: */
+	slots_fill();
+	frames_flush(WRAP_FRAMES - 1U);
+	check(LCD_OK == lcd_glyph_acquire(g_test_glyphs[LCD_GLYPH_SLOTS_COUNT], &character_code),
+	      "a glyph idle for 256 frames is evicted");
+	
+	slots_fill();
+	frames_flush(LONG_IDLE_FRAMES);
+	check(LCD_OK == lcd_glyph_acquire(g_test_glyphs[LCD_GLYPH_SLOTS_COUNT], &character_code),
+	      "a glyph idle for 1000 frames is evicted");
+}
+
+static void least_recently_used_test(void)
+{
+	uint8_t character_code;
+	
+	/* Every glyph but the one in slot 3 is used again one frame later, so slot 3 is the least recently used: */
+	slots_fill();
+	for (uint8_t i = 0; i < LCD_GLYPH_SLOTS_COUNT; i++)
+	{
+		if (3U != i)
+		{
+			(void)lcd_glyph_acquire(g_test_glyphs[i], &character_code);
+		}
+	}
+	frames_flush(SHORT_IDLE_FRAMES);
+	
+	check((LCD_OK == lcd_glyph_acquire(g_test_glyphs[LCD_GLYPH_SLOTS_COUNT], &character_code)) &&
+	      (3U == character_code), "the least recently used glyph is evicted");
+	
+	/* The glyph just evicted needs a slot again, and slot 3 now holds a glyph of the current frame: */
+	check((LCD_OK == lcd_glyph_acquire(g_test_glyphs[3], &character_code)) && (3U != character_code),
+	      "an evicted glyph gets another slot");
+	
+	/* Resident glyphs keep their slot: */
+	check((LCD_OK == lcd_glyph_acquire(g_test_glyphs[LCD_GLYPH_SLOTS_COUNT], &character_code)) &&
+	      (3U == character_code), "a resident glyph keeps its slot");
+}
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(void)
+{
+	host_reset(HOST_DEFAULT_CPU_FREQUENCY);
+	lcd_init();
+	
+	full_frame_test();
+	wrap_test();
+	least_recently_used_test();
+	
+	printf("test_lcd_glyph: %lu failures\n", g_failures);
+	
+	return (0 == g_failures) ? 0 : 1;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
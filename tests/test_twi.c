@@ -0,0 +1,325 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  test_twi.c
+*
+** Description:
+*  This file runs the TWI master driver against the TWI model, stepping the bus one action at a time, with TWI_vect
+*  called on each flag. It checks the bus events and the status of a write, a read, a write then read with a repeated
+*  start, a refused address and a refused byte, and that queued transactions follow each other with the STOP and the
+*  next START in a single bus action, also when a completion callback submits the next one. It also lets the bus run
+*  on its own time, to check that a write takes the bus time of its bits.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "host_avr.h"
+#include "host_twi.h"
+#include "twi_atmega32.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   SENSOR_ADDRESS       (0x48U)
+#define   EEPROM_ADDRESS       (0x50U)
+#define   MISSING_ADDRESS      (0x3CU)
+#define   SCL_FREQUENCY        (100000UL)
+#define   WAIT_STEP_NS         (1000ULL)
+#define   MAX_WAIT_NS          (10000000ULL)
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static const uint8_t g_sensor_data[] = {0x12, 0x34, 0x56};
+static const uint8_t g_write_bytes[] = {0x01, 0xA5, 0x5A};
+static uint8_t g_read_bytes[3];
+
+static host_twi_slave_t g_sensor;
+static host_twi_slave_t g_eeprom;
+
+static twi_transaction_t g_first;
+static twi_transaction_t g_second;
+static twi_transaction_t g_third;
+static uint8_t g_callbacks;
+
+static unsigned long g_failures;
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+static void check(int condition, const char* description)
+{
+	if (!condition)
+	{
+		printf("FAIL: %s\n", description);
+		g_failures++;
+	}
+}
+
+static void trace_check(const char* expected, const char* description)
+{
+	if (0 != strcmp(host_twi_trace_get(), expected))
+	{
+		printf("  bus: \"%s\", expected \"%s\"\n", host_twi_trace_get(), expected);
+		check(0, description);
+	}
+}
+
+static void transaction_set(twi_transaction_t* transaction, uint8_t address, uint8_t write_length,
+                            uint8_t read_length, void (*complete_callback)(twi_transaction_t*))
+{
+	transaction->slave_address = address;
+	transaction->write_buffer = g_write_bytes;
+	transaction->write_length = write_length;
+	transaction->read_buffer = g_read_bytes;
+	transaction->read_length = read_length;
+	transaction->complete_callback = complete_callback;
+	transaction->status = TWI_TRANSACTION_DONE;
+}
+
+static void counting_callback(twi_transaction_t* transaction)
+{
+	(void)transaction;
+	g_callbacks++;
+}
+
+/* Submits the next transaction from the interrupt, while the STOP of this one is still on the bus: */
+static void chaining_callback(twi_transaction_t* transaction)
+{
+	(void)transaction;
+	g_callbacks++;
+	check(TWI_E_OK == twi_transaction_submit(&g_second), "a callback can submit a transaction");
+}
+
+static void setup(void)
+{
+	host_reset(HOST_DEFAULT_CPU_FREQUENCY);
+	host_twi_power_on();
+	host_io_listener_set(host_twi_io_listener);
+	
+	memset(&g_sensor, 0, sizeof(g_sensor));
+	g_sensor.address = SENSOR_ADDRESS;
+	g_sensor.read_data = g_sensor_data;
+	g_sensor.read_length = sizeof(g_sensor_data);
+	host_twi_slave_attach(&g_sensor);
+	
+	memset(&g_eeprom, 0, sizeof(g_eeprom));
+	g_eeprom.address = EEPROM_ADDRESS;
+	host_twi_slave_attach(&g_eeprom);
+	
+	memset(g_read_bytes, 0, sizeof(g_read_bytes));
+	g_callbacks = 0;
+	
+	check(TWI_E_OK == twi_master_init(SCL_FREQUENCY, HOST_DEFAULT_CPU_FREQUENCY), "the driver starts");
+	sei();
+}
+
+static void write_test(void)
+{
+	setup();
+	transaction_set(&g_first, SENSOR_ADDRESS, 3U, 0U, counting_callback);
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "a write is queued");
+	check(TWI_TRANSACTION_IN_PROGRESS == g_first.status, "a write on a free bus starts at once");
+	
+	/* START, address, 3 bytes, STOP: */
+	check(6U == host_twi_run(), "a write of 3 bytes takes 6 bus actions");
+	trace_check("S 48W+ 01+ A5+ 5A+ P", "a write sends the address and the bytes, then a STOP");
+	check((TWI_TRANSACTION_DONE == g_first.status) && (1U == g_callbacks) && twi_bus_is_idle(),
+	      "a write is done, with its callback");
+	check((3U == g_sensor.written_count) && (0 == memcmp(g_sensor.written, g_write_bytes, 3U)),
+	      "the slave gets the written bytes");
+	check(0U == host_twi_errors_get(), "a write has no bus errors");
+}
+
+static void read_test(void)
+{
+	setup();
+	transaction_set(&g_first, SENSOR_ADDRESS, 0U, 3U, counting_callback);
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "a read is queued");
+	check(6U == host_twi_run(), "a read of 3 bytes takes 6 bus actions");
+	trace_check("S 48R+ r12+ r34+ r56- P", "a read answers the last byte with a NACK, then sends a STOP");
+	check((TWI_TRANSACTION_DONE == g_first.status) && (1U == g_callbacks), "a read is done, with its callback");
+	check(0 == memcmp(g_read_bytes, g_sensor_data, 3U), "a read gets the bytes of the slave");
+	
+	/* A single byte is answered with a NACK at once: */
+	setup();
+	transaction_set(&g_first, SENSOR_ADDRESS, 0U, 1U, NULL);
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "a one byte read is queued");
+	(void)host_twi_run();
+	trace_check("S 48R+ r12- P", "a one byte read answers it with a NACK");
+	check((TWI_TRANSACTION_DONE == g_first.status) && (0x12U == g_read_bytes[0]) && (0U == host_twi_errors_get()),
+	      "a one byte read is done");
+}
+
+static void write_then_read_test(void)
+{
+	setup();
+	transaction_set(&g_first, SENSOR_ADDRESS, 1U, 2U, counting_callback);
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "a write then read is queued");
+	check(8U == host_twi_run(), "a 1 byte write and 2 byte read take 8 bus actions");
+	trace_check("S 48W+ 01+ Sr 48R+ r12+ r34- P", "the read follows the write after a repeated start, with no STOP");
+	check((TWI_TRANSACTION_DONE == g_first.status) && (1U == g_callbacks) &&
+	      (0x12U == g_read_bytes[0]) && (0x34U == g_read_bytes[1]) && (0U == host_twi_errors_get()),
+	      "a write then read is done");
+}
+
+static void address_nack_test(void)
+{
+	setup();
+	transaction_set(&g_first, MISSING_ADDRESS, 2U, 0U, counting_callback);
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "a write to a missing slave is queued");
+	(void)host_twi_run();
+	trace_check("S 3CW- P", "a refused address ends the write with a STOP");
+	check((TWI_TRANSACTION_ADDRESS_NACK == g_first.status) && (1U == g_callbacks), "a write reports the address NACK");
+	
+	setup();
+	g_sensor.address_nack = 1;
+	transaction_set(&g_first, SENSOR_ADDRESS, 0U, 2U, counting_callback);
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "a read of a busy slave is queued");
+	(void)host_twi_run();
+	trace_check("S 48R- P", "a refused address ends the read with a STOP");
+	check((TWI_TRANSACTION_ADDRESS_NACK == g_first.status) && (0U == g_sensor.read_count) &&
+	      (0U == host_twi_errors_get()), "a read reports the address NACK");
+}
+
+static void data_nack_test(void)
+{
+	setup();
+	g_sensor.data_nack_byte = 2;
+	transaction_set(&g_first, SENSOR_ADDRESS, 3U, 0U, counting_callback);
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "a write is queued");
+	(void)host_twi_run();
+	trace_check("S 48W+ 01+ A5- P", "a refused byte ends the write with a STOP");
+	check((TWI_TRANSACTION_DATA_NACK == g_first.status) && (1U == g_callbacks), "a write reports the data NACK");
+	
+	/* Many slaves refuse the last byte, which isn't an error, and the read still follows: */
+	setup();
+	g_sensor.data_nack_byte = 1;
+	transaction_set(&g_first, SENSOR_ADDRESS, 1U, 1U, counting_callback);
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "a write then read is queued");
+	(void)host_twi_run();
+	trace_check("S 48W+ 01- Sr 48R+ r12- P", "a refused last byte goes on with the read");
+	check((TWI_TRANSACTION_DONE == g_first.status) && (0U == host_twi_errors_get()),
+	      "a refused last byte is not an error");
+}
+
+static void chaining_test(void)
+{
+	uint16_t steps = 0;
+	const char* trace;
+	
+	/* Queued before the first one finishes: */
+	setup();
+	transaction_set(&g_first, SENSOR_ADDRESS, 1U, 0U, counting_callback);
+	transaction_set(&g_second, EEPROM_ADDRESS, 2U, 0U, counting_callback);
+	transaction_set(&g_third, SENSOR_ADDRESS, 0U, 1U, counting_callback);
+	check((TWI_E_OK == twi_transaction_submit(&g_first)) && (TWI_E_OK == twi_transaction_submit(&g_second)) &&
+	      (TWI_E_OK == twi_transaction_submit(&g_third)), "three transactions are queued");
+	check((TWI_TRANSACTION_QUEUED == g_second.status) && (TWI_TRANSACTION_QUEUED == g_third.status) &&
+	      !twi_bus_is_idle(), "the queued transactions wait for the one in progress");
+	
+	/* START, address and byte of the first one, then the STOP and the next START go in one action: */
+	while ((3U > steps) && host_twi_step())
+	{
+		steps++;
+	}
+	check((TWI_TRANSACTION_DONE == g_first.status) && (TWI_TRANSACTION_IN_PROGRESS == g_second.status) &&
+	      (0 == strcmp(host_twi_trace_get(), "S 48W+ 01+")), "the next transaction starts when the last byte is sent");
+	check(1U == host_twi_step(), "the STOP is on the bus");
+	trace = host_twi_trace_get();
+	check(0 == strcmp(trace, "S 48W+ 01+ P S"), "the STOP and the next START are a single bus action");
+	
+	(void)host_twi_run();
+	trace_check("S 48W+ 01+ P S 50W+ 01+ A5+ P S 48R+ r12- P", "the queued transactions follow each other");
+	check((TWI_TRANSACTION_DONE == g_second.status) && (TWI_TRANSACTION_DONE == g_third.status) &&
+	      (3U == g_callbacks) && twi_bus_is_idle() && (0U == host_twi_errors_get()),
+	      "the queued transactions are all done");
+	
+	/* Submitted by the callback of the first one, while its STOP is still on the bus: */
+	setup();
+	transaction_set(&g_first, SENSOR_ADDRESS, 1U, 0U, chaining_callback);
+	transaction_set(&g_second, EEPROM_ADDRESS, 1U, 0U, counting_callback);
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "the first transaction is queued");
+	for (steps = 0; steps < 3U; steps++)
+	{
+		(void)host_twi_step();
+	}
+	check(1U == host_twi_step(), "the STOP is on the bus");
+	trace_check("S 48W+ 01+ P S", "a transaction submitted by a callback starts right after the STOP");
+	(void)host_twi_run();
+	trace_check("S 48W+ 01+ P S 50W+ 01+ P", "a transaction submitted by a callback runs");
+	check((TWI_TRANSACTION_DONE == g_second.status) && (2U == g_callbacks) && (0U == host_twi_errors_get()),
+	      "a transaction submitted by a callback is done");
+}
+
+static void bus_time_test(void)
+{
+	uint64_t start_ns;
+	uint64_t elapsed_ns;
+	uint64_t scl_period_ns;
+	
+	setup();
+	scl_period_ns = 1000000000ULL * (16U + (2U * TWBR)) / HOST_DEFAULT_CPU_FREQUENCY;
+	transaction_set(&g_first, SENSOR_ADDRESS, 3U, 0U, NULL);
+	start_ns = host_time_ns();
+	check(TWI_E_OK == twi_transaction_submit(&g_first), "a write is queued");
+	while (!twi_transaction_is_finished(&g_first) && ((host_time_ns() - start_ns) < MAX_WAIT_NS))
+	{
+		host_delay_ns(WAIT_STEP_NS);
+	}
+	elapsed_ns = host_time_ns() - start_ns;
+	
+	/* A START and 4 bytes of 9 bits, each action ending on a wait step. The STOP comes after the transaction is done: */
+	trace_check("S 48W+ 01+ A5+ 5A+", "the bus runs on its own time");
+	check((elapsed_ns >= (37U * scl_period_ns)) && (elapsed_ns <= ((37U * scl_period_ns) + (5U * WAIT_STEP_NS))),
+	      "a write takes the bus time of its bits");
+	printf("  3 byte write at %lu Hz SCL: %llu us\n", (unsigned long)(1000000000ULL / scl_period_ns),
+	       (unsigned long long)(elapsed_ns / 1000U));
+	
+	host_delay_ns(scl_period_ns + WAIT_STEP_NS);
+	trace_check("S 48W+ 01+ A5+ 5A+ P", "the STOP follows");
+	check(twi_bus_is_idle() && (0U == host_twi_errors_get()), "the bus is free again");
+}
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(void)
+{
+	write_test();
+	read_test();
+	write_then_read_test();
+	address_nack_test();
+	data_nack_test();
+	chaining_test();
+	bus_time_test();
+	
+	printf("test_twi: %lu failures\n", g_failures);
+	
+	return (0 == g_failures) ? 0 : 1;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
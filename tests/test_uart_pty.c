@@ -0,0 +1,356 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  test_uart_pty.c
+*
+** Description:
+*  This file runs the UART driver of "lcd/Application Example 1" against the pseudo terminal UART double:
+*  - The whole example application, with its main() renamed, receives a burst through the UART interrupt, the queue
+*    and the LCD. The time from the stop bit of each byte to the enable pulse that writes it to the LCD is reported.
+*  - A polling reader at 38400 baud checks the baud pacing, and a too slow one checks the data overrun counting.
+*  - Bytes written with uart_data_write() come out of the terminal at the frame rate.
+*  Passing the burst size, like "test_uart_pty 64", changes the size of the pacing and overrun bursts.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
+#include "host_avr.h"
+#include "host_uart_pty.h"
+#include "uart_atmega32.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#define   CPU_FREQUENCY             (12000000UL)
+#define   TEST_BAUD_RATE            (38400UL)
+#define   DEFAULT_BURST_SIZE        (64U)
+#define   MAX_BURST_SIZE            (1024U)
+#define   FAST_READER_DELAY_US      (20U)
+#define   SLOW_READER_DELAY_US      (2000U)
+#define   RUN_TIME_LIMIT_NS         (2000000000ULL)
+#define   NANOSECONDS_PER_MICRO     (1000ULL)
+
+/* The LCD wiring of "lcd/Application Example 1/lcd_config.h": data on PORTA, RS on PB0, EN on PB2. */
+#define   LCD_RS_BIT                (0U)
+#define   LCD_EN_BIT                (2U)
+
+/* The example application shows 13 characters and its queue holds 13 bytes: */
+static const char g_application_text[] = "HELLO, WORLD!";
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+static int g_terminal = -1;
+static unsigned long g_failures;
+
+static jmp_buf g_application_stop;
+static uint8_t g_previous_portb;
+static char g_displayed_text[sizeof(g_application_text)];
+static uint8_t g_displayed_count;
+static uint64_t g_receive_times[sizeof(g_application_text)];
+static uint8_t g_received_count;
+static uint64_t g_display_times[sizeof(g_application_text)];
+
+/*********************************************************************************************************************
+                                         << Private Function Declarations >>
+*********************************************************************************************************************/
+/* The main() of the example application, renamed by the build: */
+extern int application_main(void);
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+static void check(int condition, const char* description)
+{
+	if (!condition)
+	{
+		printf("FAIL: %s\n", description);
+		g_failures++;
+	}
+}
+
+static void terminal_open(void)
+{
+	const char* terminal_name;
+	
+	host_reset(CPU_FREQUENCY);
+	terminal_name = host_uart_pty_open();
+	if (NULL == terminal_name)
+	{
+		printf("FAIL: can not create a pseudo terminal\n");
+		exit(1);
+	}
+	
+	if (-1 != g_terminal)
+	{
+		(void)close(g_terminal);
+	}
+	
+	g_terminal = open(terminal_name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	host_io_listener_set(&host_uart_pty_io_listener);
+}
+
+static void terminal_write(const uint8_t* data, uint32_t size)
+{
+	check(size == (uint32_t)write(g_terminal, data, size), "the burst is written to the terminal");
+}
+
+static void receive_observer(uint8_t data_byte, uint64_t time_ns)
+{
+	if (g_received_count < sizeof(g_receive_times))
+	{
+		g_receive_times[g_received_count++] = time_ns;
+	}
+}
+
+/* Watches the enable pin of the LCD and stops the application once the whole text is on the display: */
+static void application_listener(host_io_t io_register)
+{
+	uint8_t portb = host_io[HOST_PORTB];
+	
+	host_uart_pty_io_listener(io_register);
+	
+	if ((g_previous_portb & (1<<LCD_EN_BIT)) && !(portb & (1<<LCD_EN_BIT)) && (portb & (1<<LCD_RS_BIT)))
+	{
+		g_display_times[g_displayed_count] = host_time_ns();
+		g_displayed_text[g_displayed_count++] = (char)host_io[HOST_PORTA];
+	}
+	
+	g_previous_portb = portb;
+	
+	if (((sizeof(g_application_text) - 1U) == g_displayed_count) || (host_time_ns() > RUN_TIME_LIMIT_NS))
+	{
+		host_io_listener_set(NULL);
+		longjmp(g_application_stop, 1);
+	}
+}
+
+static void application_run(void)
+{
+	if (0 == setjmp(g_application_stop))
+	{
+		(void)application_main();
+	}
+}
+
+static void application_test(void)
+{
+	uint64_t latency_ns;
+	uint64_t minimum_latency_ns = UINT64_MAX;
+	uint64_t maximum_latency_ns = 0;
+	host_uart_pty_statistics_t statistics;
+	
+	terminal_open();
+	host_uart_pty_receive_observer_set(&receive_observer);
+	host_io_listener_set(&application_listener);
+	
+	/* The burst is waiting before the application starts, so it arrives while the LCD initializes: */
+	terminal_write((const uint8_t*)g_application_text, sizeof(g_application_text) - 1U);
+	
+	application_run();
+	host_uart_pty_statistics_get(&statistics);
+	check(0 == strcmp(g_displayed_text, g_application_text), "the application shows the received text");
+	check(0 == statistics.data_overruns, "the application loses no bytes to data overruns");
+	
+	for (uint8_t i = 0; (i < g_displayed_count) && (i < g_received_count); i++)
+	{
+		latency_ns = g_display_times[i] - g_receive_times[i];
+		minimum_latency_ns = (latency_ns < minimum_latency_ns) ? latency_ns : minimum_latency_ns;
+		maximum_latency_ns = (latency_ns > maximum_latency_ns) ? latency_ns : maximum_latency_ns;
+	}
+	
+	printf("application: \"%s\" displayed after %llu us, UART to LCD latency %llu to %llu us\n", g_displayed_text,
+	       (unsigned long long)(host_time_ns() / NANOSECONDS_PER_MICRO),
+	       (unsigned long long)(minimum_latency_ns / NANOSECONDS_PER_MICRO),
+	       (unsigned long long)(maximum_latency_ns / NANOSECONDS_PER_MICRO));
+}
+
+static void polling_receiver_init(void)
+{
+	(void)uart_baud_rate_config(TEST_BAUD_RATE, CPU_FREQUENCY);
+	(void)uart_frame_format_select(UART_8BIT_CHARACTER_SIZE, UART_1STOP_BIT);
+	(void)uart_synch_asynch_mode_select(UART_ASYNCHRONOUS_OPERATION);
+	uart_receiver_enable();
+	uart_receive_statistics_clear();
+}
+
+/* Reads the burst by polling, waiting reader_delay_us between the polls, and returns the bytes read: */
+static uint32_t polling_burst_receive(uint32_t burst_size, uint16_t reader_delay_us, uint8_t* received)
+{
+	uint32_t received_count = 0;
+	uint64_t end_time_ns;
+	uint8_t burst[MAX_BURST_SIZE];
+	
+	for (uint32_t i = 0; i < burst_size; i++)
+	{
+		burst[i] = (uint8_t)i;
+	}
+	
+	terminal_write(burst, burst_size);
+	
+	/* Long enough for the whole burst and a few idle frames: */
+	end_time_ns = host_time_ns() + ((burst_size + 4U) * host_uart_pty_frame_time_ns());
+	
+	while (host_time_ns() < end_time_ns)
+	{
+		if (UART_READY == uart_receiver_is_ready())
+		{
+			received[received_count++] = uart_data_read();
+		}
+		
+		_delay_us(reader_delay_us);
+	}
+	
+	/* What is left in the receive buffer: */
+	while (UART_READY == uart_receiver_is_ready())
+	{
+		received[received_count++] = uart_data_read();
+	}
+	
+	return received_count;
+}
+
+static void pacing_test(uint32_t burst_size)
+{
+	uint8_t received[MAX_BURST_SIZE];
+	uint32_t received_count;
+	uint8_t in_order = 1;
+	host_uart_pty_statistics_t statistics;
+	uart_receive_statistics_t driver_statistics;
+	
+	terminal_open();
+	polling_receiver_init();
+	received_count = polling_burst_receive(burst_size, FAST_READER_DELAY_US, received);
+	
+	for (uint32_t i = 0; i < received_count; i++)
+	{
+		in_order &= (received[i] == (uint8_t)i);
+	}
+	
+	host_uart_pty_statistics_get(&statistics);
+	uart_receive_statistics_get(&driver_statistics);
+	check(burst_size == received_count, "a fast reader receives the whole burst");
+	check(in_order, "a fast reader receives the burst in order");
+	check(0 == driver_statistics.data_overruns, "a fast reader sees no data overruns");
+	check(burst_size == driver_statistics.received_bytes, "the driver counts every received byte");
+	
+	printf("pacing: %lu bytes at a %llu us frame time, %lu received, %lu overruns\n", (unsigned long)burst_size,
+	       (unsigned long long)(host_uart_pty_frame_time_ns() / NANOSECONDS_PER_MICRO), (unsigned long)received_count,
+	       (unsigned long)driver_statistics.data_overruns);
+}
+
+static void overrun_test(uint32_t burst_size)
+{
+	uint8_t received[MAX_BURST_SIZE];
+	uint32_t received_count;
+	host_uart_pty_statistics_t statistics;
+	uart_receive_statistics_t driver_statistics;
+	
+	terminal_open();
+	polling_receiver_init();
+	received_count = polling_burst_receive(burst_size, SLOW_READER_DELAY_US, received);
+	
+	host_uart_pty_statistics_get(&statistics);
+	uart_receive_statistics_get(&driver_statistics);
+	check(0 != statistics.data_overruns, "a slow reader loses bytes to data overruns");
+	check(0 != driver_statistics.data_overruns, "the driver counts the data overruns");
+	check(burst_size == (received_count + statistics.data_overruns), "every byte is either received or overrun");
+	
+	printf("overrun: %lu bytes, reader polls every %u us, %lu received, %lu lost, %lu overrun flags seen\n",
+	       (unsigned long)burst_size, SLOW_READER_DELAY_US, (unsigned long)received_count,
+	       (unsigned long)statistics.data_overruns, (unsigned long)driver_statistics.data_overruns);
+}
+
+static void transmit_test(void)
+{
+	static const char message[] = "PTY ECHO\r\n";
+	char drained[sizeof(message)] = {0};
+	uint64_t start_time_ns;
+	uint64_t transmit_time_ns;
+	host_uart_pty_statistics_t statistics;
+	
+	terminal_open();
+	polling_receiver_init();
+	uart_transmitter_enable();
+	start_time_ns = host_time_ns();
+	
+	for (uint8_t i = 0; i < (sizeof(message) - 1U); i++)
+	{
+		while (UART_READY != uart_transmitter_is_ready())
+		{
+			_delay_us(1);
+		}
+		
+		uart_data_write((uint8_t)message[i]);
+	}
+	
+	do
+	{
+		_delay_us(1);
+		host_uart_pty_statistics_get(&statistics);
+	} while (statistics.transmitted_bytes < (sizeof(message) - 1U));
+	
+	transmit_time_ns = host_time_ns() - start_time_ns;
+	check((sizeof(message) - 1U) == (size_t)read(g_terminal, drained, sizeof(drained) - 1U),
+	      "the transmitted bytes come out of the terminal");
+	check(0 == strcmp(drained, message), "the transmitted bytes are unchanged");
+	check(transmit_time_ns >= ((sizeof(message) - 1U) * host_uart_pty_frame_time_ns()), "transmission is paced");
+	check(0 == statistics.dropped_writes, "no writes are dropped while UDRE is respected");
+	
+	printf("transmit: %u bytes drained in %llu us\n", (unsigned)(sizeof(message) - 1U),
+	       (unsigned long long)(transmit_time_ns / NANOSECONDS_PER_MICRO));
+}
+
+/*********************************************************************************************************************
+                                                  << Main Function >>
+*********************************************************************************************************************/
+int main(int argc, char* argv[])
+{
+	uint32_t burst_size = DEFAULT_BURST_SIZE;
+	
+	if (argc > 1)
+	{
+		burst_size = (uint32_t)strtoul(argv[1], NULL, 10);
+		burst_size = ((0 == burst_size) || (burst_size > MAX_BURST_SIZE)) ? DEFAULT_BURST_SIZE : burst_size;
+	}
+	
+	application_test();
+	pacing_test(burst_size);
+	overrun_test(burst_size);
+	transmit_test();
+	
+	host_uart_pty_close();
+	printf("test_uart_pty: %lu failures\n", g_failures);
+	
+	return (0 == g_failures) ? 0 : 1;
+}
+
+/*********************************************************************************************************************
+                                                    << End of File >>
+*********************************************************************************************************************/
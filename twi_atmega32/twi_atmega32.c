@@ -0,0 +1,443 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  twi_atmega32.c
+*
+** Description:
+*  This file contains the implementation for the device driver of TWI (I2C) peripheral of the atmega32
+*  microcontroller.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "twi_config.h"
+#include "twi_atmega32.h"
+
+/*********************************************************************************************************************
+                                              << Private Constants >>
+*********************************************************************************************************************/
+#if ((TWI_QUEUE_SIZE < 2U) || (TWI_QUEUE_SIZE > 255U))
+#error "TWI_QUEUE_SIZE" needs to be from 2 to 255 in "twi_config.h"
+#endif
+
+/********************************************** Bit Rate-relating Macros ********************************************/
+/* SCL frequency = CPU clock / (16 + 2 * TWBR * 4^TWPS) */
+#define   SCL_FIXED_CLOCK_CYCLES       (16UL)
+#define   BIT_RATE_REGISTER_MIN        (10UL)     /* The smallest TWBR value allowed in master mode. */
+#define   BIT_RATE_REGISTER_MAX        (255UL)
+#define   PRESCALER_VALUES_COUNT       (4U)       /* TWPS1:0 = 00, 01, 10, 11 divide by 1, 4, 16, 64. */
+#define   PRESCALER_SHIFT_STEP         (2U)       /* Each prescaler value is 4 times the previous one. */
+#define   PRESCALER_BITS_MASK          ((1<<TWPS1)|(1<<TWPS0))
+
+/************************************************ Status-relating Macros *********************************************/
+#define   STATUS_CODE_MASK             (0xF8U)
+#define   BUS_ERROR                    (0x00U)
+#define   START_SENT                   (0x08U)
+#define   REPEATED_START_SENT          (0x10U)
+#define   ADDRESS_WRITE_ACK            (0x18U)
+#define   ADDRESS_WRITE_NACK           (0x20U)
+#define   DATA_SENT_ACK                (0x28U)
+#define   DATA_SENT_NACK               (0x30U)
+#define   ARBITRATION_LOST             (0x38U)
+#define   ADDRESS_READ_ACK             (0x40U)
+#define   ADDRESS_READ_NACK            (0x48U)
+#define   DATA_RECEIVED_ACK            (0x50U)
+#define   DATA_RECEIVED_NACK           (0x58U)
+
+/************************************************ Control-relating Macros ********************************************/
+/* Each value clears TWINT, which starts the next bus action, and keeps the peripheral and its interrupt enabled: */
+#define   TWCR_CONTINUE                ((1<<TWINT)|(1<<TWEN)|(1<<TWIE))
+#define   TWCR_CONTINUE_WITH_ACK       (TWCR_CONTINUE|(1<<TWEA))
+#define   TWCR_SEND_START              (TWCR_CONTINUE|(1<<TWSTA))
+#define   TWCR_SEND_STOP               (TWCR_CONTINUE|(1<<TWSTO))
+
+#define   ADDRESS_SHIFT                (1U)
+#define   WRITE_DIRECTION_BIT          (0x00U)
+#define   READ_DIRECTION_BIT           (0x01U)
+
+/*********************************************************************************************************************
+                                              << Private Data Types >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                          << Private Variable Definitions >>
+*********************************************************************************************************************/
+/* The transaction at the tail is the one in progress. The queue is empty when the head and the tail are equal: */
+static twi_transaction_t* g_transactions_queue[TWI_QUEUE_SIZE];
+static volatile uint8_t g_queue_head = 0;
+static volatile uint8_t g_queue_tail = 0;
+
+/* The next byte of the transaction in progress to be written or read: */
+static uint8_t g_byte_index = 0;
+
+/*********************************************************************************************************************
+                                          << Public Variable Definitions >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                         << Private Functions Prototypes >>
+*********************************************************************************************************************/
+static void twi_transaction_start(void);
+static void twi_transaction_finish(twi_transaction_status_t status, uint8_t twcr_action);
+
+/*********************************************************************************************************************
+                                          << Public Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  twi_master_init
+*
+** Description:
+*  This function enables the TWI peripheral as a master with the closest SCL frequency that isn't above the required
+*  one.
+*
+** Input Parameters:
+*  - scl_freq: uint32_t
+*    The SCL frequency in HZ.
+*  - sys_osc_clock_freq: uint32_t
+*    This parameter is used to pass the microcontroller's clock frequency to the function in HZ.
+*
+** Return Value:
+*  - twi_std_error_type_t
+*    Returns TWI_E_OK if the SCL frequency can be generated, and "TWI_E_NOT_OK" otherwise.
+*********************************************************************************************************************/
+twi_std_error_type_t twi_master_init(uint32_t scl_freq, uint32_t sys_osc_clock_freq)
+{
+	twi_std_error_type_t return_error = TWI_E_NOT_OK;
+	uint32_t scl_period_cycles;
+	uint32_t bit_rate_cycles;
+	uint32_t bit_rate_register_value;
+
+	if (0 == scl_freq)
+	{
+		return TWI_E_NOT_OK;
+	}
+
+	/* Rounding up, so the SCL frequency is never above the required one: */
+	scl_period_cycles = (sys_osc_clock_freq + scl_freq - 1UL) / scl_freq;
+	if (scl_period_cycles < (SCL_FIXED_CLOCK_CYCLES + (2UL * BIT_RATE_REGISTER_MIN)))
+	{
+		/* Error: SCL frequency is too high for the clock frequency. */
+		return TWI_E_NOT_OK;
+	}
+	bit_rate_cycles = (scl_period_cycles - SCL_FIXED_CLOCK_CYCLES + 1UL) / 2UL;
+
+	for (uint8_t prescaler = 0; prescaler < PRESCALER_VALUES_COUNT; prescaler++)
+	{
+		bit_rate_register_value = (bit_rate_cycles + (1UL << (prescaler * PRESCALER_SHIFT_STEP)) - 1UL) >>
+		                          (prescaler * PRESCALER_SHIFT_STEP);
+		if (BIT_RATE_REGISTER_MAX >= bit_rate_register_value)
+		{
+			TWCR = 0;
+			TWBR = (uint8_t)bit_rate_register_value;
+			TWSR = (TWSR & (~PRESCALER_BITS_MASK)) | prescaler;
+			g_queue_head = 0;
+			g_queue_tail = 0;
+			TWCR = (1<<TWEN);
+			return_error = TWI_E_OK;
+			break;
+		}
+	}
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  twi_transaction_submit
+*
+** Description:
+*  This function adds a transaction to the queue, and starts it if the bus is idle.
+*
+** Input Parameters:
+*  - transaction: twi_transaction_t*
+*    Pointer to the transaction.
+*
+** Return Value:
+*  - twi_std_error_type_t
+*    Returns TWI_E_OK if the transaction is queued, and "TWI_E_NOT_OK" if the queue is full or the transaction is
+*    empty.
+*********************************************************************************************************************/
+twi_std_error_type_t twi_transaction_submit(twi_transaction_t* transaction)
+{
+	twi_std_error_type_t return_error = TWI_E_NOT_OK;
+	uint8_t next_head;
+	uint8_t sreg_value;
+
+	if ((NULL == transaction) ||
+	    ((0 == transaction->write_length) && (0 == transaction->read_length)) ||
+	    ((0 != transaction->write_length) && (NULL == transaction->write_buffer)) ||
+	    ((0 != transaction->read_length) && (NULL == transaction->read_buffer)))
+	{
+		return TWI_E_NOT_OK;
+	}
+
+	/* The interrupt changes the tail and starts the next transaction, so the queue is changed with the interrupts
+	   disabled: */
+	sreg_value = SREG;
+	cli();
+
+	next_head = g_queue_head + 1;
+	if (TWI_QUEUE_SIZE == next_head)
+	{
+		next_head = 0;
+	}
+
+	if (next_head != g_queue_tail)
+	{
+		transaction->status = TWI_TRANSACTION_QUEUED;
+		g_transactions_queue[g_queue_head] = transaction;
+		if (g_queue_head == g_queue_tail)
+		{
+			/* The bus is idle: */
+			g_queue_head = next_head;
+			twi_transaction_start();
+		}
+		else
+		{
+			g_queue_head = next_head;
+		}
+		return_error = TWI_E_OK;
+	}
+
+	SREG = sreg_value;
+
+	return return_error;
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  twi_transaction_is_finished
+*
+** Description:
+*  This function checks whether a submitted transaction finished, successfully or not.
+*
+** Input Parameters:
+*  - transaction: const twi_transaction_t*
+*    Pointer to the transaction.
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 if the transaction finished, and 0 if it is queued or in progress.
+*********************************************************************************************************************/
+uint8_t twi_transaction_is_finished(const twi_transaction_t* transaction)
+{
+	return (TWI_TRANSACTION_DONE <= transaction->status);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  twi_bus_is_idle
+*
+** Description:
+*  This function checks whether all the submitted transactions finished.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 if no transaction is queued or in progress, and 0 otherwise.
+*********************************************************************************************************************/
+uint8_t twi_bus_is_idle(void)
+{
+	return (g_queue_head == g_queue_tail);
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  ISR(TWI_vect)
+*
+** Description:
+*  This is the TWI master state machine. Each interrupt handles the bus event reported in TWSR and starts the next
+*  bus action of the transaction in progress. When the transaction finishes, the next queued one starts, with a
+*  STOP followed by a START in the same action.
+*
+*********************************************************************************************************************/
+ISR(TWI_vect)
+{
+	twi_transaction_t* transaction = g_transactions_queue[g_queue_tail];
+
+	switch (TWSR & STATUS_CODE_MASK)
+	{
+		case START_SENT:
+		g_byte_index = 0;
+		if (0 != transaction->write_length)
+		{
+			TWDR = (transaction->slave_address << ADDRESS_SHIFT) | WRITE_DIRECTION_BIT;
+		}
+		else
+		{
+			TWDR = (transaction->slave_address << ADDRESS_SHIFT) | READ_DIRECTION_BIT;
+		}
+		TWCR = TWCR_CONTINUE;
+		break;
+
+		/* The write part is done, reading after the repeated start: */
+		case REPEATED_START_SENT:
+		g_byte_index = 0;
+		TWDR = (transaction->slave_address << ADDRESS_SHIFT) | READ_DIRECTION_BIT;
+		TWCR = TWCR_CONTINUE;
+		break;
+
+		case DATA_SENT_NACK:
+		/* Many slaves refuse the last byte of a write, only a refused byte before it is an error: */
+		if (g_byte_index != transaction->write_length)
+		{
+			twi_transaction_finish(TWI_TRANSACTION_DATA_NACK, TWCR_SEND_STOP);
+			break;
+		}
+		/* fall through */
+		case ADDRESS_WRITE_ACK:
+		case DATA_SENT_ACK:
+		if (g_byte_index < transaction->write_length)
+		{
+			TWDR = transaction->write_buffer[g_byte_index];
+			g_byte_index++;
+			TWCR = TWCR_CONTINUE;
+		}
+		else if (0 != transaction->read_length)
+		{
+			TWCR = TWCR_SEND_START;
+		}
+		else
+		{
+			twi_transaction_finish(TWI_TRANSACTION_DONE, TWCR_SEND_STOP);
+		}
+		break;
+
+		case ADDRESS_WRITE_NACK:
+		case ADDRESS_READ_NACK:
+		twi_transaction_finish(TWI_TRANSACTION_ADDRESS_NACK, TWCR_SEND_STOP);
+		break;
+
+		/* The bus belongs to the other master, so it is released without a STOP: */
+		case ARBITRATION_LOST:
+		twi_transaction_finish(TWI_TRANSACTION_ARBITRATION_LOST, TWCR_CONTINUE);
+		break;
+
+		case DATA_RECEIVED_ACK:
+		transaction->read_buffer[g_byte_index] = TWDR;
+		g_byte_index++;
+		/* fall through */
+		case ADDRESS_READ_ACK:
+		/* The last byte is answered with a NACK, which tells the slave to stop sending: */
+		if ((g_byte_index + 1) < transaction->read_length)
+		{
+			TWCR = TWCR_CONTINUE_WITH_ACK;
+		}
+		else
+		{
+			TWCR = TWCR_CONTINUE;
+		}
+		break;
+
+		case DATA_RECEIVED_NACK:
+		transaction->read_buffer[g_byte_index] = TWDR;
+		twi_transaction_finish(TWI_TRANSACTION_DONE, TWCR_SEND_STOP);
+		break;
+
+		/* A bus error is recovered from by sending a STOP: */
+		case BUS_ERROR:
+		default:
+		twi_transaction_finish(TWI_TRANSACTION_BUS_ERROR, TWCR_SEND_STOP);
+		break;
+	}
+}
+
+/*********************************************************************************************************************
+                                          << Private Function Definitions >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  twi_transaction_start
+*
+** Description:
+*  This function starts the transaction at the tail of the queue when no transaction is in progress. It is called
+*  with the interrupts disabled.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+static void twi_transaction_start(void)
+{
+	g_transactions_queue[g_queue_tail]->status = TWI_TRANSACTION_IN_PROGRESS;
+	/* The STOP of the last transaction may still be on its way, as when a completion callback submits the next
+	   transaction. Keeping TWSTO set with TWSTA sends the START right after it, instead of waiting for it here: */
+	TWCR = TWCR_SEND_START | (TWCR & (1<<TWSTO));
+}
+
+/*********************************************************************************************************************
+** Function Name:
+*  twi_transaction_finish
+*
+** Description:
+*  This function ends the transaction in progress, starts the next queued one, then calls the completion callback.
+*
+** Input Parameters:
+*  - status: twi_transaction_status_t
+*    The final status of the transaction.
+*  - twcr_action: uint8_t
+*    'TWCR_SEND_STOP' to end with a STOP, or 'TWCR_CONTINUE' to release the bus without a STOP.
+*
+** Return Value:
+*  - void
+*********************************************************************************************************************/
+static void twi_transaction_finish(twi_transaction_status_t status, uint8_t twcr_action)
+{
+	twi_transaction_t* transaction = g_transactions_queue[g_queue_tail];
+	uint8_t queue_tail = g_queue_tail + 1;
+
+	if (TWI_QUEUE_SIZE == queue_tail)
+	{
+		queue_tail = 0;
+	}
+	g_queue_tail = queue_tail;
+
+	if (g_queue_head != queue_tail)
+	{
+		/* The START is sent after the STOP, or as soon as the bus is free: */
+		g_transactions_queue[queue_tail]->status = TWI_TRANSACTION_IN_PROGRESS;
+		TWCR = twcr_action | (1<<TWSTA);
+	}
+	else
+	{
+		TWCR = twcr_action;
+	}
+
+	transaction->status = status;
+	if (NULL != transaction->complete_callback)
+	{
+		transaction->complete_callback(transaction);
+	}
+}
+
+
+/*********************************************************************************************************************
+                                                << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,204 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  twi_atmega32.h
+*
+** Description:
+*  This file contains the public programming interfaces for the device driver of TWI (I2C) peripheral of the atmega32
+*  microcontroller, working as a bus master.
+*
+*  The application describes each transfer in a twi_transaction_t and submits it. The transactions are queued and
+*  sent one after the other by the TWI interrupt, so the CPU never waits for the bus. The application learns that a
+*  transaction finished from its status, or from its completion callback.
+*
+*  Note: Global interrupts need to be enabled. SCL (PC0) and SDA (PC1) need pull-up resistors.
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Header Guard >>
+*********************************************************************************************************************/
+#ifndef TWI_ATMEGA32_H_
+#define TWI_ATMEGA32_H_
+
+/*********************************************************************************************************************
+                                               << File Inclusions >>
+*********************************************************************************************************************/
+#include <stdint.h>
+
+/*********************************************************************************************************************
+                                               << Public Constants >>
+*********************************************************************************************************************/
+
+
+/*********************************************************************************************************************
+                                               << Public Data Types >>
+*********************************************************************************************************************/
+typedef enum
+{
+	TWI_E_OK = 0,
+	TWI_E_NOT_OK = 1
+	} twi_std_error_type_t;
+
+typedef enum
+{
+	TWI_TRANSACTION_QUEUED = 0,
+	TWI_TRANSACTION_IN_PROGRESS,
+	TWI_TRANSACTION_DONE,
+	TWI_TRANSACTION_ADDRESS_NACK,        /* No slave answered the address. */
+	TWI_TRANSACTION_DATA_NACK,           /* The slave refused a written byte before the last one. */
+	TWI_TRANSACTION_ARBITRATION_LOST,    /* Another master took the bus. The transaction can be submitted again. */
+	TWI_TRANSACTION_BUS_ERROR
+	} twi_transaction_status_t;
+
+/*********************************************************************************************************************
+** Datatype Name:
+*  twi_transaction_t
+*
+** Description:
+*  This is a structure datatype that describes one transaction on the bus. The transaction and its buffers are used by
+*  the interrupt until it finishes, so they must not be local variables of a function that returns before that.
+*
+** Datatype Elements:
+*  [1] slave_address: uint8_t
+*      The 7 bit address of the slave, not shifted.
+*  [2] write_buffer: const uint8_t*
+*      The bytes written to the slave.
+*  [3] write_length: uint8_t
+*      The number of bytes written. 0 for a read only transaction.
+*  [4] read_buffer: uint8_t*
+*      The buffer that receives the bytes read from the slave.
+*  [5] read_length: uint8_t
+*      The number of bytes read. 0 for a write only transaction. If both lengths aren't 0, the bytes are written, then
+*      read after a repeated start, which is how most sensors and EEPROMs select the register to be read.
+*  [6] complete_callback: void (*)(struct twi_transaction*)
+*      The function called from the interrupt when the transaction finishes, or NULL. It may submit new transactions.
+*  [7] status: twi_transaction_status_t
+*      Set by the driver. Anything from TWI_TRANSACTION_DONE on means the transaction finished.
+*********************************************************************************************************************/
+typedef struct twi_transaction
+{
+	uint8_t slave_address;
+	const uint8_t* write_buffer;
+	uint8_t write_length;
+	uint8_t* read_buffer;
+	uint8_t read_length;
+	void (*complete_callback)(struct twi_transaction* transaction);
+	volatile twi_transaction_status_t status;
+} twi_transaction_t;
+
+/*********************************************************************************************************************
+                                           << Public Function Declarations >>
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+** Function Name:
+*  twi_master_init
+*
+** Description:
+*  This function enables the TWI peripheral as a master with the closest SCL frequency that isn't above the required
+*  one. The prescaler is chosen as small as possible, so the bit rate has the finest resolution.
+*
+** Input Parameters:
+*  - scl_freq: uint32_t
+*    The SCL frequency in HZ, usually 100000 or 400000.
+*  - sys_osc_clock_freq: uint32_t
+*    This parameter is used to pass the microcontroller's clock frequency to the function in HZ.
+*
+** Return Value:
+*  - twi_std_error_type_t
+*    Returns TWI_E_OK if the SCL frequency can be generated, and "TWI_E_NOT_OK" if it is too high or too low for the
+*    clock frequency.
+*
+** Example:
+*  twi_master_init(100000UL, F_CPU);
+*  sei();
+*********************************************************************************************************************/
+extern twi_std_error_type_t twi_master_init(uint32_t scl_freq, uint32_t sys_osc_clock_freq);
+
+/*********************************************************************************************************************
+** Function Name:
+*  twi_transaction_submit
+*
+** Description:
+*  This function adds a transaction to the queue and returns at once. The transaction starts when the ones before it
+*  finish. It can be called from the main code and from the completion callbacks.
+*
+** Input Parameters:
+*  - transaction: twi_transaction_t*
+*    Pointer to the transaction. It must not be submitted again before it finishes.
+*
+** Return Value:
+*  - twi_std_error_type_t
+*    Returns TWI_E_OK if the transaction is queued, and "TWI_E_NOT_OK" if the queue is full or the transaction is
+*    empty.
+*
+** Example:
+*  Reading the temperature register (0x00) of an LM75 sensor at address 0x48:
+*  static const uint8_t g_temperature_register = 0x00;
+*  static uint8_t g_temperature[2];
+*  static twi_transaction_t g_temperature_read =
+*  {0x48, &g_temperature_register, 1, g_temperature, 2, NULL, TWI_TRANSACTION_DONE};
+*
+*  twi_transaction_submit(&g_temperature_read);
+*  ...
+*  if (TWI_TRANSACTION_DONE == g_temperature_read.status)
+*  {
+*  	...
+*  }
+*********************************************************************************************************************/
+extern twi_std_error_type_t twi_transaction_submit(twi_transaction_t* transaction);
+
+/*********************************************************************************************************************
+** Function Name:
+*  twi_transaction_is_finished
+*
+** Description:
+*  This function checks whether a submitted transaction finished, successfully or not.
+*
+** Input Parameters:
+*  - transaction: const twi_transaction_t*
+*    Pointer to the transaction.
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 if the transaction finished, and 0 if it is queued or in progress.
+*********************************************************************************************************************/
+extern uint8_t twi_transaction_is_finished(const twi_transaction_t* transaction);
+
+/*********************************************************************************************************************
+** Function Name:
+*  twi_bus_is_idle
+*
+** Description:
+*  This function checks whether all the submitted transactions finished, for example before entering a sleep mode.
+*
+** Input Parameters:
+*  - void
+*
+** Return Value:
+*  - uint8_t
+*    Returns 1 if no transaction is queued or in progress, and 0 otherwise.
+*********************************************************************************************************************/
+extern uint8_t twi_bus_is_idle(void);
+
+
+#endif /* TWI_ATMEGA32_H_ */
+
+
+/*********************************************************************************************************************
+                                               << End of File >>
+*********************************************************************************************************************/
@@ -0,0 +1,41 @@
+/*********************************************************************************************************************
+* Author : Alsayed Alsisi
+* Date   : Monday, October 19, 2026
+* Version: 1.0
+* Contact: alsayed.alsisi@gmail.com
+* License:
+* You have the right to use the file as you wish in any educational or commercial purposes under the following
+* conditions:
+* [1] This file is to be used as is. No modifications are to be made to any part of the file, including this section.
+* [2] This section is not to be removed under any circumstances.
+* [3] Parts of the file may be used separately under the condition they are not modified, and preceded by this section.
+* [4] Any bug encountered in this file or parts of it should be reported to the email address given above to be fixed.
+* [5] No warranty is expressed or implied by the publication or distribution of this source code.
+*********************************************************************************************************************/
+/*********************************************************************************************************************
+* File Information:
+** File Name:
+*  twi_config.h
+*
+** Description:
+*  This file contains the set of configurations for the device driver of TWI (I2C) peripheral of the atmega32
+*  microcontroller.
+*********************************************************************************************************************/
+
+
+#ifndef TWI_CONFIG_H_
+#define TWI_CONFIG_H_
+
+
+/* Setting the number of transactions that can wait in the queue (2 to 255), including the one in progress.
+** Note: The queue only holds pointers to the transactions, so each queued transaction costs 2 bytes of RAM.
+*/
+#define TWI_QUEUE_SIZE  (8U)
+
+
+#endif /* TWI_CONFIG_H_ */
+
+
+/*********************************************************************************************************************
+                                               << End of File >>
+*********************************************************************************************************************/